@@ -218,6 +218,7 @@ timeout_cb (GdvIndicator *indicator)
 //      90.0 + 0.5 * ((gdouble) time_fc),
 //      90.0 + 0.5 * ((gdouble) time_fc),
       0.0);
+    gdv_layer_begin_update (GDV_LAYER (global_layer));
     gdv_layer_content_get_min_max_x (global_content, &tmp_min, &tmp_max);
     tmp_min = tmp_min < 0 ? tmp_min : 0;
     tmp_max = tmp_max > 100 ? tmp_max : 100;
@@ -226,8 +227,7 @@ timeout_cb (GdvIndicator *indicator)
     tmp_min = tmp_min < 0 ? tmp_min : 0;
     tmp_max = tmp_max > 100 ? tmp_max : 100;
     gdv_twod_layer_set_yrange (GDV_TWOD_LAYER (global_layer), tmp_min, tmp_max);
-
-    gtk_widget_queue_allocate (GTK_WIDGET (global_layer));
+    gdv_layer_end_update (GDV_LAYER (global_layer));
 
   }
 //  g_print ("HELLO AGAIN\n");
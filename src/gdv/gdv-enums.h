@@ -73,4 +73,80 @@ typedef enum
   GDV_LOWER_DIST,
 } GdvDistributionType;
 
+/**
+ * GdvIngestOverflow:
+ * @GDV_INGEST_BLOCK: The producer waits until the content took over enough
+ *                    samples to queue the new ones
+ * @GDV_INGEST_DROP_OLDEST: The oldest queued samples are dropped in favour of
+ *                          the new ones
+ * @GDV_INGEST_DECIMATE: Only every n-th sample of a new block is queued, so
+ *                       that the block fits into the free space
+ *
+ * Decides what happens to new samples, if the queue of a #GdvIngest is full.
+ */
+typedef enum
+{
+  GDV_INGEST_BLOCK,
+  GDV_INGEST_DROP_OLDEST,
+  GDV_INGEST_DECIMATE
+} GdvIngestOverflow;
+
+/**
+ * GdvPointType:
+ * @GDV_POINT_TYPE_CIRCLE: A filled circle
+ * @GDV_POINT_TYPE_SQUARE: A filled square
+ * @GDV_POINT_TYPE_DIAMOND: A filled square, that stands on one corner
+ * @GDV_POINT_TYPE_TRIANGLE_UP: A filled triangle, that points upwards
+ * @GDV_POINT_TYPE_TRIANGLE_DOWN: A filled triangle, that points downwards
+ * @GDV_POINT_TYPE_CROSS: A diagonal cross of two strokes
+ * @GDV_POINT_TYPE_PLUS: An upright cross of two strokes
+ * @GDV_POINT_TYPE_STAR: A filled five-pointed star
+ *
+ * The symbol, that marks a data-point. Unknown values are drawn as
+ * @GDV_POINT_TYPE_CIRCLE.
+ */
+typedef enum
+{
+  GDV_POINT_TYPE_CIRCLE,
+  GDV_POINT_TYPE_SQUARE,
+  GDV_POINT_TYPE_DIAMOND,
+  GDV_POINT_TYPE_TRIANGLE_UP,
+  GDV_POINT_TYPE_TRIANGLE_DOWN,
+  GDV_POINT_TYPE_CROSS,
+  GDV_POINT_TYPE_PLUS,
+  GDV_POINT_TYPE_STAR
+} GdvPointType;
+
+/**
+ * GdvRenderMode:
+ * @GDV_RENDER_MODE_LINES: Every data-point is drawn with its point-symbol and
+ *                         the data-points are connected by a line
+ * @GDV_RENDER_MODE_DENSITY: The data-points are counted per block of pixels
+ *                           and the counts are drawn as a two-dimensional
+ *                           histogram
+ *
+ * Decides how a #GdvLayerContent draws its data-points.
+ */
+typedef enum
+{
+  GDV_RENDER_MODE_LINES,
+  GDV_RENDER_MODE_DENSITY
+} GdvRenderMode;
+
+/**
+ * GdvDensityScale:
+ * @GDV_DENSITY_SCALE_LINEAR: The opacity of a block grows linearly with the
+ *                            number of its data-points
+ * @GDV_DENSITY_SCALE_LOG: The opacity of a block grows with the logarithm of
+ *                         the number of its data-points, so single data-points
+ *                         stay visible next to dense clusters
+ *
+ * Maps the counts of a #GdvLayerContent in density-mode onto colors.
+ */
+typedef enum
+{
+  GDV_DENSITY_SCALE_LINEAR,
+  GDV_DENSITY_SCALE_LOG
+} GdvDensityScale;
+
 #endif /* __GDV_ENUMS_H__ */
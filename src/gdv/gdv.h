@@ -31,11 +31,13 @@
 #include "gdvonedlayer.h"
 #include "gdvtwodlayer.h"
 #include "gdvlayercontent.h"
+#include "gdvingest.h"
 #include "gdvlinearaxis.h"
 #include "gdvlogaxis.h"
 #include "gdvaxis.h"
 #include "gdvtic.h"
 #include "gdvmtic.h"
+#include "gdvticsolver.h"
 #include "gdvlegend.h"
 #include "gdvlegendelement.h"
 #include "gdvindicator.h"
@@ -21,12 +21,185 @@
 
 #pragma once
 
+#include <math.h>
 #include <gtk/gtk.h>
 
 #include "gdvaxis.h"
 
 G_BEGIN_DECLS
 
-G_GNUC_INTERNAL gboolean _gdv_axis_get_resize_during_redraw(GdvAxis *axis);
+/*
+ * GdvAxisTransformType:
+ * @GDV_AXIS_TRANSFORM_NONE: the mapping is only known to the get_point vfunc
+ * @GDV_AXIS_TRANSFORM_LINEAR: linear mapping of the scale
+ * @GDV_AXIS_TRANSFORM_LOG: logarithmic mapping of the scale
+ */
+typedef enum
+{
+  GDV_AXIS_TRANSFORM_NONE,
+  GDV_AXIS_TRANSFORM_LINEAR,
+  GDV_AXIS_TRANSFORM_LOG
+} GdvAxisTransformType;
+
+typedef struct _GdvAxisTransform GdvAxisTransform;
+
+/*
+ * GdvAxisTransform:
+ *
+ * A snapshot of everything that is needed to map a value onto an axis. It is
+ * rebuilt by the axis, whenever it is allocated or one of its properties
+ * changes, and must be treated as read-only by everyone else.
+ *
+ * A value is mapped to base + (f(value) - value_offset) * slope, where f is
+ * the identity for linear and the natural logarithm for logarithmic axes.
+ * The resulting position is relative to the allocation of the axis, which is
+ * located at origin within the parent.
+ */
+struct _GdvAxisTransform
+{
+  GdvAxisTransformType type;
+
+  /* scale values; for logarithmic axes these are already made positive */
+  gdouble scale_beg;
+  gdouble scale_end;
+  gdouble range_min;
+  gdouble range_max;
+
+  gdouble pix_beg_x;
+  gdouble pix_beg_y;
+  gdouble pix_end_x;
+  gdouble pix_end_y;
+
+  gdouble origin_x;
+  gdouble origin_y;
+
+  gdouble value_offset;
+  gdouble base_x;
+  gdouble base_y;
+  gdouble slope_x;
+  gdouble slope_y;
+};
+
+/* maps value with a linear or logarithmic transform; returns TRUE if the
+ * value is within the range of the scale */
+static inline gboolean
+_gdv_axis_transform_map (const GdvAxisTransform *transform,
+                         gdouble                 value,
+                         gdouble                *pos_x,
+                         gdouble                *pos_y)
+{
+  gdouble scaled;
+
+  if (transform->type == GDV_AXIS_TRANSFORM_LOG)
+    {
+      if (value <= 0.0)
+        return FALSE;
+
+      scaled = log (value);
+    }
+  else
+    scaled = value;
+
+  if (pos_x)
+    *pos_x = transform->base_x +
+      (scaled - transform->value_offset) * transform->slope_x;
+  if (pos_y)
+    *pos_y = transform->base_y +
+      (scaled - transform->value_offset) * transform->slope_y;
+
+  return value <= transform->range_max && value >= transform->range_min;
+}
+
+typedef struct _GdvAxisTic GdvAxisTic;
+
+/*
+ * GdvAxisTic:
+ *
+ * A tic, that is set automatically by the axis. Instead of being a #GdvTic
+ * child-widget, it is just a record in an array, that is owned by the axis and
+ * sorted by value. All records are drawn by the axis itself with the style of
+ * the tic- and mtic-nodes below the axis.
+ */
+struct _GdvAxisTic
+{
+  gdouble      value;
+  gboolean     minor;
+
+  /* position and inner direction; relative to the allocation of the axis */
+  gdouble      pos_x;
+  gdouble      pos_y;
+  gdouble      inner_dir_x;
+  gdouble      inner_dir_y;
+
+  /* the label; NULL for minor tics or if labels are hidden */
+  PangoLayout *layout;
+  gint         label_width;
+  gint         label_height;
+};
+
+G_GNUC_INTERNAL gboolean _gdv_axis_flush_allocate (GdvAxis *axis);
+
+G_GNUC_INTERNAL void _gdv_axis_begin_tics (GdvAxis *axis);
+
+G_GNUC_INTERNAL void _gdv_axis_append_tic (GdvAxis  *axis,
+                                           gdouble   value,
+                                           gboolean  minor);
+
+G_GNUC_INTERNAL void _gdv_axis_end_tics (GdvAxis *axis);
+
+G_GNUC_INTERNAL const GdvAxisTic *_gdv_axis_get_tics (GdvAxis *axis,
+                                                      guint   *n_tics);
+
+G_GNUC_INTERNAL gdouble _gdv_axis_get_tic_tolerance (GdvAxis *axis);
+
+G_GNUC_INTERNAL void _gdv_axis_measure_tic (GdvAxis   *axis,
+                                            gdouble    value,
+                                            gboolean   minor,
+                                            gdouble    inner_dir_x,
+                                            gdouble    inner_dir_y,
+                                            GtkBorder *border);
+
+G_GNUC_INTERNAL void _gdv_axis_get_tics_border (GdvAxis   *axis,
+                                                gint       for_size,
+                                                GtkBorder *border);
+
+G_GNUC_INTERNAL void _gdv_axis_get_spaces (GdvAxis *axis,
+                                           gint     beg_space[4],
+                                           gint     beg_space_nat[4],
+                                           gint     end_space[4],
+                                           gint     end_space_nat[4]);
+
+G_GNUC_INTERNAL void _gdv_axis_set_transform_type (GdvAxis              *axis,
+                                                   GdvAxisTransformType  type);
+
+G_GNUC_INTERNAL const GdvAxisTransform *_gdv_axis_get_transform (GdvAxis *axis);
+
+G_GNUC_INTERNAL guint _gdv_axis_get_transform_serial (GdvAxis *axis);
+
+G_GNUC_INTERNAL guint _gdv_axis_get_geometry_serial (GdvAxis *axis,
+                                                     gdouble *translation_x,
+                                                     gdouble *translation_y);
+
+G_GNUC_INTERNAL gboolean _gdv_axis_has_direct_transform (GdvAxis *axis);
+
+G_GNUC_INTERNAL gboolean _gdv_axis_transform_get_point (GdvAxis *axis,
+                                                        gdouble  value,
+                                                        gdouble *pos_x,
+                                                        gdouble *pos_y);
+
+G_GNUC_INTERNAL gboolean _gdv_axis_map_value (GdvAxis *axis,
+                                              gdouble  value,
+                                              gdouble *pos_x,
+                                              gdouble *pos_y);
+
+G_GNUC_INTERNAL void _gdv_axis_map_values (GdvAxis       *axis,
+                                           const gdouble *values,
+                                           gsize          n_values,
+                                           gsize          stride,
+                                           gdouble        offset_x,
+                                           gdouble        offset_y,
+                                           gdouble       *pos_x,
+                                           gdouble       *pos_y,
+                                           guint8        *in_range);
 
 G_END_DECLS
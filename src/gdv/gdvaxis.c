@@ -25,6 +25,7 @@
 #endif
 
 #include <math.h>
+#include <string.h>
 
 /**
  * SECTION:gdvaxis
@@ -37,6 +38,11 @@
  * implemented geometry handling can be used for any axis, that is a basically
  * a straight line.
  *
+ * The tics, that are set automatically by the axis, are no widgets. They are
+ * kept as plain records by the axis and drawn with the style of the tic- and
+ * mtic-nodes (see gdv_axis_get_n_tics() and gdv_axis_get_nth_tic()). Custom
+ * #GdvTic widgets can still be added with gtk_container_add().
+ *
  * # CSS nodes
  *
  * GdvAxis uses a single CSS node with name axis.
@@ -45,13 +51,23 @@
 /* Welcome to the all-in-one design hell */
 
 #include "gdvaxis.h"
+#include "gdvtheme-private.h"
 #include "gdvaxis-private.h"
+#include "gdvlayer-private.h"
+#include "gdvtwodlayer.h"
 #include "gdvtic.h"
 #include "gdvmtic.h"
 #include "gdvindicator.h"
 #include "gdv-data-boxed.h"
 #include "gdvrender.h"
 
+/* tolerance for the values of automatic tics, relative to the increment */
+#define GDV_AXIS_TIC_EPSILON 1e-9
+#define GDV_AXIS_TIC_ULPS 4
+/* the deviation in pixels up to which a new mapping only counts as a
+ * translation of the previous one */
+#define GDV_AXIS_TRANSLATION_TOLERANCE 1e-3
+
 /* Define Signals */
 enum
 {
@@ -107,6 +123,38 @@ enum
 /* --- variables --- */
 static guint axis_signals[LAST_SIGNAL] = { 0 };
 
+/* The space, that the axis needs around its begin and end, as the layer asks
+ * for it. It only depends on the tics, the labels, the title and the
+ * orientation, so it is kept until one of those changes. */
+typedef struct
+{
+  gboolean   valid;
+
+  /* the title is measured by gtk itself; only its size is part of the key */
+  GtkWidget *title;
+  gboolean   title_visible;
+  gint       title_width;
+  gint       title_width_nat;
+  gint       title_height;
+  gint       title_height_nat;
+
+  /* indices are GTK_POS_TOP, GTK_POS_BOTTOM, GTK_POS_LEFT, GTK_POS_RIGHT */
+  gint       beg_space[4];
+  gint       beg_space_nat[4];
+  gint       end_space[4];
+  gint       end_space_nat[4];
+} GdvAxisSpaces;
+
+typedef struct
+{
+  gdouble  line_width;
+  GdkRGBA  color;
+  gdouble  in_length;
+  gdouble  out_length;
+  gdouble  label_distance;
+  gboolean show_label;
+} GdvAxisTicStyle;
+
 struct _GdvAxisPrivate
 {
   /* list with indicators */
@@ -119,6 +167,31 @@ struct _GdvAxisPrivate
   GList      *tics;
   GList      *mtics;
 
+  /* automatic tics, sorted by value; the previous set is kept in the second
+   * array while the tics are rebuilt */
+  GArray     *tic_records;
+  GArray     *previous_tic_records;
+  GHashTable *tic_layouts;
+  GHashTable *previous_tic_layouts;
+
+  /* style of the automatic tics; read once for all of them */
+  GtkStyleContext  *tic_context;
+  GtkStyleContext  *mtic_context;
+  GtkStyleContext  *label_context;
+  GdvAxisTicStyle   tic_style;
+  GdvAxisTicStyle   mtic_style;
+  PangoFontDescription *label_font;
+  gboolean          tic_style_valid;
+
+  /* the space the automatic tics needed after their last rebuild */
+  GtkBorder         tics_records_border;
+  gboolean          tics_records_border_valid;
+
+  GdvAxisSpaces     spaces;
+
+  /* values of automatic tics, that are closer than this, are the same */
+  gdouble           tic_tolerance;
+
   GdkWindow *event_window;
 
   /* geoemtric properties of the axis */
@@ -158,12 +231,25 @@ struct _GdvAxisPrivate
 
   gboolean          force_beg_end;
 
-  gboolean          resize_during_redraw;
+  /* an allocation, that is held back by a transaction of the layer */
+  gboolean          allocate_deferred;
 
   gboolean          tic_labels;
   const gchar      *label_format;
 
   GtkWidget        *title;
+
+  /* cached mapping of values onto the axis */
+  GdvAxisTransformType transform_type;
+  GdvAxisTransform  transform;
+  gboolean          transform_valid;
+  guint             transform_serial;
+
+  /* changes, that are more than a translation, increase the geometry-serial;
+   * translations are summed up instead */
+  guint             geometry_serial;
+  gdouble           translation_x;
+  gdouble           translation_y;
 };
 
 static GParamSpec *axis_properties[N_PROPERTIES] = { NULL, };
@@ -189,6 +275,8 @@ gdv_axis_make_tic_label_markup_unimplemented (
 static void
 gdv_axis_size_allocate (GtkWidget     *widget,
                         GtkAllocation *allocation);
+static void
+gdv_axis_style_updated (GtkWidget *widget);
 static gboolean
 gdv_axis_draw (GtkWidget    *widget,
                cairo_t      *cr);
@@ -238,27 +326,26 @@ gdv_axis_get_space_to_end_position_unimplemented (
 
 G_DEFINE_TYPE_WITH_PRIVATE (GdvAxis, gdv_axis, GTK_TYPE_CONTAINER)
 
+static void
+_gdv_axis_tic_clear (gpointer data)
+{
+  GdvAxisTic *tic = data;
+
+  g_clear_object (&tic->layout);
+}
+
 static void
 gdv_axis_init (GdvAxis *axis)
 {
   GtkStyleContext *style_context;
-  GtkCssProvider *css_provider;
 
   GtkWidget *widget;
 
   widget = GTK_WIDGET (axis);
 
   /* initializing style-properties */
-  css_provider = gtk_css_provider_new ();
   style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
-
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+  _gdv_theme_add_to_context (style_context);
 
   gtk_widget_set_can_focus (GTK_WIDGET (axis), TRUE);
   gtk_widget_set_receives_default (GTK_WIDGET (axis), TRUE);
@@ -290,9 +377,7 @@ gdv_axis_init (GdvAxis *axis)
   axis->priv->no_of_mtics = 4;
 
   axis->priv->force_beg_end = FALSE;
-
-  /* This is a necessary evil, as the resize_queue during alloc is suppressed */
-  axis->priv->resize_during_redraw = FALSE;
+  axis->priv->allocate_deferred = FALSE;
 
   axis->priv->indicators = NULL;
   axis->priv->update_indicator_table =
@@ -301,10 +386,72 @@ gdv_axis_init (GdvAxis *axis)
   axis->priv->tics = NULL;
   axis->priv->mtics = NULL;
   axis->priv->tic_labels = TRUE;
+
+  axis->priv->tic_records = g_array_new (FALSE, FALSE, sizeof (GdvAxisTic));
+  axis->priv->previous_tic_records =
+    g_array_new (FALSE, FALSE, sizeof (GdvAxisTic));
+  g_array_set_clear_func (axis->priv->tic_records, _gdv_axis_tic_clear);
+  g_array_set_clear_func (axis->priv->previous_tic_records,
+                          _gdv_axis_tic_clear);
+  axis->priv->tic_layouts =
+    g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+  axis->priv->previous_tic_layouts =
+    g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+
+  axis->priv->tic_context = NULL;
+  axis->priv->mtic_context = NULL;
+  axis->priv->label_context = NULL;
+  axis->priv->label_font = NULL;
+  axis->priv->tic_style_valid = FALSE;
   axis->priv->label_format = NULL;
 
   axis->priv->ranges = NULL;
 
+  axis->priv->transform_type = GDV_AXIS_TRANSFORM_NONE;
+  axis->priv->transform_valid = FALSE;
+}
+
+/* The tics of an axis decide about the space it takes and therefore about the
+ * layout of the whole layer; so the layer is allocated again together with the
+ * axis, which lets it align all axes within the same pass. */
+static void
+_gdv_axis_queue_allocate (GdvAxis *axis)
+{
+  GtkWidget *parent = gtk_widget_get_parent (GTK_WIDGET (axis));
+
+  /* within a transaction of the layer, this is done once at its end */
+  if (parent && GDV_IS_LAYER (parent) &&
+      _gdv_layer_is_updating (GDV_LAYER (parent)))
+  {
+    axis->priv->allocate_deferred = TRUE;
+    return;
+  }
+
+  gtk_widget_queue_allocate (GTK_WIDGET (axis));
+
+  if (parent)
+    gtk_widget_queue_allocate (parent);
+}
+
+/*
+ * _gdv_axis_flush_allocate:
+ * @axis: a #GdvAxis
+ *
+ * Queues the allocation, that was held back during a transaction of the
+ * parent layer.
+ *
+ * Returns: %TRUE, if an allocation had been held back
+ */
+gboolean
+_gdv_axis_flush_allocate (GdvAxis *axis)
+{
+  if (!axis->priv->allocate_deferred)
+    return FALSE;
+
+  axis->priv->allocate_deferred = FALSE;
+  gtk_widget_queue_allocate (GTK_WIDGET (axis));
+
+  return TRUE;
 }
 
 static void
@@ -318,134 +465,139 @@ gdv_axis_set_property (GObject      *object,
 
   self = GDV_AXIS (object);
 
+  /* any property may influence the geometry of the axis */
+  self->priv->transform_valid = FALSE;
+
   switch (property_id)
   {
   case PROP_GDV_AXIS_DIRECTION_START:
     self->priv->direction_start = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    self->priv->spaces.valid = FALSE;
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_DIRECTION_OUTER_SIDE:
     self->priv->direction_outer = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    self->priv->spaces.valid = FALSE;
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_SCALE_MIN_VAL:
     self->priv->scale_min_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_SCALE_MAX_VAL:
     self->priv->scale_max_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_SCALE_INCREMENT_VAL:
     self->priv->scale_increment_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_SCALE_AUTO_INCREMENT:
     self->priv->scale_auto_increment = g_value_get_boolean (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_SCALE_AUTO_LIMITS:
     self->priv->scale_auto_limits = g_value_get_boolean (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   /* TODO: connect notify for the following props */
   case PROP_GDV_AXIS_PIX_BEG_X:
     self->priv->axis_beg_pix_x = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_PIX_BEG_Y:
     self->priv->axis_beg_pix_y = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_PIX_END_X:
     self->priv->axis_end_pix_x = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_PIX_END_Y:
     self->priv->axis_end_pix_y = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_BEG_AT_SCREEN_X:
     self->priv->beg_at_screen_x = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_BEG_AT_SCREEN_Y:
     self->priv->beg_at_screen_y = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_END_AT_SCREEN_X:
     self->priv->end_at_screen_x = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_END_AT_SCREEN_Y:
     self->priv->end_at_screen_y = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_TICS_BEG_VAL:
     self->priv->tics_beg_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_TICS_END_VAL:
     self->priv->tics_end_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_TICS_AUTOMATIC:
     self->priv->tics_automatic = g_value_get_boolean (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_MTICS_BEG_VAL:
     self->priv->mtics_beg_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_MTICS_END_VAL:
     self->priv->mtics_end_val = g_value_get_double (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_MTICS_AUTOMATIC:
     self->priv->mtics_automatic = g_value_get_boolean (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_NUMBER_MTICS:
     self->priv->no_of_mtics = g_value_get_uint (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_TITLE:
     title_dup = g_value_dup_string (value);
     gdv_axis_title_set_markup(self, title_dup);
     g_free (title_dup);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_TITLE_WIDGET:
     gdv_axis_set_title_widget (self, g_value_get_object (value));
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   case PROP_GDV_AXIS_FORCE_BEG_END:
     self->priv->force_beg_end = g_value_get_boolean (value);
-    gtk_widget_queue_allocate (GTK_WIDGET (self));
+    _gdv_axis_queue_allocate (self);
     break;
 
   default:
@@ -575,9 +727,1075 @@ gdv_axis_get_property (GObject    *object,
   }
 }
 
-G_GNUC_INTERNAL gboolean _gdv_axis_get_resize_during_redraw(GdvAxis *axis)
+/* Sets the kind of mapping, an axis-implementation provides. This has to be
+ * called during instance-initialization by all classes, that use
+ * _gdv_axis_transform_get_point() as get_point-method. */
+G_GNUC_INTERNAL void
+_gdv_axis_set_transform_type (GdvAxis              *axis,
+                              GdvAxisTransformType  type)
+{
+  axis->priv->transform_type = type;
+  axis->priv->transform_valid = FALSE;
+}
+
+static gboolean
+_gdv_axis_transform_equal (const GdvAxisTransform *a,
+                           const GdvAxisTransform *b)
+{
+  return a->type == b->type &&
+         a->range_min == b->range_min &&
+         a->range_max == b->range_max &&
+         a->origin_x == b->origin_x &&
+         a->origin_y == b->origin_y &&
+         a->value_offset == b->value_offset &&
+         a->base_x == b->base_x &&
+         a->base_y == b->base_y &&
+         a->slope_x == b->slope_x &&
+         a->slope_y == b->slope_y;
+}
+
+/* Checks, whether the mapping b only moves all values by the same distance in
+ * pixels compared to a; this is the case, if the scale was shifted, while the
+ * axis and the length of the scale stayed the same. */
+static gboolean
+_gdv_axis_transform_translation (const GdvAxisTransform *a,
+                                 const GdvAxisTransform *b,
+                                 gdouble                *dx,
+                                 gdouble                *dy)
+{
+  gdouble span;
+
+  if (a->type != b->type || a->type == GDV_AXIS_TRANSFORM_NONE ||
+      a->pix_beg_x != b->pix_beg_x || a->pix_beg_y != b->pix_beg_y ||
+      a->pix_end_x != b->pix_end_x || a->pix_end_y != b->pix_end_y ||
+      a->origin_x != b->origin_x || a->origin_y != b->origin_y)
+    return FALSE;
+
+  if (a->type == GDV_AXIS_TRANSFORM_LOG)
+    span = log (b->range_max) - log (b->range_min);
+  else
+    span = b->range_max - b->range_min;
+
+  /* the slope is recomputed from the shifted limits and may differ by
+   * round-off; this must not add up to a visible error along the axis */
+  if (!isfinite (span) ||
+      fabs (a->slope_x - b->slope_x) * span > GDV_AXIS_TRANSLATION_TOLERANCE ||
+      fabs (a->slope_y - b->slope_y) * span > GDV_AXIS_TRANSLATION_TOLERANCE)
+    return FALSE;
+
+  /* the pixel, where a value ends up, that was at the base of a before */
+  *dx = b->base_x + (a->value_offset - b->value_offset) * b->slope_x -
+        a->base_x;
+  *dy = b->base_y + (a->value_offset - b->value_offset) * b->slope_y -
+        a->base_y;
+
+  return isfinite (*dx) && isfinite (*dy);
+}
+
+static void
+_gdv_axis_update_transform (GdvAxis *axis)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  GdvAxisTransform *transform = &priv->transform;
+  GdvAxisTransform previous = priv->transform;
+  GtkAllocation allocation;
+  gdouble beg_val, end_val;
+
+  gtk_widget_get_allocation (GTK_WIDGET (axis), &allocation);
+
+  beg_val = priv->scale_min_val;
+  end_val = priv->scale_max_val;
+
+  /* TODO: automatically correct the values depending on the others */
+  if (priv->transform_type == GDV_AXIS_TRANSFORM_LOG)
+  {
+    if (!beg_val && end_val)
+      beg_val = fmax (beg_val, 1e-1);
+    else if (!end_val && beg_val)
+      end_val = fmax (end_val, 1e2);
+    else if (!beg_val && !end_val)
+    {
+      beg_val = fmax (beg_val, 1e-1);
+      end_val = fmax (end_val, 1e2);
+    }
+  }
+
+  transform->type = priv->transform_type;
+  transform->scale_beg = beg_val;
+  transform->scale_end = end_val;
+  transform->range_min = fmin (beg_val, end_val);
+  transform->range_max = fmax (beg_val, end_val);
+
+  transform->pix_beg_x = priv->axis_beg_pix_x;
+  transform->pix_beg_y = priv->axis_beg_pix_y;
+  transform->pix_end_x = priv->axis_end_pix_x;
+  transform->pix_end_y = priv->axis_end_pix_y;
+
+  transform->origin_x = (gdouble) allocation.x;
+  transform->origin_y = (gdouble) allocation.y;
+
+  if (priv->transform_type == GDV_AXIS_TRANSFORM_LOG)
+  {
+    transform->value_offset = log (beg_val);
+
+    /* degenerated axes are collapsed onto their center */
+    transform->base_x = (transform->pix_beg_x + transform->pix_end_x) / 2.0;
+    transform->base_y = (transform->pix_beg_y + transform->pix_end_y) / 2.0;
+    transform->slope_x = 0.0;
+    transform->slope_y = 0.0;
+
+    if (transform->pix_beg_x != transform->pix_end_x && beg_val != end_val)
+    {
+      transform->base_x = transform->pix_beg_x;
+      transform->slope_x = (transform->pix_beg_x - transform->pix_end_x) /
+                           (log (beg_val) - log (end_val));
+    }
+
+    if (transform->pix_beg_y != transform->pix_end_y && beg_val != end_val)
+    {
+      transform->base_y = transform->pix_beg_y;
+      transform->slope_y = (transform->pix_beg_y - transform->pix_end_y) /
+                           (log (beg_val) - log (end_val));
+    }
+  }
+  else
+  {
+    transform->value_offset = beg_val;
+
+    /* degenerated axes are collapsed onto their beginning */
+    transform->base_x = transform->pix_beg_x;
+    transform->base_y = transform->pix_beg_y;
+    transform->slope_x = 0.0;
+    transform->slope_y = 0.0;
+
+    if (transform->pix_beg_x != transform->pix_end_x && beg_val != end_val)
+      transform->slope_x = (transform->pix_beg_x - transform->pix_end_x) /
+                           (beg_val - end_val);
+
+    if (transform->pix_beg_y != transform->pix_end_y && beg_val != end_val)
+      transform->slope_y = (transform->pix_beg_y - transform->pix_end_y) /
+                           (beg_val - end_val);
+  }
+
+  if (!_gdv_axis_transform_equal (&previous, transform))
+  {
+    gdouble dx, dy;
+
+    priv->transform_serial++;
+
+    if (_gdv_axis_has_direct_transform (axis) &&
+        _gdv_axis_transform_translation (&previous, transform, &dx, &dy))
+    {
+      priv->translation_x += dx;
+      priv->translation_y += dy;
+    }
+    else
+      priv->geometry_serial++;
+  }
+
+  priv->transform_valid = TRUE;
+}
+
+/* A number that changes whenever the mapping of values onto the axis changes;
+ * used to validate anything that was rendered with an older mapping. */
+G_GNUC_INTERNAL guint
+_gdv_axis_get_transform_serial (GdvAxis *axis)
+{
+  if (!axis->priv->transform_valid)
+    _gdv_axis_update_transform (axis);
+
+  return axis->priv->transform_serial;
+}
+
+/* Like _gdv_axis_get_transform_serial(), but a change of the mapping, that
+ * just translates all positions, does not increase the serial. The summed up
+ * translation in pixels is given instead, so anything that was rendered with
+ * an older mapping can be moved by the difference. */
+G_GNUC_INTERNAL guint
+_gdv_axis_get_geometry_serial (GdvAxis *axis,
+                               gdouble *translation_x,
+                               gdouble *translation_y)
+{
+  if (!axis->priv->transform_valid)
+    _gdv_axis_update_transform (axis);
+
+  if (translation_x)
+    *translation_x = axis->priv->translation_x;
+  if (translation_y)
+    *translation_y = axis->priv->translation_y;
+
+  return axis->priv->geometry_serial;
+}
+
+/* Gives the current transform of the axis. The returned record is owned by the
+ * axis and is valid until the axis is allocated or modified again. */
+G_GNUC_INTERNAL const GdvAxisTransform *
+_gdv_axis_get_transform (GdvAxis *axis)
+{
+  if (!axis->priv->transform_valid)
+    _gdv_axis_update_transform (axis);
+
+  return &axis->priv->transform;
+}
+
+/* TRUE if values can be mapped with _gdv_axis_transform_map() instead of the
+ * get_point-method, i.e. the get_point-method was not overwritten */
+G_GNUC_INTERNAL gboolean
+_gdv_axis_has_direct_transform (GdvAxis *axis)
+{
+  return axis->priv->transform_type != GDV_AXIS_TRANSFORM_NONE &&
+         GDV_AXIS_GET_CLASS (axis)->get_point == _gdv_axis_transform_get_point;
+}
+
+/* get_point-method for all axes with a linear or logarithmic mapping */
+G_GNUC_INTERNAL gboolean
+_gdv_axis_transform_get_point (GdvAxis *axis,
+                               gdouble  value,
+                               gdouble *pos_x,
+                               gdouble *pos_y)
+{
+  if (axis->priv->transform_type == GDV_AXIS_TRANSFORM_NONE)
+  {
+    g_warning ("no transform-type set for '%s'",
+               g_type_name (G_TYPE_FROM_INSTANCE (axis)));
+    return FALSE;
+  }
+
+  return _gdv_axis_transform_map (_gdv_axis_get_transform (axis),
+                                  value, pos_x, pos_y);
+}
+
+/* Maps a value onto the axis without the overhead of a signal-emission. The
+ * position is relative to the allocation of the axis. */
+G_GNUC_INTERNAL gboolean
+_gdv_axis_map_value (GdvAxis *axis,
+                     gdouble  value,
+                     gdouble *pos_x,
+                     gdouble *pos_y)
+{
+  if (!_gdv_axis_has_direct_transform (axis))
+    return GDV_AXIS_GET_CLASS (axis)->get_point (axis, value, pos_x, pos_y);
+
+  return _gdv_axis_transform_map (_gdv_axis_get_transform (axis),
+                                  value, pos_x, pos_y);
+}
+
+/* computes base + (f(value) - value_offset) * slope for a whole array; kept
+ * free of branches, so the compiler is able to vectorize it */
+static void
+_gdv_axis_map_positions (const GdvAxisTransform *transform,
+                         const gdouble          *values,
+                         gsize                   n_values,
+                         gsize                   stride,
+                         gdouble                 base,
+                         gdouble                 slope,
+                         gdouble                *pos)
+{
+  gdouble offset = transform->value_offset;
+  gsize i;
+
+  if (transform->type == GDV_AXIS_TRANSFORM_LOG)
+    for (i = 0; i < n_values; i++)
+      pos[i] = base + (log (values[i * stride]) - offset) * slope;
+  else
+    for (i = 0; i < n_values; i++)
+      pos[i] = base + (values[i * stride] - offset) * slope;
+}
+
+/* Maps a whole array of values onto the axis. The positions are relative to
+ * the allocation of the axis, shifted by offset_x and offset_y; pos_x and
+ * pos_y may be NULL.
+ *
+ * For every value outside the range of the axis the corresponding bit of
+ * in_range (bit i & 7 of byte i >> 3) is cleared. Bits of values inside the
+ * range are left untouched, so the results of several axes can be combined.
+ */
+G_GNUC_INTERNAL void
+_gdv_axis_map_values (GdvAxis       *axis,
+                      const gdouble *values,
+                      gsize          n_values,
+                      gsize          stride,
+                      gdouble        offset_x,
+                      gdouble        offset_y,
+                      gdouble       *pos_x,
+                      gdouble       *pos_y,
+                      guint8        *in_range)
+{
+  const GdvAxisTransform *transform;
+  gdouble range_min, range_max;
+  gboolean log_scale;
+  gsize i;
+
+  if (!_gdv_axis_has_direct_transform (axis))
+  {
+    for (i = 0; i < n_values; i++)
+    {
+      gdouble tmp_x = 0.0, tmp_y = 0.0;
+      gboolean on_axis;
+
+      on_axis = GDV_AXIS_GET_CLASS (axis)->get_point (
+        axis, values[i * stride], &tmp_x, &tmp_y);
+
+      if (pos_x)
+        pos_x[i] = tmp_x + offset_x;
+      if (pos_y)
+        pos_y[i] = tmp_y + offset_y;
+      if (in_range && !on_axis)
+        in_range[i >> 3] &= ~(1 << (i & 7));
+    }
+
+    return;
+  }
+
+  transform = _gdv_axis_get_transform (axis);
+
+  if (pos_x)
+    _gdv_axis_map_positions (transform, values, n_values, stride,
+                             transform->base_x + offset_x, transform->slope_x,
+                             pos_x);
+  if (pos_y)
+    _gdv_axis_map_positions (transform, values, n_values, stride,
+                             transform->base_y + offset_y, transform->slope_y,
+                             pos_y);
+
+  if (!in_range)
+    return;
+
+  range_min = transform->range_min;
+  range_max = transform->range_max;
+  log_scale = transform->type == GDV_AXIS_TRANSFORM_LOG;
+
+  for (i = 0; i < n_values; i++)
+  {
+    gdouble value = values[i * stride];
+    guint8 outside;
+
+    outside = !(value <= range_max && value >= range_min &&
+                (!log_scale || value > 0.0));
+    in_range[i >> 3] &= ~(outside << (i & 7));
+  }
+}
+
+/* Creates the style-context of a node below the axis, that has no widget of
+ * its own. */
+static GtkStyleContext *
+_gdv_axis_create_node_context (GdvAxis         *axis,
+                               GtkStyleContext *parent,
+                               GType            type,
+                               const gchar     *name)
+{
+  GtkStyleContext *context;
+  GtkWidgetPath *path;
+
+  path = gtk_widget_path_copy (gtk_style_context_get_path (parent));
+  gtk_widget_path_append_type (path, type);
+  gtk_widget_path_iter_set_object_name (path, -1, name);
+
+  context = gtk_style_context_new ();
+  gtk_style_context_set_path (context, path);
+  gtk_style_context_set_parent (context, parent);
+  gtk_style_context_set_scale (context, gtk_style_context_get_scale (parent));
+  _gdv_theme_add_to_context (context);
+
+  gtk_widget_path_unref (path);
+
+  return context;
+}
+
+static void
+_gdv_axis_read_tic_style (GtkStyleContext *context,
+                          GdvAxisTicStyle *style)
+{
+  GdkRGBA *color = NULL;
+
+  gtk_style_context_get_style (context,
+                               "line-width", &style->line_width,
+                               "color", &color,
+                               "tics-in-length", &style->in_length,
+                               "tics-out-length", &style->out_length,
+                               "label-distance", &style->label_distance,
+                               "show-label", &style->show_label,
+                               NULL);
+
+  if (color)
+  {
+    style->color = *color;
+    gdk_rgba_free (color);
+  }
+  else
+  {
+    GdkRGBA black = {0.0, 0.0, 0.0, 1.0};
+
+    style->color = black;
+  }
+}
+
+static void
+_gdv_axis_invalidate_tic_style (GdvAxis *axis)
+{
+  GdvAxisPrivate *priv = axis->priv;
+
+  g_clear_object (&priv->tic_context);
+  g_clear_object (&priv->mtic_context);
+  g_clear_object (&priv->label_context);
+  g_clear_pointer (&priv->label_font, pango_font_description_free);
+
+  priv->tic_style_valid = FALSE;
+  priv->tics_records_border_valid = FALSE;
+  priv->spaces.valid = FALSE;
+}
+
+/* Takes one snapshot of the style of all automatic tics, instead of asking the
+ * style-context for every single tic. */
+static void
+_gdv_axis_ensure_tic_style (GdvAxis *axis)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  GtkStyleContext *context;
+
+  if (priv->tic_style_valid)
+    return;
+
+  context = gtk_widget_get_style_context (GTK_WIDGET (axis));
+
+  if (!priv->tic_context)
+  {
+    priv->tic_context =
+      _gdv_axis_create_node_context (axis, context, GDV_TYPE_TIC, "tic");
+    priv->mtic_context =
+      _gdv_axis_create_node_context (axis, context, GDV_TYPE_MTIC, "mtic");
+    priv->label_context =
+      _gdv_axis_create_node_context (
+        axis, priv->tic_context, GTK_TYPE_LABEL, "label");
+  }
+
+  _gdv_axis_read_tic_style (priv->tic_context, &priv->tic_style);
+  _gdv_axis_read_tic_style (priv->mtic_context, &priv->mtic_style);
+
+  g_clear_pointer (&priv->label_font, pango_font_description_free);
+  gtk_style_context_get (priv->label_context,
+                         gtk_style_context_get_state (priv->label_context),
+                         "font", &priv->label_font,
+                         NULL);
+
+  priv->tic_style_valid = TRUE;
+}
+
+static inline const GdvAxisTicStyle *
+_gdv_axis_tic_style (GdvAxis          *axis,
+                     const GdvAxisTic *tic)
+{
+  return tic->minor ? &axis->priv->mtic_style : &axis->priv->tic_style;
+}
+
+/* Gives the label for a tic-value. Labels are cached by their markup, so tics
+ * that did not change are not laid out again. */
+static PangoLayout *
+_gdv_axis_get_tic_layout (GdvAxis *axis,
+                          gdouble  value)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  PangoLayout *layout;
+  gpointer key;
+  gchar *markup;
+
+  markup = GDV_AXIS_GET_CLASS (axis)->make_tic_label_markup (axis, value);
+
+  if (!markup)
+    return NULL;
+
+  layout = g_hash_table_lookup (priv->tic_layouts, markup);
+
+  if (!layout &&
+      g_hash_table_lookup_extended (priv->previous_tic_layouts, markup,
+                                    &key, (gpointer *) &layout))
+  {
+    g_hash_table_steal (priv->previous_tic_layouts, markup);
+    g_hash_table_insert (priv->tic_layouts, key, layout);
+  }
+  else if (!layout)
+  {
+    layout =
+      pango_layout_new (gtk_widget_get_pango_context (GTK_WIDGET (axis)));
+    pango_layout_set_font_description (layout, priv->label_font);
+    pango_layout_set_markup (layout, markup, -1);
+
+    g_hash_table_insert (priv->tic_layouts, g_strdup (markup), layout);
+  }
+
+  g_free (markup);
+
+  return layout;
+}
+
+/* Fills in the direction and label of a tic from its value */
+static void
+_gdv_axis_tic_setup (GdvAxis    *axis,
+                     GdvAxisTic *tic)
+{
+  PangoLayout *layout = NULL;
+  gdouble inner_dir_x = 0.0, inner_dir_y = 0.0, inner_dir_length;
+
+  GDV_AXIS_GET_CLASS (axis)->get_inner_dir (
+    axis, tic->value, &inner_dir_x, &inner_dir_y);
+
+  inner_dir_length = sqrt (inner_dir_x * inner_dir_x +
+                           inner_dir_y * inner_dir_y);
+
+  tic->inner_dir_x = inner_dir_length ? inner_dir_x / inner_dir_length : 0.0;
+  tic->inner_dir_y = inner_dir_length ? inner_dir_y / inner_dir_length : 0.0;
+
+  if (_gdv_axis_tic_style (axis, tic)->show_label)
+    layout = _gdv_axis_get_tic_layout (axis, tic->value);
+
+  g_clear_object (&tic->layout);
+  tic->label_width = 0;
+  tic->label_height = 0;
+
+  if (layout)
+  {
+    tic->layout = g_object_ref (layout);
+    pango_layout_get_pixel_size (layout, &tic->label_width, &tic->label_height);
+  }
+}
+
+/* The space a tic needs around its position; this is the same geometry as
+ * in gdv_tic_get_space_to_tic_position() */
+static void
+_gdv_axis_tic_border (const GdvAxisTicStyle *style,
+                      const GdvAxisTic      *tic,
+                      GtkBorder             *border)
+{
+  gdouble dir_x = tic->inner_dir_x, dir_y = tic->inner_dir_y;
+  gdouble xalign = -0.5 * fabs (dir_y), yalign = -0.5 * fabs (dir_x);
+  gdouble width = (gdouble) tic->label_width;
+  gdouble height = (gdouble) tic->label_height;
+  gdouble in_length, out_length;
+
+  in_length = style->in_length + 0.05;
+  out_length = style->out_length + 0.05 +
+               (tic->layout ? style->label_distance : 0.0);
+
+  border->left = (gint16) (
+    fmax (-1.0 * dir_x * in_length,
+          dir_x * out_length -
+          (dir_x >= 0.0 ? (xalign - dir_x) * width : xalign * width)) +
+    fabs (dir_y) * 0.5 * style->line_width);
+  border->right = (gint16) (
+    fmax (dir_x * in_length,
+          -1.0 * dir_x * out_length -
+          (dir_x < 0.0 ? (xalign + dir_x) * width : xalign * width)) +
+    fabs (dir_y) * 0.5 * style->line_width);
+  border->top = (gint16) (
+    fmax (-1.0 * dir_y * in_length,
+          dir_y * out_length -
+          (dir_y >= 0.0 ? (yalign - dir_y) * height : yalign * height)) +
+    fabs (dir_x) * 0.5 * style->line_width);
+  border->bottom = (gint16) (
+    fmax (dir_y * in_length,
+          -1.0 * dir_y * out_length -
+          (dir_y <= 0.0 ? (yalign + dir_y) * height : yalign * height)) +
+    fabs (dir_x) * 0.5 * style->line_width);
+}
+
+static inline void
+_gdv_axis_border_union (GtkBorder       *border,
+                        const GtkBorder *other)
+{
+  border->left = MAX (border->left, other->left);
+  border->right = MAX (border->right, other->right);
+  border->top = MAX (border->top, other->top);
+  border->bottom = MAX (border->bottom, other->bottom);
+}
+
+/* Measures the space, a tic with the given value would need, without adding
+ * it to the axis. */
+G_GNUC_INTERNAL void
+_gdv_axis_measure_tic (GdvAxis   *axis,
+                       gdouble    value,
+                       gboolean   minor,
+                       gdouble    inner_dir_x,
+                       gdouble    inner_dir_y,
+                       GtkBorder *border)
+{
+  GdvAxisTic tic = {0};
+  gdouble inner_dir_length;
+
+  _gdv_axis_ensure_tic_style (axis);
+
+  tic.value = value;
+  tic.minor = minor;
+  _gdv_axis_tic_setup (axis, &tic);
+
+  /* the direction is given by the caller */
+  inner_dir_length = sqrt (inner_dir_x * inner_dir_x +
+                           inner_dir_y * inner_dir_y);
+  tic.inner_dir_x = inner_dir_length ? inner_dir_x / inner_dir_length : 0.0;
+  tic.inner_dir_y = inner_dir_length ? inner_dir_y / inner_dir_length : 0.0;
+
+  _gdv_axis_tic_border (_gdv_axis_tic_style (axis, &tic), &tic, border);
+
+  _gdv_axis_tic_clear (&tic);
+}
+
+/* The union of the space all automatic major tics need */
+static void
+_gdv_axis_records_border (GdvAxis   *axis,
+                          GtkBorder *border)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  guint i;
+
+  border->left = 0;
+  border->right = 0;
+  border->top = 0;
+  border->bottom = 0;
+
+  for (i = 0; i < priv->tic_records->len; i++)
+  {
+    const GdvAxisTic *tic = &g_array_index (priv->tic_records, GdvAxisTic, i);
+    GtkBorder tic_border;
+
+    if (tic->minor)
+      continue;
+
+    _gdv_axis_tic_border (&priv->tic_style, tic, &tic_border);
+    _gdv_axis_border_union (border, &tic_border);
+  }
+}
+
+/* Determines the space all tics need around their position: the automatic
+ * tics as well as the #GdvTic-widgets. Like before, minor tics are not taken
+ * into account. */
+G_GNUC_INTERNAL void
+_gdv_axis_get_tics_border (GdvAxis   *axis,
+                           gint       for_size,
+                           GtkBorder *border)
 {
-  return axis->priv->resize_during_redraw;
+  GdvAxisPrivate *priv = axis->priv;
+  GList *tic_list;
+
+  /* the automatic tics are only measured again after they were rebuilt or
+   * their style changed */
+  if (!priv->tics_records_border_valid)
+  {
+    _gdv_axis_ensure_tic_style (axis);
+    _gdv_axis_records_border (axis, &priv->tics_records_border);
+    priv->tics_records_border_valid = TRUE;
+  }
+
+  *border = priv->tics_records_border;
+
+  for (tic_list = priv->tics; tic_list; tic_list = tic_list->next)
+  {
+    GtkBorder tic_border;
+    gint minimum, natural;
+
+    gdv_tic_get_space_to_tic_position (
+      tic_list->data, GTK_POS_LEFT, for_size, &minimum, &natural, NULL);
+    tic_border.left = MAX (minimum, natural);
+    gdv_tic_get_space_to_tic_position (
+      tic_list->data, GTK_POS_RIGHT, for_size, &minimum, &natural, NULL);
+    tic_border.right = MAX (minimum, natural);
+    gdv_tic_get_space_to_tic_position (
+      tic_list->data, GTK_POS_TOP, for_size, &minimum, &natural, NULL);
+    tic_border.top = MAX (minimum, natural);
+    gdv_tic_get_space_to_tic_position (
+      tic_list->data, GTK_POS_BOTTOM, for_size, &minimum, &natural, NULL);
+    tic_border.bottom = MAX (minimum, natural);
+
+    _gdv_axis_border_union (border, &tic_border);
+  }
+}
+
+/* Gives the space to the begin and to the end of the axis for all four
+ * directions, as the layer needs it for the crossing-points of its axes.
+ * The results of the vfuncs are kept until the tics, their labels, the title
+ * or the orientation change. Axes with tic-widgets are measured every time,
+ * since those tics move with every allocation. */
+G_GNUC_INTERNAL void
+_gdv_axis_get_spaces (GdvAxis *axis,
+                      gint     beg_space[4],
+                      gint     beg_space_nat[4],
+                      gint     end_space[4],
+                      gint     end_space_nat[4])
+{
+  static const GtkPositionType directions[4] =
+    {GTK_POS_TOP, GTK_POS_BOTTOM, GTK_POS_LEFT, GTK_POS_RIGHT};
+  GdvAxisClass *klass = GDV_AXIS_GET_CLASS (axis);
+  GdvAxisPrivate *priv = axis->priv;
+  GdvAxisSpaces *spaces = &priv->spaces;
+  gboolean title_visible;
+  gint title_width = 0, title_width_nat = 0;
+  gint title_height = 0, title_height_nat = 0;
+  guint i;
+
+  /* gtk keeps the size of the title by itself, so this is cheap */
+  title_visible = priv->title && gtk_widget_get_visible (priv->title);
+  if (title_visible)
+  {
+    gtk_widget_get_preferred_width (priv->title,
+                                    &title_width, &title_width_nat);
+    gtk_widget_get_preferred_height (priv->title,
+                                     &title_height, &title_height_nat);
+  }
+
+  if (!spaces->valid || priv->tics || priv->mtics ||
+      spaces->title != priv->title ||
+      spaces->title_visible != title_visible ||
+      spaces->title_width != title_width ||
+      spaces->title_width_nat != title_width_nat ||
+      spaces->title_height != title_height ||
+      spaces->title_height_nat != title_height_nat)
+  {
+    for (i = 0; i < 4; i++)
+    {
+      klass->get_space_to_beg_position (axis, directions[i], -1,
+                                        &spaces->beg_space[i],
+                                        &spaces->beg_space_nat[i], NULL);
+      klass->get_space_to_end_position (axis, directions[i], -1,
+                                        &spaces->end_space[i],
+                                        &spaces->end_space_nat[i], NULL);
+    }
+
+    spaces->title = priv->title;
+    spaces->title_visible = title_visible;
+    spaces->title_width = title_width;
+    spaces->title_width_nat = title_width_nat;
+    spaces->title_height = title_height;
+    spaces->title_height_nat = title_height_nat;
+    spaces->valid = TRUE;
+  }
+
+  memcpy (beg_space, spaces->beg_space, sizeof (spaces->beg_space));
+  memcpy (end_space, spaces->end_space, sizeof (spaces->end_space));
+  if (beg_space_nat)
+    memcpy (beg_space_nat, spaces->beg_space_nat,
+            sizeof (spaces->beg_space_nat));
+  if (end_space_nat)
+    memcpy (end_space_nat, spaces->end_space_nat,
+            sizeof (spaces->end_space_nat));
+}
+
+/* Two values match, if they are closer than the tolerance or only a few
+ * units in the last place apart. The tolerance is relative to the increment
+ * and not to the values; otherwise distinct tics of a scale far away from
+ * zero would be merged and a tic at zero would never match. */
+static gboolean
+_gdv_axis_tic_values_match (gdouble value_a,
+                            gdouble value_b,
+                            gdouble tolerance)
+{
+  gdouble diff, magnitude;
+
+  if (value_a == value_b)
+    return TRUE;
+
+  diff = fabs (value_a - value_b);
+  magnitude = fmax (fabs (value_a), fabs (value_b));
+
+  return diff <= tolerance ||
+         diff <= GDV_AXIS_TIC_ULPS * (nextafter (magnitude, G_MAXDOUBLE) - magnitude);
+}
+
+/* Bisects the sorted tics; index is set to the matching tic or to the
+ * position, where a tic with value would have to be inserted */
+static gboolean
+_gdv_axis_search_tics (GArray  *records,
+                       gdouble  value,
+                       gdouble  tolerance,
+                       guint   *index)
+{
+  guint low = 0, high = records->len;
+
+  while (low < high)
+  {
+    guint mid = low + (high - low) / 2;
+    gdouble mid_value = g_array_index (records, GdvAxisTic, mid).value;
+
+    if (_gdv_axis_tic_values_match (mid_value, value, tolerance))
+    {
+      *index = mid;
+      return TRUE;
+    }
+
+    if (mid_value < value)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  *index = low;
+
+  return FALSE;
+}
+
+/* Gives the tolerance of the values of automatic tics */
+G_GNUC_INTERNAL gdouble
+_gdv_axis_get_tic_tolerance (GdvAxis *axis)
+{
+  return axis->priv->tic_tolerance;
+}
+
+/* Starts to rebuild the automatic tics. The labels of the previous tics are
+ * reused, as long as their markup does not change. */
+G_GNUC_INTERNAL void
+_gdv_axis_begin_tics (GdvAxis *axis)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  GHashTable *layouts;
+  GArray *records;
+  gdouble reference;
+
+  _gdv_axis_ensure_tic_style (axis);
+
+  reference = fabs (priv->scale_increment_val);
+  if (reference == 0.0 || !isfinite (reference))
+    reference = fabs (priv->scale_max_val - priv->scale_min_val);
+  priv->tic_tolerance = isfinite (reference) ?
+                        GDV_AXIS_TIC_EPSILON * reference : 0.0;
+
+  records = priv->previous_tic_records;
+  priv->previous_tic_records = priv->tic_records;
+  priv->tic_records = records;
+  g_array_set_size (priv->tic_records, 0);
+
+  layouts = priv->previous_tic_layouts;
+  priv->previous_tic_layouts = priv->tic_layouts;
+  priv->tic_layouts = layouts;
+  g_hash_table_remove_all (priv->tic_layouts);
+}
+
+/* Adds an automatic tic; may only be called between _gdv_axis_begin_tics()
+ * and _gdv_axis_end_tics(). */
+G_GNUC_INTERNAL void
+_gdv_axis_append_tic (GdvAxis  *axis,
+                      gdouble   value,
+                      gboolean  minor)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  GdvAxisTic tic = {0};
+  guint index;
+
+  /* A tic, that only moved by round-off, keeps the value it had before;
+   * so does its label. Without this, 0.1 * 3 would not be 0.3 and a tic at
+   * zero might be labelled with something like -1.1e-16. */
+  if (_gdv_axis_search_tics (priv->previous_tic_records, value,
+                             priv->tic_tolerance, &index))
+    value = g_array_index (priv->previous_tic_records, GdvAxisTic, index).value;
+  else if (fabs (value) <= priv->tic_tolerance)
+    value = 0.0;
+
+  tic.value = value;
+  tic.minor = minor;
+  _gdv_axis_tic_setup (axis, &tic);
+
+  g_array_append_val (axis->priv->tic_records, tic);
+}
+
+static gint
+_gdv_axis_compare_tics (gconstpointer a,
+                        gconstpointer b)
+{
+  const GdvAxisTic *tic_a = a, *tic_b = b;
+
+  return (tic_a->value > tic_b->value) - (tic_a->value < tic_b->value);
+}
+
+/* Finishes the rebuild of the automatic tics */
+G_GNUC_INTERNAL void
+_gdv_axis_end_tics (GdvAxis *axis)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  GArray *records = priv->tic_records;
+  GtkBorder border;
+  guint i, n_unique = 0;
+
+  g_array_sort (records, _gdv_axis_compare_tics);
+
+  /* a minor tic, that falls on a major tic, is dropped */
+  for (i = 0; i < records->len; i++)
+  {
+    GdvAxisTic *tic = &g_array_index (records, GdvAxisTic, i);
+    GdvAxisTic *last = n_unique ?
+      &g_array_index (records, GdvAxisTic, n_unique - 1) : NULL;
+
+    if (last &&
+        _gdv_axis_tic_values_match (last->value, tic->value,
+                                    priv->tic_tolerance))
+    {
+      if (last->minor && !tic->minor)
+      {
+        _gdv_axis_tic_clear (last);
+        *last = *tic;
+        tic->layout = NULL;
+      }
+      else
+        /* its slot may be taken by a later record */
+        _gdv_axis_tic_clear (tic);
+
+      continue;
+    }
+
+    if (i != n_unique)
+    {
+      g_array_index (records, GdvAxisTic, n_unique) = *tic;
+      tic->layout = NULL;
+    }
+    n_unique++;
+  }
+
+  g_array_set_size (records, n_unique);
+
+  _gdv_axis_records_border (axis, &border);
+
+  g_array_set_size (priv->previous_tic_records, 0);
+  g_hash_table_remove_all (priv->previous_tic_layouts);
+
+  /* The new tics are already placed within this allocation. Only if they
+   * need a different amount of space, the spaces of the axis change; the
+   * two-d layer notices this while it is still allocating and aligns its axes
+   * again. Any other parent only measures its children before allocating
+   * them, so it has to measure the axis once more. */
+  if (!priv->tics_records_border_valid ||
+      border.left != priv->tics_records_border.left ||
+      border.right != priv->tics_records_border.right ||
+      border.top != priv->tics_records_border.top ||
+      border.bottom != priv->tics_records_border.bottom)
+  {
+    GtkWidget *parent = gtk_widget_get_parent (GTK_WIDGET (axis));
+
+    priv->tics_records_border = border;
+    priv->tics_records_border_valid = TRUE;
+    priv->spaces.valid = FALSE;
+
+    if (!parent || !GDV_TWOD_IS_LAYER (parent))
+      gtk_widget_queue_resize (GTK_WIDGET (axis));
+  }
+}
+
+/* Gives the automatic tics, sorted by value */
+G_GNUC_INTERNAL const GdvAxisTic *
+_gdv_axis_get_tics (GdvAxis *axis,
+                    guint   *n_tics)
+{
+  *n_tics = axis->priv->tic_records->len;
+
+  return (const GdvAxisTic *) axis->priv->tic_records->data;
+}
+
+static void
+_gdv_axis_place_tics (GdvAxis *axis)
+{
+  GArray *records = axis->priv->tic_records;
+  guint i;
+
+  for (i = 0; i < records->len; i++)
+  {
+    GdvAxisTic *tic = &g_array_index (records, GdvAxisTic, i);
+    gdouble inner_dir_x = 0.0, inner_dir_y = 0.0, inner_dir_length;
+
+    _gdv_axis_map_value (axis, tic->value, &tic->pos_x, &tic->pos_y);
+
+    GDV_AXIS_GET_CLASS (axis)->get_inner_dir (
+      axis, tic->value, &inner_dir_x, &inner_dir_y);
+
+    inner_dir_length = sqrt (inner_dir_x * inner_dir_x +
+                             inner_dir_y * inner_dir_y);
+
+    tic->inner_dir_x = inner_dir_length ? inner_dir_x / inner_dir_length : 0.0;
+    tic->inner_dir_y = inner_dir_length ? inner_dir_y / inner_dir_length : 0.0;
+  }
+}
+
+/* Strokes all major or all minor tics as a single path */
+static void
+_gdv_axis_stroke_tics (GdvAxis  *axis,
+                       cairo_t  *cr,
+                       gboolean  minor)
+{
+  GArray *records = axis->priv->tic_records;
+  const GdvAxisTicStyle *style =
+    minor ? &axis->priv->mtic_style : &axis->priv->tic_style;
+  gboolean empty = TRUE;
+  guint i;
+
+  if (style->line_width <= 0.0)
+    return;
+
+  cairo_new_path (cr);
+
+  for (i = 0; i < records->len; i++)
+  {
+    const GdvAxisTic *tic = &g_array_index (records, GdvAxisTic, i);
+
+    if (tic->minor != minor)
+      continue;
+
+    cairo_move_to (cr,
+                   tic->pos_x + tic->inner_dir_x * style->in_length + 0.5,
+                   tic->pos_y + tic->inner_dir_y * style->in_length + 0.5);
+    cairo_line_to (cr,
+                   tic->pos_x - tic->inner_dir_x * style->out_length + 0.5,
+                   tic->pos_y - tic->inner_dir_y * style->out_length + 0.5);
+    empty = FALSE;
+  }
+
+  if (empty)
+    return;
+
+  cairo_set_line_cap (cr, CAIRO_LINE_CAP_SQUARE);
+  cairo_set_line_width (cr, style->line_width);
+  gdk_cairo_set_source_rgba (cr, &style->color);
+  cairo_stroke (cr);
+}
+
+/* Draws the automatic tics; the labels are placed like the label of a
+ * #GdvTic */
+static void
+_gdv_axis_draw_tics (GdvAxis *axis,
+                     cairo_t *cr)
+{
+  GdvAxisPrivate *priv = axis->priv;
+  guint i;
+
+  if (!priv->tic_records->len)
+    return;
+
+  _gdv_axis_ensure_tic_style (axis);
+
+  cairo_save (cr);
+  _gdv_axis_stroke_tics (axis, cr, TRUE);
+  _gdv_axis_stroke_tics (axis, cr, FALSE);
+  cairo_restore (cr);
+
+  for (i = 0; i < priv->tic_records->len; i++)
+  {
+    const GdvAxisTic *tic = &g_array_index (priv->tic_records, GdvAxisTic, i);
+    const GdvAxisTicStyle *style = _gdv_axis_tic_style (axis, tic);
+    gdouble dir_x = tic->inner_dir_x, dir_y = tic->inner_dir_y;
+    gdouble xalign = -0.5 * fabs (dir_y), yalign = -0.5 * fabs (dir_x);
+    gdouble width = (gdouble) tic->label_width;
+    gdouble height = (gdouble) tic->label_height;
+    gint label_x, label_y;
+
+    if (!tic->layout)
+      continue;
+
+    label_x = (gint) (
+      tic->pos_x +
+      -1.0 * dir_x * (style->out_length + style->label_distance) +
+      fabs (0.5 * dir_y * style->line_width) +
+      (dir_x > 0.0 ? (xalign - dir_x) * width : xalign * width));
+    label_y = (gint) (
+      tic->pos_y +
+      -1.0 * dir_y * (style->out_length + style->label_distance) +
+      fabs (0.5 * dir_x * style->line_width) +
+      (dir_y > 0.0 ? (yalign - dir_y) * height : yalign * height));
+
+    gtk_render_layout (priv->label_context, cr,
+                       (gdouble) label_x, (gdouble) label_y, tic->layout);
+  }
 }
 
 static void
@@ -602,6 +1820,13 @@ gdv_axis_finalize (GObject *object)
     axis->priv->update_indicator_table = NULL;
   }
 
+  _gdv_axis_invalidate_tic_style (axis);
+
+  g_array_unref (axis->priv->tic_records);
+  g_array_unref (axis->priv->previous_tic_records);
+  g_hash_table_unref (axis->priv->tic_layouts);
+  g_hash_table_unref (axis->priv->previous_tic_layouts);
+
   G_OBJECT_CLASS (gdv_axis_parent_class)->finalize (object);
 }
 
@@ -702,8 +1927,7 @@ static void gdv_axis_add (GtkContainer *container_axis,
 
   gtk_widget_show_all (widget);
 
-//  if (gtk_widget_get_visible (GTK_WIDGET (axis)))
-  axis->priv->resize_during_redraw = TRUE;
+  axis->priv->spaces.valid = FALSE;
 }
 
 static void gdv_axis_remove (GtkContainer *container_axis,
@@ -774,8 +1998,7 @@ static void gdv_axis_remove (GtkContainer *container_axis,
   }
 */
 
-//  if (gtk_widget_get_visible (GTK_WIDGET (axis)))
-  axis->priv->resize_during_redraw = TRUE;
+  axis->priv->spaces.valid = FALSE;
 }
 
 static void gdv_axis_forall (GtkContainer *container,
@@ -974,6 +2197,8 @@ gdv_axis_class_init (GdvAxisClass *klass)
    */
   widget_class->size_allocate =
     gdv_axis_size_allocate;
+  widget_class->style_updated =
+    gdv_axis_style_updated;
 
   widget_class->draw =
     gdv_axis_draw;
@@ -1595,7 +2820,8 @@ gint _axis_compare_tic_value (gconstpointer a, gconstpointer b)
  * This function should be used carefully. It is usual difficult to use due to
  * problems with the precision of Tic-valus and rounding-issues. Most of the
  * time it will be a better solution to use gdv_axis_get_tic_list() and compare
- * the tic-values to a specific precision-criteria.
+ * the tic-values to a specific precision-criteria. Automatic tics are looked
+ * up with gdv_axis_lookup_tic(), which already takes care of round-off.
  *
  * Returns: (nullable) (transfer none): The #GdvTic with the given Tic-value
  *
@@ -1660,6 +2886,99 @@ GList *gdv_axis_get_mtic_list (GdvAxis *axis)
   return mtic_list_copy;
 }
 
+/**
+ * gdv_axis_get_n_tics:
+ * @axis: a #GdvAxis
+ *
+ * Counts the tics, that are set automatically by @axis. These are major and
+ * minor tics, that are not part of gdv_axis_get_tic_list() or
+ * gdv_axis_get_mtic_list().
+ *
+ * Returns: the number of automatic tics
+ */
+guint gdv_axis_get_n_tics (GdvAxis *axis)
+{
+  g_return_val_if_fail (GDV_IS_AXIS (axis), 0);
+
+  return axis->priv->tic_records->len;
+}
+
+/**
+ * gdv_axis_get_nth_tic:
+ * @axis: a #GdvAxis
+ * @n: the index of the tic
+ * @value: (out) (optional): the value of the tic
+ * @minor: (out) (optional): %TRUE if the tic is a minor tic
+ * @pos_x: (out) (optional): the x-position of the tic
+ * @pos_y: (out) (optional): the y-position of the tic
+ *
+ * Gives the automatic tic at @n. The tics are sorted by value. Like the
+ * #GdvTic:pos-x and #GdvTic:pos-y properties, the position is given in the
+ * coordinates of the parent of @axis.
+ *
+ * Returns: %TRUE if there is a tic at @n and %FALSE otherwise
+ */
+gboolean gdv_axis_get_nth_tic (GdvAxis  *axis,
+                               guint     n,
+                               gdouble  *value,
+                               gboolean *minor,
+                               gdouble  *pos_x,
+                               gdouble  *pos_y)
+{
+  const GdvAxisTic *tic;
+  GtkAllocation allocation;
+
+  g_return_val_if_fail (GDV_IS_AXIS (axis), FALSE);
+
+  if (n >= axis->priv->tic_records->len)
+    return FALSE;
+
+  tic = &g_array_index (axis->priv->tic_records, GdvAxisTic, n);
+  gtk_widget_get_allocation (GTK_WIDGET (axis), &allocation);
+
+  if (value)
+    *value = tic->value;
+  if (minor)
+    *minor = tic->minor;
+  if (pos_x)
+    *pos_x = tic->pos_x + (gdouble) allocation.x;
+  if (pos_y)
+    *pos_y = tic->pos_y + (gdouble) allocation.y;
+
+  return TRUE;
+}
+
+/**
+ * gdv_axis_lookup_tic:
+ * @axis: a #GdvAxis
+ * @value: the value to look for
+ * @index: (out) (optional): the index of the tic or the index, where a tic
+ *     with @value would be inserted
+ *
+ * Looks up the automatic tic with @value by bisection. Values, that only
+ * differ by round-off, are considered to be equal; the tolerance is a small
+ * fraction of the increment of @axis.
+ *
+ * Returns: %TRUE if there is a tic with @value and %FALSE otherwise
+ */
+gboolean gdv_axis_lookup_tic (GdvAxis *axis,
+                              gdouble  value,
+                              guint   *index)
+{
+  guint local_index;
+  gboolean found;
+
+  g_return_val_if_fail (GDV_IS_AXIS (axis), FALSE);
+
+  found = _gdv_axis_search_tics (axis->priv->tic_records, value,
+                                 axis->priv->tic_tolerance, &local_index);
+
+  if (index)
+    *index = local_index;
+
+  return found;
+}
+
 /**
  * gdv_axis_get_indicator_list:
  * @axis: a #GdvAxis
@@ -1910,7 +3229,7 @@ gdv_axis_measure (
   int                 *natural_baseline,
   gpointer             data)
 {
-  GList *tics_list;
+  GtkBorder tics_border;
   gint glob_tic_min_start = 0, glob_tic_nat_start = 0,
        glob_tic_min_stop = 0, glob_tic_nat_stop = 0;
   gint scale_min_diff, projected_min_diff = 0;
@@ -1938,126 +3257,23 @@ gdv_axis_measure (
       (gint) ((fabs(cos (axis_direction)) * ((gdouble) scale_min_diff + 0.5))
               + fabs(sin (axis_direction)) * axis_line_width);
 
-  /* FIXME: this is not really not an elegant solution here */
-  for (
-    tics_list = axis->priv->tics;
-    tics_list;
-    tics_list = tics_list->next)
-  {
-    GdvTic *local_tic = tics_list->data;
-    gint loc_tic_min_start, loc_tic_nat_start,
-         loc_tic_min_stop, loc_tic_nat_stop;
-    gint loc_tic_min_size = 0, loc_tic_nat_size = 0;
-
-    if (orientation == GTK_ORIENTATION_HORIZONTAL)
-    {
-      gdv_tic_get_space_to_tic_position (
-        local_tic, GTK_POS_LEFT, for_size,
-        &loc_tic_min_start, &loc_tic_nat_start, data);
-      gdv_tic_get_space_to_tic_position (
-        local_tic, GTK_POS_RIGHT, for_size,
-        &loc_tic_min_stop, &loc_tic_nat_stop, data);
-
-      /* this is more for the record and not obligatoric */
-      if (for_size > 0)
-        gtk_widget_get_preferred_width_for_height (
-          GTK_WIDGET (local_tic), for_size, &loc_tic_min_size, &loc_tic_nat_size);
-      else
-        gtk_widget_get_preferred_width (
-          GTK_WIDGET (local_tic), &loc_tic_min_size, &loc_tic_nat_size);
-    }
-    else
-    {
-      gdv_tic_get_space_to_tic_position (
-        local_tic, GTK_POS_TOP, for_size,
-        &loc_tic_min_start, &loc_tic_nat_start, data);
-      gdv_tic_get_space_to_tic_position (
-        local_tic, GTK_POS_BOTTOM, for_size,
-        &loc_tic_min_stop, &loc_tic_nat_stop, data);
-
-      /* this is more fore the record and not obligatoric */
-      if (for_size > 0)
-        gtk_widget_get_preferred_height_for_width (
-          GTK_WIDGET (local_tic), for_size, &loc_tic_min_size, &loc_tic_nat_size);
-      else
-        gtk_widget_get_preferred_height (
-          GTK_WIDGET (local_tic), &loc_tic_min_size, &loc_tic_nat_size);
-    }
+  /* the automatic tics and the tic-widgets */
+  _gdv_axis_get_tics_border (axis, for_size, &tics_border);
 
-    glob_tic_min_start =
-      (glob_tic_min_start < loc_tic_min_start ?
-       loc_tic_min_start : glob_tic_min_start);
-    glob_tic_min_stop =
-      glob_tic_min_stop < loc_tic_min_stop ?
-      loc_tic_min_stop : glob_tic_min_stop;
-    glob_tic_nat_start =
-      glob_tic_nat_start < loc_tic_nat_start ?
-      loc_tic_nat_start : glob_tic_nat_start;
-    glob_tic_nat_stop =
-      glob_tic_nat_stop < loc_tic_nat_stop ?
-      loc_tic_nat_stop : glob_tic_nat_stop;
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+  {
+    glob_tic_min_start = tics_border.left;
+    glob_tic_min_stop = tics_border.right;
+  }
+  else
+  {
+    glob_tic_min_start = tics_border.top;
+    glob_tic_min_stop = tics_border.bottom;
   }
 
-  /* Getting the size of the minor tics */
-  /*  for (
-      tics_list = axis->priv->mtics;
-      tics_list;
-      tics_list = tics_list->next)
-    {
-      GdvTic *local_tic = tics_list->data;
-      gint loc_tic_min_start, loc_tic_nat_start,
-           loc_tic_min_stop, loc_tic_nat_stop;
-      gint loc_tic_min_size = 0, loc_tic_nat_size = 0;
+  glob_tic_nat_start = glob_tic_min_start;
+  glob_tic_nat_stop = glob_tic_min_stop;
 
-      if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      {
-        gdv_tic_get_space_to_tic_position (
-          local_tic, GTK_POS_LEFT, for_size,
-          &loc_tic_min_start, &loc_tic_nat_start, data);
-        gdv_tic_get_space_to_tic_position (
-          local_tic, GTK_POS_RIGHT, for_size,
-          &loc_tic_nat_start, &loc_tic_nat_stop, data);
-  */
-  /* this is more fore the record and not obligatoric */
-  /*      if (for_size > 0)
-          gtk_widget_get_preferred_width_for_height (
-            GTK_WIDGET (local_tic), for_size, &loc_tic_min_size, &loc_tic_nat_size);
-        else
-          gtk_widget_get_preferred_width (
-            GTK_WIDGET (local_tic), &loc_tic_min_size, &loc_tic_nat_size);
-      }
-      else
-      {
-        gdv_tic_get_space_to_tic_position (
-          local_tic, GTK_POS_TOP, for_size,
-          &loc_tic_min_start, &loc_tic_nat_start, data);
-        gdv_tic_get_space_to_tic_position (
-          local_tic, GTK_POS_BOTTOM, for_size,
-          &loc_tic_nat_start, &loc_tic_nat_stop, data);
-  */
-  /* this is more fore the record and not obligatoric */
-  /*      if (for_size > 0)
-          gtk_widget_get_preferred_height_for_width (
-            GTK_WIDGET (local_tic), for_size, &loc_tic_min_size, &loc_tic_nat_size);
-        else
-          gtk_widget_get_preferred_height (
-            GTK_WIDGET (local_tic), &loc_tic_min_size, &loc_tic_nat_size);
-      }
-
-      glob_tic_min_start =
-        glob_tic_min_start < loc_tic_min_start ?
-          loc_tic_min_start : glob_tic_min_start;
-      glob_tic_min_stop =
-        glob_tic_min_stop < loc_tic_min_stop ?
-          loc_tic_min_stop : glob_tic_min_stop;
-      glob_tic_nat_start =
-        glob_tic_nat_start < loc_tic_nat_start ?
-          loc_tic_nat_start : glob_tic_nat_start;
-      glob_tic_nat_stop =
-        glob_tic_nat_stop < loc_tic_nat_stop ?
-          loc_tic_nat_stop : glob_tic_nat_stop;
-    }
-  */
   *minimum =
     glob_tic_min_start + glob_tic_min_stop + projected_min_diff;
   *natural =
@@ -2148,6 +3364,8 @@ gdv_axis_size_allocate (GtkWidget     *widget,
     axis->priv->axis_end_pix_y =  axis->priv->end_at_screen_y * (gdouble) allocation->height;
   }
 
+  axis->priv->transform_valid = FALSE;
+
   /* reallocating axis-indicator */
   local_indicator_list = axis->priv->indicators;
 
@@ -2264,6 +3482,23 @@ gdv_axis_size_allocate (GtkWidget     *widget,
     axis->priv->beg_at_screen_y = axis->priv->axis_beg_pix_y / (gdouble) allocation->height;
     axis->priv->end_at_screen_y = axis->priv->axis_end_pix_y / (gdouble) allocation->height;
   }
+
+  _gdv_axis_update_transform (axis);
+  _gdv_axis_place_tics (axis);
+}
+
+static void
+gdv_axis_style_updated (GtkWidget *widget)
+{
+  GdvAxis *axis = GDV_AXIS (widget);
+
+  GTK_WIDGET_CLASS (gdv_axis_parent_class)->style_updated (widget);
+
+  /* the snapshot and all labels have to be taken again */
+  _gdv_axis_invalidate_tic_style (axis);
+  g_hash_table_remove_all (axis->priv->tic_layouts);
+
+  gtk_widget_queue_resize (widget);
 }
 
 static gboolean
@@ -2294,8 +3529,7 @@ gdv_axis_draw (GtkWidget    *widget,
 //  scale_beg_val = axis->priv->scale_min_val;
 //  scale_end_val = axis->priv->scale_max_val;
 
-  if (axis_line_width && cr != NULL &&
-      (!axis->priv->resize_during_redraw || axis->priv->force_beg_end))
+  if (axis_line_width && cr != NULL)
   {
     /* plotting axis-line */
     gdv_render_line (
@@ -2306,16 +3540,8 @@ gdv_axis_draw (GtkWidget    *widget,
       (gdouble) end_y);
   }
 
-  if (axis->priv->resize_during_redraw && !axis->priv->force_beg_end)
-  {
-    gtk_widget_queue_resize (GTK_WIDGET (widget));
-    axis->priv->resize_during_redraw = FALSE;
-    return TRUE;
-  }
-  else
-  {
-    GTK_WIDGET_CLASS (gdv_axis_parent_class)->draw (widget, cr);
-  }
+  _gdv_axis_draw_tics (axis, cr);
+  GTK_WIDGET_CLASS (gdv_axis_parent_class)->draw (widget, cr);
 
   return FALSE;
 }
@@ -2393,6 +3619,7 @@ gboolean gdv_axis_queue_value_interval (GdvAxis *axis, gdouble value)
   if (value < axis->priv->scale_min_val)
   {
     axis->priv->scale_min_val = value;
+    axis->priv->transform_valid = FALSE;
     g_object_notify (G_OBJECT (axis), "scale-beg-val");
     return TRUE;
   }
@@ -2400,6 +3627,7 @@ gboolean gdv_axis_queue_value_interval (GdvAxis *axis, gdouble value)
   if (value > axis->priv->scale_max_val)
   {
     axis->priv->scale_max_val = value;
+    axis->priv->transform_valid = FALSE;
     g_object_notify (G_OBJECT (axis), "scale-end-val");
     return TRUE;
   }
@@ -118,6 +118,17 @@ GList *gdv_axis_get_tic_list (GdvAxis *axis);
 GList *gdv_axis_get_mtic_list (GdvAxis *axis);
 GList *gdv_axis_get_indicator_list (GdvAxis *axis);
 
+guint gdv_axis_get_n_tics (GdvAxis *axis);
+gboolean gdv_axis_get_nth_tic (GdvAxis  *axis,
+                               guint     n,
+                               gdouble  *value,
+                               gboolean *minor,
+                               gdouble  *pos_x,
+                               gdouble  *pos_y);
+gboolean gdv_axis_lookup_tic (GdvAxis *axis,
+                              gdouble  value,
+                              guint   *index);
+
 GdvTic *gdv_axis_get_tic_at_value (GdvAxis *axis, gdouble value);
 
 void gdv_axis_title_set_markup (GdvAxis *axis, gchar *markup);
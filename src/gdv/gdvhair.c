@@ -28,8 +28,10 @@
 #include <cairo-gobject.h>
 
 #include "gdvhair.h"
+#include "gdvtheme-private.h"
 #include "gdv-data-boxed.h"
 #include "gdvaxis.h"
+#include "gdvaxis-private.h"
 #include "gdvlayer.h"
 #include "gdvrender.h"
 
@@ -99,7 +101,6 @@ gdv_hair_init (GdvHair *hair)
 {
   GtkWidget *widget;
   GtkStyleContext *style_context;
-  GtkCssProvider *css_provider;
   GdvHairPrivate *priv = gdv_hair_get_instance_private (hair);
   hair->priv = priv;
   widget = GTK_WIDGET (hair);
@@ -115,16 +116,8 @@ gdv_hair_init (GdvHair *hair)
   gtk_widget_set_name (widget, "new hair");
 
   /* initializing style-properties */
-  css_provider = gtk_css_provider_new ();
   style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
-
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+  _gdv_theme_add_to_context (style_context);
 
   gtk_widget_set_can_focus (widget, TRUE);
   gtk_widget_set_receives_default (widget, TRUE);
@@ -283,43 +276,43 @@ gboolean gdv_hair_draw (GtkWidget   *widget,
   GdvHair *hair = GDV_HAIR (widget);
   GdvHairPrivate *priv = gdv_hair_get_instance_private (hair);
 //  GdvAxis *axis = GDV_AXIS (gtk_widget_get_parent (widget));
-  gboolean on_axis;
+  const GdvAxisTransform *transform;
   GtkStyleContext *context;
-  GtkAllocation alloc, layer_alloc;
+  GtkAllocation layer_alloc;
 
   if (!priv->from_axis)
+  {
     g_warning ("from-axis for %s is not set",
                g_type_name (G_TYPE_FROM_INSTANCE (widget)));
+    return FALSE;
+  }
 
   gtk_widget_get_allocation (GTK_WIDGET(hair), &layer_alloc);
 
-  g_signal_emit_by_name (
-    priv->from_axis,
-    "get-point",
-    priv->value,
-    &priv->from_x,
-    &priv->from_y,
-    &on_axis);
+  _gdv_axis_map_value (priv->from_axis,
+                       priv->value,
+                       &priv->from_x,
+                       &priv->from_y);
 
-  gtk_widget_get_allocation (GTK_WIDGET(priv->from_axis), &alloc);
-  priv->from_x += alloc.x - layer_alloc.x;
-  priv->from_y += alloc.y - layer_alloc.y;
+  transform = _gdv_axis_get_transform (priv->from_axis);
+  priv->from_x += transform->origin_x - layer_alloc.x;
+  priv->from_y += transform->origin_y - layer_alloc.y;
 
   if (!priv->to_axis)
+  {
     g_warning ("to-axis for %s is not set",
                g_type_name (G_TYPE_FROM_INSTANCE (widget)));
+    return FALSE;
+  }
+
+  _gdv_axis_map_value (priv->to_axis,
+                       priv->value,
+                       &priv->to_x,
+                       &priv->to_y);
 
-  g_signal_emit_by_name (
-    priv->to_axis,
-    "get-point",
-    priv->value,
-    &priv->to_x,
-    &priv->to_y,
-    &on_axis);
-
-  gtk_widget_get_allocation (GTK_WIDGET(priv->to_axis), &alloc);
-  priv->to_x += alloc.x - layer_alloc.x;
-  priv->to_y += alloc.y - layer_alloc.y;
+  transform = _gdv_axis_get_transform (priv->to_axis);
+  priv->to_x += transform->origin_x - layer_alloc.x;
+  priv->to_y += transform->origin_y - layer_alloc.y;
 
 
   /* TODO: remember to make this an property, if implemented as allocation */
@@ -28,6 +28,7 @@
 #include <cairo-gobject.h>
 
 #include "gdvindicator.h"
+#include "gdvtheme-private.h"
 #include "gdv-data-boxed.h"
 #include "gdvaxis.h"
 #include "gdvrender.h"
@@ -110,7 +111,6 @@ static void
 gdv_indicator_init (GdvIndicator *indicator)
 {
   GtkStyleContext *style_context;
-  GtkCssProvider *css_provider;
 
   GtkWidget *widget;
 
@@ -118,16 +118,8 @@ gdv_indicator_init (GdvIndicator *indicator)
 
   gtk_widget_set_name (widget, "new indicator");
 
-  css_provider = gtk_css_provider_new ();
   style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
-
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+  _gdv_theme_add_to_context (style_context);
 
   indicator->priv = gdv_indicator_get_instance_private (indicator);
 
@@ -0,0 +1,609 @@
+/*
+ * gdvingest.c
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include <config.h>
+#endif
+
+#include <string.h>
+
+#include "gdvingest.h"
+
+/**
+ * SECTION:gdvingest
+ * @title: GdvIngest
+ * @short_description: feeding a layer-content from another thread
+ *
+ * #GdvIngest is a queue of samples, that is attached to a #GdvLayerContent.
+ * As all widgets, a #GdvLayerContent may only be modified by the main thread.
+ * A #GdvIngest can be filled by a single worker thread instead, e.g. a thread
+ * that acquires data from some hardware, without any locks or allocations.
+ *
+ * The queued samples are appended to the content in a single block on every
+ * frame of the content, or whenever gdv_ingest_flush() is called.
+ *
+ * If the producer is faster than the content, the #GdvIngestOverflow policy
+ * decides whether the producer waits, the oldest samples are dropped or new
+ * blocks are decimated. gdv_ingest_get_n_dropped() tells how many samples
+ * were lost this way. A producer, that waits, sleeps until the next frame of
+ * the content takes over samples; so %GDV_INGEST_BLOCK must not be used by the
+ * main thread itself.
+ *
+ * Only one thread may push samples at a time.
+ */
+
+/* every slot of the ring stores x, y and z of a single sample */
+#define GDV_INGEST_SLOT_SIZE 3
+
+struct _GdvIngestPrivate
+{
+  GdvLayerContent *content;
+  guint tick_id;
+  GThread *main_thread;
+
+  /* a producer, that waits for free slots, sleeps on drained; it is woken up
+   * by every flush and once the content is detached */
+  GMutex lock;
+  GCond drained;
+  gboolean detached;
+
+  GdvIngestOverflow policy;
+
+  /* The ring of samples; head and tail are free-running counters, so the
+   * number of queued samples is tail - head. Only the producer moves tail;
+   * head is moved by the consumer and, for GDV_INGEST_DROP_OLDEST, also by
+   * the producer, so both use compare-and-exchange on it. */
+  gsize capacity;
+  gdouble *slots;
+  volatile gsize head;
+  volatile gsize tail;
+
+  volatile gsize n_pushed;
+  volatile gsize n_dropped;
+
+  /* consumer-side copy of the queued samples */
+  gdouble *drain;
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE (GdvIngest,
+                            gdv_ingest,
+                            G_TYPE_OBJECT)
+
+static void _gdv_ingest_content_gone (gpointer  data,
+                                      GObject  *where_the_object_was);
+
+/* wakes up a waiting producer for good */
+static void
+_gdv_ingest_set_detached (GdvIngestPrivate *priv)
+{
+  g_mutex_lock (&priv->lock);
+  priv->detached = TRUE;
+  g_cond_broadcast (&priv->drained);
+  g_mutex_unlock (&priv->lock);
+}
+
+static void
+gdv_ingest_dispose (GObject *object)
+{
+  GdvIngestPrivate *priv = GDV_INGEST (object)->priv;
+
+  /* the content may outlive the ingest, e.g. once its tick-callback, that
+   * held the last reference, was removed by gtk_widget_destroy() */
+  if (priv->content)
+    {
+      GdvLayerContent *content = priv->content;
+      guint tick_id = priv->tick_id;
+
+      g_object_weak_unref (G_OBJECT (content),
+                           _gdv_ingest_content_gone, object);
+
+      priv->content = NULL;
+      priv->tick_id = 0;
+
+      if (tick_id)
+        gtk_widget_remove_tick_callback (GTK_WIDGET (content), tick_id);
+    }
+
+  _gdv_ingest_set_detached (priv);
+
+  G_OBJECT_CLASS (gdv_ingest_parent_class)->dispose (object);
+}
+
+static void
+gdv_ingest_finalize (GObject *object)
+{
+  GdvIngest *ingest = GDV_INGEST (object);
+
+  g_clear_pointer (&ingest->priv->slots, g_free);
+  g_clear_pointer (&ingest->priv->drain, g_free);
+
+  g_mutex_clear (&ingest->priv->lock);
+  g_cond_clear (&ingest->priv->drained);
+
+  G_OBJECT_CLASS (gdv_ingest_parent_class)->finalize (object);
+}
+
+static void
+gdv_ingest_class_init (GdvIngestClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->dispose = gdv_ingest_dispose;
+  object_class->finalize = gdv_ingest_finalize;
+}
+
+static void
+gdv_ingest_init (GdvIngest *ingest)
+{
+  ingest->priv = gdv_ingest_get_instance_private (ingest);
+
+  ingest->priv->content = NULL;
+  ingest->priv->tick_id = 0;
+  ingest->priv->main_thread = NULL;
+  g_mutex_init (&ingest->priv->lock);
+  g_cond_init (&ingest->priv->drained);
+  ingest->priv->detached = FALSE;
+  ingest->priv->policy = GDV_INGEST_BLOCK;
+  ingest->priv->capacity = 0;
+  ingest->priv->slots = NULL;
+  ingest->priv->head = 0;
+  ingest->priv->tail = 0;
+  ingest->priv->n_pushed = 0;
+  ingest->priv->n_dropped = 0;
+  ingest->priv->drain = NULL;
+}
+
+static gboolean
+_gdv_ingest_tick (GtkWidget     *widget,
+                  GdkFrameClock *frame_clock,
+                  gpointer       user_data)
+{
+  gdv_ingest_flush (GDV_INGEST (user_data));
+
+  return G_SOURCE_CONTINUE;
+}
+
+static void
+_gdv_ingest_content_gone (gpointer  data,
+                          GObject  *where_the_object_was)
+{
+  GdvIngest *ingest = data;
+
+  ingest->priv->content = NULL;
+  ingest->priv->tick_id = 0;
+
+  _gdv_ingest_set_detached (ingest->priv);
+}
+
+/**
+ * gdv_ingest_new:
+ * @content: the #GdvLayerContent to feed
+ * @capacity: the maximum number of queued samples; rounded up to a power of 2
+ * @policy: what to do with new samples, if the queue is full
+ *
+ * Creates a new queue for @content. The samples are taken over once per frame
+ * of @content. This function has to be called from the main thread.
+ *
+ * Returns: a new #GdvIngest
+ **/
+GdvIngest *
+gdv_ingest_new (GdvLayerContent   *content,
+                gsize              capacity,
+                GdvIngestOverflow  policy)
+{
+  GdvIngest *ingest;
+  GdvIngestPrivate *priv;
+
+  g_return_val_if_fail (GDV_LAYER_IS_CONTENT (content), NULL);
+  g_return_val_if_fail (capacity > 0 && capacity <= G_MAXSIZE / 4, NULL);
+
+  ingest = g_object_new (GDV_TYPE_INGEST, NULL);
+  priv = ingest->priv;
+
+  /* a power of 2 keeps the slots valid while the counters wrap around */
+  for (priv->capacity = 1; priv->capacity < capacity; priv->capacity *= 2);
+
+  priv->policy = policy;
+  priv->main_thread = g_thread_self ();
+  priv->slots = g_new (gdouble, GDV_INGEST_SLOT_SIZE * priv->capacity);
+  priv->drain = g_new (gdouble, GDV_INGEST_SLOT_SIZE * priv->capacity);
+
+  priv->content = content;
+  g_object_weak_ref (G_OBJECT (content), _gdv_ingest_content_gone, ingest);
+
+  priv->tick_id =
+    gtk_widget_add_tick_callback (GTK_WIDGET (content),
+                                  _gdv_ingest_tick,
+                                  g_object_ref (ingest),
+                                  g_object_unref);
+
+  return ingest;
+}
+
+/* copies n_points samples, taking every step-th from the arrays, into the
+ * slots behind tail and publishes them */
+static void
+_gdv_ingest_write (GdvIngestPrivate *priv,
+                   const gdouble    *x_values,
+                   const gdouble    *y_values,
+                   const gdouble    *z_values,
+                   gsize             n_points,
+                   gsize             step)
+{
+  gsize tail = g_atomic_pointer_get (&priv->tail);
+  gsize mask = priv->capacity - 1;
+  gsize i;
+
+  for (i = 0; i < n_points; i++)
+    {
+      gdouble *slot = priv->slots + GDV_INGEST_SLOT_SIZE * ((tail + i) & mask);
+
+      slot[0] = x_values ? x_values[i * step] : 0.0;
+      slot[1] = y_values ? y_values[i * step] : 0.0;
+      slot[2] = z_values ? z_values[i * step] : 0.0;
+    }
+
+  /* the slots have to be written, before they are published */
+  g_atomic_pointer_set (&priv->tail, tail + n_points);
+  g_atomic_pointer_add (&priv->n_pushed, n_points);
+}
+
+static inline gsize
+_gdv_ingest_free_slots (GdvIngestPrivate *priv)
+{
+  return priv->capacity - (g_atomic_pointer_get (&priv->tail) -
+                           g_atomic_pointer_get (&priv->head));
+}
+
+/**
+ * gdv_ingest_push: (skip)
+ * @ingest: a #GdvIngest
+ * @x_values: (nullable): the x values of the new samples
+ * @y_values: (nullable): the y values of the new samples
+ * @z_values: (nullable): the z values of the new samples
+ * @n_points: the number of new samples
+ * @stride: the distance between two consecutive values in each array,
+ *   counted in #gdouble elements
+ *
+ * Queues a block of samples for the content of @ingest. This function may be
+ * called from any thread, as long as only one thread pushes at a time. It does
+ * not take any locks, as long as there are free slots.
+ *
+ * If the queue is full and the policy is %GDV_INGEST_BLOCK, the calling
+ * thread sleeps until the next frame of the content takes over samples. Since
+ * the frames are handled by the main thread, it must not push with this
+ * policy. Once the content is detached or gone, the remaining samples are
+ * not queued any more.
+ *
+ * A missing array is interpreted as a series of zeros.
+ *
+ * Returns: the number of new samples that were queued
+ **/
+gsize
+gdv_ingest_push (GdvIngest     *ingest,
+                 const gdouble *x_values,
+                 const gdouble *y_values,
+                 const gdouble *z_values,
+                 gsize          n_points,
+                 gsize          stride)
+{
+  GdvIngestPrivate *priv;
+  gsize free_slots, queued = 0;
+
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), 0);
+  g_return_val_if_fail (stride > 0, 0);
+
+  priv = ingest->priv;
+
+  /* the main thread would wait for itself */
+  g_return_val_if_fail (priv->policy != GDV_INGEST_BLOCK ||
+                        g_thread_self () != priv->main_thread, 0);
+
+  switch (priv->policy)
+  {
+  case GDV_INGEST_BLOCK:
+    while (queued < n_points)
+      {
+        gsize chunk;
+
+        if ((free_slots = _gdv_ingest_free_slots (priv)) == 0)
+          {
+            g_mutex_lock (&priv->lock);
+
+            while ((free_slots = _gdv_ingest_free_slots (priv)) == 0 &&
+                   !priv->detached)
+              g_cond_wait (&priv->drained, &priv->lock);
+
+            g_mutex_unlock (&priv->lock);
+
+            if (free_slots == 0)
+              break;
+          }
+
+        chunk = MIN (free_slots, n_points - queued);
+
+        _gdv_ingest_write (priv,
+                           x_values ? x_values + queued * stride : NULL,
+                           y_values ? y_values + queued * stride : NULL,
+                           z_values ? z_values + queued * stride : NULL,
+                           chunk, stride);
+        queued += chunk;
+      }
+    break;
+
+  case GDV_INGEST_DROP_OLDEST:
+    /* only the newest samples of an oversized block survive anyway */
+    if (n_points > priv->capacity)
+      {
+        gsize surplus = n_points - priv->capacity;
+
+        g_atomic_pointer_add (&priv->n_dropped, surplus);
+
+        x_values = x_values ? x_values + surplus * stride : NULL;
+        y_values = y_values ? y_values + surplus * stride : NULL;
+        z_values = z_values ? z_values + surplus * stride : NULL;
+        n_points = priv->capacity;
+      }
+
+    /* the consumer may move head concurrently, so retry until one of us has
+     * freed enough slots */
+    while (TRUE)
+      {
+        gsize head = g_atomic_pointer_get (&priv->head);
+        gsize used = g_atomic_pointer_get (&priv->tail) - head;
+        gsize missing;
+
+        if (priv->capacity - used >= n_points)
+          break;
+
+        missing = n_points - (priv->capacity - used);
+
+        if (g_atomic_pointer_compare_and_exchange (&priv->head,
+                                                   head, head + missing))
+          {
+            g_atomic_pointer_add (&priv->n_dropped, missing);
+            break;
+          }
+      }
+
+    _gdv_ingest_write (priv, x_values, y_values, z_values, n_points, stride);
+    queued = n_points;
+    break;
+
+  case GDV_INGEST_DECIMATE:
+    free_slots = _gdv_ingest_free_slots (priv);
+
+    if (free_slots >= n_points)
+      {
+        _gdv_ingest_write (priv, x_values, y_values, z_values,
+                           n_points, stride);
+        queued = n_points;
+      }
+    else if (free_slots > 0)
+      {
+        /* every step-th sample fits into the free slots */
+        gsize step = (n_points + free_slots - 1) / free_slots;
+
+        queued = (n_points + step - 1) / step;
+        _gdv_ingest_write (priv, x_values, y_values, z_values,
+                           queued, step * stride);
+      }
+
+    g_atomic_pointer_add (&priv->n_dropped, n_points - queued);
+    break;
+
+  default:
+    g_warn_if_reached ();
+    break;
+  }
+
+  return queued;
+}
+
+/**
+ * gdv_ingest_push_point:
+ * @ingest: a #GdvIngest
+ * @x_value: the x value of the new sample
+ * @y_value: the y value of the new sample
+ * @z_value: the z value of the new sample
+ *
+ * Queues a single sample. See gdv_ingest_push() for details.
+ *
+ * Returns: %TRUE if the sample was queued
+ **/
+gboolean
+gdv_ingest_push_point (GdvIngest *ingest,
+                       gdouble    x_value,
+                       gdouble    y_value,
+                       gdouble    z_value)
+{
+  return gdv_ingest_push (ingest, &x_value, &y_value, &z_value, 1, 1) == 1;
+}
+
+/**
+ * gdv_ingest_flush:
+ * @ingest: a #GdvIngest
+ *
+ * Appends all queued samples to the content of @ingest at once. This happens
+ * automatically on every frame of the content, but may also be called
+ * explicitly from the main thread.
+ *
+ * Returns: the number of samples that were appended
+ **/
+gsize
+gdv_ingest_flush (GdvIngest *ingest)
+{
+  GdvIngestPrivate *priv;
+  gsize head, tail, first, seq, mask, n_points;
+  gdouble *samples;
+
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), 0);
+
+  priv = ingest->priv;
+  mask = priv->capacity - 1;
+
+  head = g_atomic_pointer_get (&priv->head);
+  tail = g_atomic_pointer_get (&priv->tail);
+
+  if (head == tail)
+    return 0;
+
+  for (seq = head; seq != tail; seq++)
+    memcpy (priv->drain + GDV_INGEST_SLOT_SIZE * (seq - head),
+            priv->slots + GDV_INGEST_SLOT_SIZE * (seq & mask),
+            GDV_INGEST_SLOT_SIZE * sizeof (gdouble));
+
+  /* The slots are released only now. If the producer dropped samples in the
+   * meantime, the copies of these samples are discarded as well; all samples
+   * behind the new head were not overwritten. */
+  first = head;
+
+  while (!g_atomic_pointer_compare_and_exchange (&priv->head, first, tail))
+    {
+      first = g_atomic_pointer_get (&priv->head);
+
+      if (first - head >= tail - head)
+        return 0;
+    }
+
+  n_points = tail - first;
+  samples = priv->drain + GDV_INGEST_SLOT_SIZE * (first - head);
+
+  if (priv->policy == GDV_INGEST_BLOCK)
+    {
+      g_mutex_lock (&priv->lock);
+      g_cond_broadcast (&priv->drained);
+      g_mutex_unlock (&priv->lock);
+    }
+
+  if (priv->content)
+    gdv_layer_content_add_data_points (priv->content,
+                                       samples, samples + 1, samples + 2,
+                                       n_points, GDV_INGEST_SLOT_SIZE);
+
+  return n_points;
+}
+
+/**
+ * gdv_ingest_detach:
+ * @ingest: a #GdvIngest
+ *
+ * Stops appending samples to the content. Samples, that are still queued, are
+ * discarded. This function has to be called from the main thread.
+ **/
+void
+gdv_ingest_detach (GdvIngest *ingest)
+{
+  GdvIngestPrivate *priv;
+  guint tick_id;
+
+  g_return_if_fail (GDV_IS_INGEST (ingest));
+
+  priv = ingest->priv;
+
+  if (!priv->content)
+    return;
+
+  g_object_weak_unref (G_OBJECT (priv->content),
+                       _gdv_ingest_content_gone, ingest);
+
+  tick_id = priv->tick_id;
+  priv->tick_id = 0;
+
+  /* this may drop the last reference of the content on the ingest */
+  g_object_ref (ingest);
+  gtk_widget_remove_tick_callback (GTK_WIDGET (priv->content), tick_id);
+  priv->content = NULL;
+  _gdv_ingest_set_detached (priv);
+  g_object_unref (ingest);
+}
+
+/**
+ * gdv_ingest_get_content:
+ * @ingest: a #GdvIngest
+ *
+ * Returns: (transfer none) (nullable): the #GdvLayerContent, that is fed by
+ *   @ingest or %NULL, if it was detached
+ **/
+GdvLayerContent *
+gdv_ingest_get_content (GdvIngest *ingest)
+{
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), NULL);
+
+  return ingest->priv->content;
+}
+
+/**
+ * gdv_ingest_get_capacity:
+ * @ingest: a #GdvIngest
+ *
+ * Returns: the maximum number of queued samples
+ **/
+gsize
+gdv_ingest_get_capacity (GdvIngest *ingest)
+{
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), 0);
+
+  return ingest->priv->capacity;
+}
+
+/**
+ * gdv_ingest_get_policy:
+ * @ingest: a #GdvIngest
+ *
+ * Returns: the overflow-policy of @ingest
+ **/
+GdvIngestOverflow
+gdv_ingest_get_policy (GdvIngest *ingest)
+{
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), GDV_INGEST_BLOCK);
+
+  return ingest->priv->policy;
+}
+
+/**
+ * gdv_ingest_get_n_pushed:
+ * @ingest: a #GdvIngest
+ *
+ * Returns: the number of samples, that were queued so far
+ **/
+guint64
+gdv_ingest_get_n_pushed (GdvIngest *ingest)
+{
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), 0);
+
+  return g_atomic_pointer_get (&ingest->priv->n_pushed);
+}
+
+/**
+ * gdv_ingest_get_n_dropped:
+ * @ingest: a #GdvIngest
+ *
+ * Returns: the number of samples, that were lost by dropping or decimation
+ **/
+guint64
+gdv_ingest_get_n_dropped (GdvIngest *ingest)
+{
+  g_return_val_if_fail (GDV_IS_INGEST (ingest), 0);
+
+  return g_atomic_pointer_get (&ingest->priv->n_dropped);
+}
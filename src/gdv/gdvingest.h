@@ -0,0 +1,108 @@
+/*
+ * gdvingest.h
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef GDV_INGEST_H_INCLUDED
+#define GDV_INGEST_H_INCLUDED
+
+#include <stdlib.h>
+#include <gtk/gtk.h>
+
+#include "gdvlayercontent.h"
+#include "gdv-enums.h"
+
+G_BEGIN_DECLS
+
+#define GDV_TYPE_INGEST\
+  (gdv_ingest_get_type ())
+#define GDV_INGEST(obj)\
+  (G_TYPE_CHECK_INSTANCE_CAST ((obj), GDV_TYPE_INGEST, GdvIngest))
+#define GDV_IS_INGEST(obj)\
+  (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GDV_TYPE_INGEST))
+#define GDV_INGEST_CLASS(klass)\
+  (G_TYPE_CHECK_CLASS_CAST ((klass), GDV_TYPE_INGEST, GdvIngestClass))
+#define GDV_INGEST_IS_CLASS(klass)\
+  (G_TYPE_CHECK_CLASS_TYPE ((klass), GDV_TYPE_INGEST))
+#define GDV_INGEST_GET_CLASS(obj)\
+  (G_TYPE_INSTANCE_GET_CLASS ((obj), GDV_TYPE_INGEST, GdvIngestClass))
+
+typedef struct _GdvIngest GdvIngest;
+typedef struct _GdvIngestClass GdvIngestClass;
+typedef struct _GdvIngestPrivate GdvIngestPrivate;
+
+struct _GdvIngest
+{
+  GObject parent;
+
+  /*< private >*/
+  GdvIngestPrivate *priv;
+};
+
+/**
+ * GdvIngestClass:
+ * @parent_class: The ingest class structure is derived from #GObjectClass.
+ */
+struct _GdvIngestClass
+{
+  GObjectClass parent_class;
+
+  /*< private >*/
+  /* Padding to allow adding up to 12 new virtual functions without
+   * breaking ABI. */
+  gpointer _gdv_reserve[12];
+};
+
+/* Public Method definitions. */
+GType gdv_ingest_get_type (void);
+
+GdvIngest *gdv_ingest_new (GdvLayerContent   *content,
+                           gsize              capacity,
+                           GdvIngestOverflow  policy);
+
+gsize gdv_ingest_push (GdvIngest     *ingest,
+                       const gdouble *x_values,
+                       const gdouble *y_values,
+                       const gdouble *z_values,
+                       gsize          n_points,
+                       gsize          stride);
+
+gboolean gdv_ingest_push_point (GdvIngest *ingest,
+                                gdouble    x_value,
+                                gdouble    y_value,
+                                gdouble    z_value);
+
+gsize gdv_ingest_flush (GdvIngest *ingest);
+
+void gdv_ingest_detach (GdvIngest *ingest);
+
+GdvLayerContent *gdv_ingest_get_content (GdvIngest *ingest);
+
+gsize gdv_ingest_get_capacity (GdvIngest *ingest);
+
+GdvIngestOverflow gdv_ingest_get_policy (GdvIngest *ingest);
+
+guint64 gdv_ingest_get_n_pushed (GdvIngest *ingest);
+
+guint64 gdv_ingest_get_n_dropped (GdvIngest *ingest);
+
+G_END_DECLS
+
+#endif /* GDV_INGEST_H_INCLUDED */
@@ -0,0 +1,42 @@
+/* gdvlayer-private.h
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+#include "gdvlayer.h"
+
+G_BEGIN_DECLS
+
+G_GNUC_INTERNAL void _gdv_layer_add_overlay (GdvLayer  *layer,
+                                             GtkWidget *child);
+
+G_GNUC_INTERNAL void _gdv_layer_allocate_contents (
+  GdvLayer            *layer,
+  const GtkAllocation *window_rect,
+  GtkAllocation       *content_allocation);
+
+G_GNUC_INTERNAL gboolean _gdv_layer_is_updating (GdvLayer *layer);
+
+G_GNUC_INTERNAL guint _gdv_layer_get_mapping_serial (GdvLayer *layer);
+
+G_END_DECLS
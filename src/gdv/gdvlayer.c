@@ -30,9 +30,13 @@
   #include <config.h>
 #endif
 
+#include <string.h>
 #include <cairo-gobject.h>
 
 #include "gdvlayer.h"
+#include "gdvtheme-private.h"
+#include "gdvlayer-private.h"
+#include "gdvaxis-private.h"
 #include "gdvaxis.h"
 #include "gdvhair.h"
 
@@ -70,19 +74,21 @@ struct _GdvLayerPrivate
   GtkWidget *title;
   gint title_position;
 
-  /* axes */
-  GList *layer_axes;
+  /* overlay-children by type; in the order they were added */
+  GPtrArray *axes;
 /*  GHashTable *update_axes_table; */
-
-  /* data */
-  GList *layer_data;
-
-  /* TODO: this is just a feature, that may be necessary for marker-lines, etc. */
-  /* marker */
-  GList *layer_markers;
+  GPtrArray *contents;
+  GPtrArray *hairs;
 
   /* Click-events and interaction */
   GdkWindow *event_window;
+
+  /* transactions; the axes, whose notifications are frozen */
+  guint      update_depth;
+  GPtrArray *update_axes;
+
+  /* changes, whenever an axis is added or removed */
+  guint mapping_serial;
 };
 
 /* --- function declarations --- */
@@ -92,6 +98,8 @@ static void
 gdv_layer_finalize (GObject *object);
 static void gdv_layer_add  (GtkContainer   *container,
                             GtkWidget      *child);
+static void gdv_layer_remove (GtkContainer   *container,
+                              GtkWidget      *child);
 static GtkWidgetPath *
 gdv_layer_get_path_for_child (GtkContainer *container,
                               GtkWidget    *child);
@@ -131,6 +139,17 @@ gdv_layer_eval_inner_point_unimplemented (GdvLayer      *layer,
     guint point_1_x, guint point_1_y,
     guint point_2_x, guint point_2_y);
 
+static void
+gdv_layer_real_evaluate_data_points (GdvLayer      *layer,
+                                     const gdouble *x_values,
+                                     const gdouble *y_values,
+                                     const gdouble *z_values,
+                                     gsize          n_points,
+                                     gsize          stride,
+                                     gdouble       *pos_x,
+                                     gdouble       *pos_y,
+                                     guint8        *in_range);
+
 G_DEFINE_TYPE_WITH_CODE (GdvLayer,
                          gdv_layer,
                          GTK_TYPE_OVERLAY,
@@ -163,10 +182,12 @@ gdv_layer_class_init (GdvLayerClass *klass)
     gdv_layer_get_preferred_width_for_height;
 
   container_class->add = gdv_layer_add;
+  container_class->remove = gdv_layer_remove;
   container_class->get_path_for_child = gdv_layer_get_path_for_child;
 
   klass->evaluate_point = gdv_layer_evaluate_data_point_unimplemented;
   klass->eval_inner_point = gdv_layer_eval_inner_point_unimplemented;
+  klass->evaluate_points = gdv_layer_real_evaluate_data_points;
 
   /* Properties */
 
@@ -180,7 +201,6 @@ gdv_layer_init (GdvLayer *layer)
 {
   GtkWidget *widget = GTK_WIDGET (layer);
 
-  GtkCssProvider *css_provider;
   GtkStyleContext *style_context;
 
   layer->priv = gdv_layer_get_instance_private (layer);
@@ -195,22 +215,61 @@ gdv_layer_init (GdvLayer *layer)
 
   layer->priv->event_window = NULL;
 
-  layer->priv->layer_data = NULL;
-  layer->priv->layer_axes = NULL;
+  layer->priv->update_depth = 0;
+  layer->priv->update_axes = NULL;
+
+  layer->priv->mapping_serial = 0;
+
+  layer->priv->axes = g_ptr_array_new ();
+  layer->priv->contents = g_ptr_array_new ();
+  layer->priv->hairs = g_ptr_array_new ();
 
 /*  layer->priv->update_axes_table =
     g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
 */
-  css_provider = gtk_css_provider_new ();
   style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
+  _gdv_theme_add_to_context (style_context);
+}
 
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+/* Gives the array, that keeps track of children of the type of child */
+static GPtrArray *
+_gdv_layer_get_child_array (GdvLayer *layer, GtkWidget *child)
+{
+  if (GDV_IS_AXIS (child))
+    return layer->priv->axes;
+  else if (GDV_LAYER_IS_CONTENT (child))
+    return layer->priv->contents;
+  else if (GDV_IS_HAIR (child))
+    return layer->priv->hairs;
+
+  return NULL;
+}
+
+/*
+ * _gdv_layer_add_overlay:
+ * @layer: a #GdvLayer
+ * @child: an axis, a content or a hair
+ *
+ * Adds @child as an overlay, like gtk_overlay_add_overlay() does, but also
+ * keeps track of it in the typed child arrays. Derived layers must use this
+ * instead of gtk_overlay_add_overlay().
+ */
+void
+_gdv_layer_add_overlay (GdvLayer *layer, GtkWidget *child)
+{
+  GPtrArray *array;
+
+  g_return_if_fail (GDV_IS_LAYER (layer));
+  g_return_if_fail (GTK_IS_WIDGET (child));
+
+  array = _gdv_layer_get_child_array (layer, child);
+  g_return_if_fail (array != NULL);
+
+  gtk_overlay_add_overlay (GTK_OVERLAY (layer), child);
+  g_ptr_array_add (array, child);
+
+  if (array == layer->priv->axes)
+    layer->priv->mapping_serial++;
 }
 
 static void gdv_layer_add (GtkContainer   *container,
@@ -221,7 +280,7 @@ static void gdv_layer_add (GtkContainer   *container,
       GDV_LAYER_IS_CONTENT (child) ||
       GDV_IS_HAIR (child))
   {
-    gtk_overlay_add_overlay (GTK_OVERLAY (container), child);
+    _gdv_layer_add_overlay (GDV_LAYER (container), child);
 
     /* FIXME: shure this is a good idea? */
     if (gtk_widget_get_visible (GTK_WIDGET (container)))
@@ -250,27 +309,108 @@ static void gdv_layer_add (GtkContainer   *container,
     GTK_CONTAINER_CLASS (gdv_layer_parent_class)->add (container, child);
 }
 
+/* Allocates all children of array; see _gdv_layer_allocate_contents() */
+static void
+_gdv_layer_allocate_group (GdvLayer            *layer,
+                           GPtrArray           *array,
+                           const GtkAllocation *window_rect,
+                           GtkAllocation       *content_allocation)
+{
+  GdkWindow *layer_window = gtk_widget_get_window (GTK_WIDGET (layer));
+  guint i;
+
+  for (i = 0; i < array->len; i++)
+  {
+    GtkWidget *child = g_ptr_array_index (array, i);
+    GdkWindow *window;
+    gint window_x, window_y;
+
+    if (!gtk_widget_get_realized (child))
+      continue;
+
+    /* the overlay keeps a window for every child; all of them cover the
+     * whole layer, so they only have to follow, when the layer moves */
+    window = gtk_widget_get_window (child);
+
+    if (window && window != layer_window)
+    {
+      gdk_window_get_position (window, &window_x, &window_y);
+
+      if (window_x != window_rect->x ||
+          window_y != window_rect->y ||
+          gdk_window_get_width (window) != window_rect->width ||
+          gdk_window_get_height (window) != window_rect->height)
+        gdk_window_move_resize (window,
+                                window_rect->x, window_rect->y,
+                                window_rect->width, window_rect->height);
+    }
+
+    gtk_widget_size_allocate (child, content_allocation);
+  }
+}
+
+/*
+ * _gdv_layer_allocate_contents:
+ * @layer: a #GdvLayer
+ * @window_rect: the area of the layer within its parent-window
+ * @content_allocation: the inner plot-area, that is shared by all contents
+ *
+ * Allocates all contents and hairs of @layer with the same rectangle. Unlike
+ * the overlay, this neither measures the children nor moves their windows,
+ * as long as the layer does not move.
+ */
+void
+_gdv_layer_allocate_contents (GdvLayer            *layer,
+                              const GtkAllocation *window_rect,
+                              GtkAllocation       *content_allocation)
+{
+  g_return_if_fail (GDV_IS_LAYER (layer));
+
+  _gdv_layer_allocate_group (layer, layer->priv->contents,
+                             window_rect, content_allocation);
+  _gdv_layer_allocate_group (layer, layer->priv->hairs,
+                             window_rect, content_allocation);
+}
+
+static void gdv_layer_remove (GtkContainer   *container,
+                              GtkWidget      *child)
+{
+  GPtrArray *array;
+
+  array = _gdv_layer_get_child_array (GDV_LAYER (container), child);
+
+  if (array)
+    g_ptr_array_remove (array, child);
+
+  if (array == GDV_LAYER (container)->priv->axes)
+    GDV_LAYER (container)->priv->mapping_serial++;
+
+  GTK_CONTAINER_CLASS (gdv_layer_parent_class)->remove (container, child);
+}
+
 static gboolean find_determine_child_in_list (GtkWidget *child,
-                                              GList *child_list,
+                                              GPtrArray *child_array,
                                               GtkWidgetPath * sibling_path,
                                               gint * position)
 {
-  GList *list;
+  guint i;
 //  gint offset = 0;
   gboolean found = FALSE;
 
-  for (list = child_list; list; list = list->next)
+  for (i = 0; i < child_array->len; i++)
   {
-    if (!gtk_widget_get_visible (list->data))
+    GtkWidget *sibling = g_ptr_array_index (child_array, i);
+
+    if (!gtk_widget_get_visible (sibling))
       continue;
 
-    if (list->data == child)
+    if (sibling == child)
       found = TRUE;
 
     if (!found && position)
       (*position)++;
 
-    gtk_widget_path_append_for_widget (sibling_path, list->data);
+    gtk_widget_path_append_for_widget (sibling_path, sibling);
   }
 
 //  if (position)
@@ -289,8 +429,6 @@ gdv_layer_get_path_for_child (GtkContainer *container,
                               GtkWidget    *child)
 {
   GtkWidgetPath *path, *sibling_path;
-  GList *data_list, *axes_list, *marker_list;
-
   GtkWidget *widget = GTK_WIDGET (container);
   GdvLayer *layer = GDV_LAYER (container);
 
@@ -336,25 +474,19 @@ gdv_layer_get_path_for_child (GtkContainer *container,
     sibling_path = gtk_widget_path_new ();
 
     /* First search within the layer-content */
-    data_list = gdv_layer_get_content_list (layer);
-    found = find_determine_child_in_list (child, data_list,
+    found = find_determine_child_in_list (child, layer->priv->contents,
                                           sibling_path,
                                           &position);
-    g_list_free (data_list);
 
     /* Then search within the layer-axes */
-    axes_list = gdv_layer_get_axis_list(layer);
-    found |= find_determine_child_in_list (child, axes_list,
+    found |= find_determine_child_in_list (child, layer->priv->axes,
                                            sibling_path,
                                            found ? NULL : &position);
-    g_list_free (axes_list);
 
     /* Finally search within the markers */
-    marker_list = gdv_layer_get_hair_list (layer);
-    found |= find_determine_child_in_list (child, marker_list,
+    found |= find_determine_child_in_list (child, layer->priv->hairs,
                                            sibling_path,
                                            found ? NULL : &position);
-    g_list_free (marker_list);
 
     if (found)
       gtk_widget_path_append_with_siblings (path, sibling_path, position);
@@ -373,6 +505,20 @@ gdv_layer_get_path_for_child (GtkContainer *container,
 static void
 gdv_layer_dispose (GObject *object)
 {
+  GdvLayer *layer = GDV_LAYER (object);
+
+  /* an open transaction must not keep the axes frozen */
+  if (layer->priv->update_axes)
+  {
+    guint i;
+
+    for (i = 0; i < layer->priv->update_axes->len; i++)
+      g_object_thaw_notify (g_ptr_array_index (layer->priv->update_axes, i));
+
+    g_clear_pointer (&layer->priv->update_axes, g_ptr_array_unref);
+    layer->priv->update_depth = 0;
+    g_object_thaw_notify (object);
+  }
 
   G_OBJECT_CLASS (gdv_layer_parent_class)->dispose (object);
 }
@@ -380,6 +526,12 @@ gdv_layer_dispose (GObject *object)
 static void
 gdv_layer_finalize (GObject *object)
 {
+  GdvLayerPrivate *priv = GDV_LAYER (object)->priv;
+
+  g_ptr_array_unref (priv->axes);
+  g_ptr_array_unref (priv->contents);
+  g_ptr_array_unref (priv->hairs);
+
   G_OBJECT_CLASS (gdv_layer_parent_class)->finalize (object);
 }
 
@@ -412,6 +564,41 @@ gdv_layer_draw (GtkWidget *widget,
   return GTK_WIDGET_CLASS (gdv_layer_parent_class)->draw (widget, cr);
 }
 
+/* Adds the preferred size of a visible child */
+static void
+_gdv_layer_measure_child (GtkWidget      *child,
+                          GtkOrientation  orientation,
+                          int             for_size,
+                          int            *minimum,
+                          int            *natural)
+{
+  int data_min = 0,
+      data_nat = 0;
+
+  if (!gtk_widget_get_visible (child))
+    return;
+
+  if (orientation == GTK_ORIENTATION_HORIZONTAL)
+  {
+    if (for_size > 0)
+      gtk_widget_get_preferred_width_for_height (child, for_size,
+                                                 &data_min, &data_nat);
+    else
+      gtk_widget_get_preferred_width (child, &data_min, &data_nat);
+  }
+  else
+  {
+    if (for_size > 0)
+      gtk_widget_get_preferred_height_for_width (child, for_size,
+                                                 &data_min, &data_nat);
+    else
+      gtk_widget_get_preferred_height (child, &data_min, &data_nat);
+  }
+
+  *minimum += data_min;
+  *natural += data_nat;
+}
+
 static void
 gdv_layer_measure (
   GdvLayer            *layer,
@@ -423,72 +610,30 @@ gdv_layer_measure (
   int                 *natural_baseline,
   gpointer             data)
 {
-  GList *child_list, *child_list_copy;
+  GtkWidget *main_widget;
   int global_content_minimum = 0,
       global_content_natural = 0;
-  guint border_width;
+  guint border_width, i;
 
   *minimum = 0;
   *natural = 0;
 
   border_width = gtk_container_get_border_width (GTK_CONTAINER (layer));
 
-  child_list = gtk_container_get_children(GTK_CONTAINER (layer));
-  child_list_copy = child_list;
+  /* contents and hairs always take the space, that is left by the axes;
+   * so they do not take part in the measurement */
+  main_widget = gtk_bin_get_child (GTK_BIN (layer));
 
-  while (child_list_copy)
-  {
-    int data_min = 0,
-        data_nat = 0;
+  if (main_widget)
+    _gdv_layer_measure_child (main_widget, orientation, for_size,
+                              &global_content_minimum,
+                              &global_content_natural);
 
-    if (child_list_copy->data &&
-        gtk_widget_get_visible (child_list_copy->data))
-    {
-      if (orientation == GTK_ORIENTATION_HORIZONTAL)
-      {
-        if (for_size > 0)
-        {
-          gtk_widget_get_preferred_width_for_height (
-            child_list_copy->data,
-            for_size,
-            &data_min,
-            &data_nat);
-        }
-        else
-        {
-          gtk_widget_get_preferred_width (
-            child_list_copy->data,
-            &data_min,
-            &data_nat);
-        }
-      }
-      else
-      {
-        if (for_size > 0)
-        {
-          gtk_widget_get_preferred_height_for_width (
-            child_list_copy->data,
-            for_size,
-            &data_min,
-            &data_nat);
-        }
-        else
-        {
-          gtk_widget_get_preferred_height (
-            child_list_copy->data,
-            &data_min,
-            &data_nat);
-        } /* orientation == GTK_ORIENTATION_VERTICAL */
-      }
-    }
-
-    global_content_minimum += data_min;
-    global_content_natural += data_nat;
-
-    child_list_copy = child_list_copy->next;
-  }
-
-  g_list_free (child_list);
+  for (i = 0; i < layer->priv->axes->len; i++)
+    _gdv_layer_measure_child (g_ptr_array_index (layer->priv->axes, i),
+                              orientation, for_size,
+                              &global_content_minimum,
+                              &global_content_natural);
 
   *minimum += global_content_minimum;
   *natural += global_content_natural;
@@ -549,10 +694,13 @@ static gboolean
 gdv_layer_real_has_layer_content (GdvLayer *layer,
                                   GdvLayerContent *layer_content)
 {
-  if (g_list_find (layer->priv->layer_data, layer_content))
-    return TRUE;
-  else
-    return FALSE;
+  guint i;
+
+  for (i = 0; i < layer->priv->contents->len; i++)
+    if (g_ptr_array_index (layer->priv->contents, i) == layer_content)
+      return TRUE;
+
+  return FALSE;
 }
 
 /**
@@ -608,6 +756,89 @@ gboolean gdv_layer_evaluate_data_point(GdvLayer *layer,
     return FALSE;
 }
 
+/**
+ * gdv_layer_evaluate_data_points: (skip)
+ * @layer: a #GdvLayer
+ * @x_values: (nullable): the x coordinates of the points
+ * @y_values: (nullable): the y coordinates of the points
+ * @z_values: (nullable): the z coordinates of the points
+ * @n_points: the number of points to evaluate
+ * @stride: the distance between two consecutive values in the input arrays,
+ *    in units of #gdouble
+ * @pos_x: the place to store the @n_points x-positions on screen
+ * @pos_y: the place to store the @n_points y-positions on screen
+ * @in_range: (nullable): a bitmask of at least (@n_points + 7) / 8 bytes
+ *
+ * Calculates the positions of a whole array of data-points within the
+ * allocated space of a layer-instance in pixel units. The result is the same
+ * as calling gdv_layer_evaluate_data_point() for every single point, but
+ * the layer is able to resolve its axes only once.
+ *
+ * Bit (i & 7) of byte (i >> 3) of @in_range is set, if the i-th point is
+ * within the range of the layer-axes and cleared otherwise. Missing input
+ * arrays are treated as zeros.
+ **/
+void
+gdv_layer_evaluate_data_points (GdvLayer      *layer,
+                                const gdouble *x_values,
+                                const gdouble *y_values,
+                                const gdouble *z_values,
+                                gsize          n_points,
+                                gsize          stride,
+                                gdouble       *pos_x,
+                                gdouble       *pos_y,
+                                guint8        *in_range)
+{
+  g_return_if_fail (GDV_IS_LAYER (layer));
+  g_return_if_fail (pos_x != NULL && pos_y != NULL);
+  g_return_if_fail (stride > 0);
+
+  if (n_points == 0)
+    return;
+
+  if (GDV_LAYER_GET_CLASS (layer)->evaluate_points != NULL)
+    GDV_LAYER_GET_CLASS (layer)->evaluate_points (
+      layer, x_values, y_values, z_values, n_points, stride,
+      pos_x, pos_y, in_range);
+  else
+    gdv_layer_real_evaluate_data_points (
+      layer, x_values, y_values, z_values, n_points, stride,
+      pos_x, pos_y, in_range);
+}
+
+static void
+gdv_layer_real_evaluate_data_points (GdvLayer      *layer,
+                                     const gdouble *x_values,
+                                     const gdouble *y_values,
+                                     const gdouble *z_values,
+                                     gsize          n_points,
+                                     gsize          stride,
+                                     gdouble       *pos_x,
+                                     gdouble       *pos_y,
+                                     guint8        *in_range)
+{
+  gsize i;
+
+  if (in_range)
+    memset (in_range, 0, (n_points + 7) / 8);
+
+  for (i = 0; i < n_points; i++)
+  {
+    gboolean on_layer;
+
+    on_layer = gdv_layer_evaluate_data_point (
+                 layer,
+                 x_values ? x_values[i * stride] : 0.0,
+                 y_values ? y_values[i * stride] : 0.0,
+                 z_values ? z_values[i * stride] : 0.0,
+                 &pos_x[i],
+                 &pos_y[i]);
+
+    if (in_range && on_layer)
+      in_range[i >> 3] |= 1 << (i & 7);
+  }
+}
+
 static gboolean
 gdv_layer_evaluate_data_point_unimplemented (GdvLayer *layer,
     gdouble             x_value,
@@ -631,100 +862,246 @@ gdv_layer_eval_inner_point_unimplemented (GdvLayer      *layer,
   return TRUE;
 }
 
-/* TODO: I dont like this solution; elements should be filtered, not reallocated */
+/* Copies a typed child array into a newly allocated list */
+static GList *
+_gdv_layer_list_from_array (GPtrArray *array)
+{
+  GList *return_list = NULL;
+  guint i;
+
+  for (i = array->len; i > 0; i--)
+    return_list = g_list_prepend (return_list, g_ptr_array_index (array, i - 1));
+
+  return return_list;
+}
+
 /**
  * gdv_layer_get_content_list:
  * @layer: a #GdvLayer
  *
- * Lists #GdvLayerContent instances that are used by the @layer.
+ * Lists #GdvLayerContent instances that are used by the @layer. See
+ * gdv_layer_peek_contents() for a variant, that does not allocate.
  *
  * Returns: (element-type GdvLayerContent) (transfer container): a newly
  *    allocated #GList of contents.
  */
 GList *gdv_layer_get_content_list (GdvLayer *layer)
 {
-  GList *children, *list_copy;
-  GList *return_list = NULL;
-
   g_return_val_if_fail (GDV_IS_LAYER (layer), NULL);
 
-  children = gtk_container_get_children (GTK_CONTAINER (layer));
-  list_copy = children;
-
-  while (list_copy)
-  {
-    if (GDV_LAYER_IS_CONTENT (list_copy->data))
-      return_list = g_list_append (return_list, list_copy->data);
-
-    list_copy = list_copy->next;
-  }
-
-  g_list_free (children);
-
-  return return_list;
+  return _gdv_layer_list_from_array (layer->priv->contents);
 }
 
-/* TODO: see gdv_layer_get_content_list */
 /**
  * gdv_layer_get_axis_list:
  * @layer: a #GdvLayer
  *
- * Lists #GdvAxis instances that are used by the @layer.
+ * Lists #GdvAxis instances that are used by the @layer. See
+ * gdv_layer_peek_axes() for a variant, that does not allocate.
  *
  * Returns: (transfer container) (element-type GdvAxis):
  *     a newly allocated #GList of axes
  */
 GList *gdv_layer_get_axis_list (GdvLayer *layer)
 {
-  GList *children, *list_copy;
-  GList *return_list = NULL;
-
   g_return_val_if_fail (GDV_IS_LAYER (layer), NULL);
 
-  children = gtk_container_get_children (GTK_CONTAINER (layer));
-  list_copy = children;
-
-  while (list_copy)
-  {
-    if (GDV_IS_AXIS (list_copy->data))
-      return_list = g_list_append (return_list, list_copy->data);
-
-    list_copy = list_copy->next;
-  }
-
-  g_list_free (children);
-
-  return return_list;
+  return _gdv_layer_list_from_array (layer->priv->axes);
 }
 
 /**
  * gdv_layer_get_hair_list:
  * @layer: a #GdvLayer
  *
- * Lists #GdvHair instances that are used by the @layer.
+ * Lists #GdvHair instances that are used by the @layer. See
+ * gdv_layer_peek_hairs() for a variant, that does not allocate.
  *
  * Returns: (transfer container) (element-type GdvHair):
  *     a newly allocated #GList of markers
  */
 GList *gdv_layer_get_hair_list (GdvLayer *layer)
 {
-  GList *children, *list_copy;
-  GList *return_list = NULL;
+  g_return_val_if_fail (GDV_IS_LAYER (layer), NULL);
 
+  return _gdv_layer_list_from_array (layer->priv->hairs);
+}
+
+/**
+ * gdv_layer_peek_contents:
+ * @layer: a #GdvLayer
+ * @n_contents: (out): the place to store the number of contents
+ *
+ * Gives the #GdvLayerContent instances of the @layer in the order they were
+ * added. The array is owned by the @layer and only valid until the next
+ * content is added or removed.
+ *
+ * Returns: (array length=n_contents) (transfer none): the contents
+ */
+GdvLayerContent **gdv_layer_peek_contents (GdvLayer *layer, guint *n_contents)
+{
+  g_return_val_if_fail (GDV_IS_LAYER (layer), NULL);
+  g_return_val_if_fail (n_contents != NULL, NULL);
+
+  *n_contents = layer->priv->contents->len;
+
+  return (GdvLayerContent **) layer->priv->contents->pdata;
+}
+
+/**
+ * gdv_layer_peek_axes:
+ * @layer: a #GdvLayer
+ * @n_axes: (out): the place to store the number of axes
+ *
+ * Gives the #GdvAxis instances of the @layer in the order they were added.
+ * The array is owned by the @layer and only valid until the next axis is
+ * added or removed.
+ *
+ * Returns: (array length=n_axes) (transfer none): the axes
+ */
+GdvAxis **gdv_layer_peek_axes (GdvLayer *layer, guint *n_axes)
+{
   g_return_val_if_fail (GDV_IS_LAYER (layer), NULL);
+  g_return_val_if_fail (n_axes != NULL, NULL);
+
+  *n_axes = layer->priv->axes->len;
 
-  children = gtk_container_get_children (GTK_CONTAINER (layer));
-  list_copy = children;
+  return (GdvAxis **) layer->priv->axes->pdata;
+}
 
-  while (list_copy)
+/**
+ * gdv_layer_peek_hairs:
+ * @layer: a #GdvLayer
+ * @n_hairs: (out): the place to store the number of hairs
+ *
+ * Gives the #GdvHair instances of the @layer in the order they were added.
+ * The array is owned by the @layer and only valid until the next hair is
+ * added or removed.
+ *
+ * Returns: (array length=n_hairs) (transfer none): the hairs
+ */
+GdvHair **gdv_layer_peek_hairs (GdvLayer *layer, guint *n_hairs)
+{
+  g_return_val_if_fail (GDV_IS_LAYER (layer), NULL);
+  g_return_val_if_fail (n_hairs != NULL, NULL);
+
+  *n_hairs = layer->priv->hairs->len;
+
+  return (GdvHair **) layer->priv->hairs->pdata;
+}
+
+/**
+ * gdv_layer_begin_update:
+ * @layer: a #GdvLayer
+ *
+ * Starts a transaction on @layer. Until the matching gdv_layer_end_update(),
+ * property-notifications of the layer and its axes are held back and changes
+ * of the axes do not queue any allocation. Transactions may be nested; only
+ * the outermost one takes effect.
+ *
+ * This is useful to change several properties at once, e.g. the ranges of
+ * all axes, at the cost of a single layout and redraw.
+ */
+void gdv_layer_begin_update (GdvLayer *layer)
+{
+  GdvLayerPrivate *priv;
+  guint i;
+
+  g_return_if_fail (GDV_IS_LAYER (layer));
+
+  priv = layer->priv;
+
+  if (priv->update_depth++ > 0)
+    return;
+
+  g_object_freeze_notify (G_OBJECT (layer));
+
+  /* the axes are kept, since they may be removed during the transaction */
+  priv->update_axes = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < priv->axes->len; i++)
   {
-    if (GDV_IS_HAIR (list_copy->data))
-      return_list = g_list_append (return_list, list_copy->data);
+    GObject *axis = g_ptr_array_index (priv->axes, i);
 
-    list_copy = list_copy->next;
+    g_object_freeze_notify (axis);
+    g_ptr_array_add (priv->update_axes, g_object_ref (axis));
   }
+}
 
-  g_list_free (children);
+/**
+ * gdv_layer_end_update:
+ * @layer: a #GdvLayer
+ *
+ * Ends a transaction, that was started by gdv_layer_begin_update(). All
+ * axes, that changed meanwhile, are allocated again together with the
+ * @layer and the held back notifications are emitted.
+ */
+void gdv_layer_end_update (GdvLayer *layer)
+{
+  GdvLayerPrivate *priv;
+  GPtrArray *update_axes;
+  gboolean changed = FALSE;
+  guint i;
 
-  return return_list;
+  g_return_if_fail (GDV_IS_LAYER (layer));
+
+  priv = layer->priv;
+
+  g_return_if_fail (priv->update_depth > 0);
+
+  if (--priv->update_depth > 0)
+    return;
+
+  update_axes = priv->update_axes;
+  priv->update_axes = NULL;
+
+  /* axes, that were removed during the transaction, still hold back their
+   * allocation; axes, that were added, may hold it back as well */
+  for (i = 0; i < update_axes->len; i++)
+    changed |= _gdv_axis_flush_allocate (g_ptr_array_index (update_axes, i));
+
+  for (i = 0; i < priv->axes->len; i++)
+    changed |= _gdv_axis_flush_allocate (g_ptr_array_index (priv->axes, i));
+
+  if (changed)
+  {
+    gtk_widget_queue_allocate (GTK_WIDGET (layer));
+    gtk_widget_queue_draw (GTK_WIDGET (layer));
+  }
+
+  for (i = 0; i < update_axes->len; i++)
+    g_object_thaw_notify (g_ptr_array_index (update_axes, i));
+
+  g_ptr_array_unref (update_axes);
+
+  g_object_thaw_notify (G_OBJECT (layer));
+}
+
+/*
+ * _gdv_layer_get_mapping_serial:
+ * @layer: a #GdvLayer
+ *
+ * Gives a number, that changes whenever an axis is added to or removed from
+ * @layer. Together with the serials of the axes, it tells, whether data
+ * mapped by @layer earlier is still valid; a new axis may well be allocated
+ * at the address of a removed one.
+ *
+ * Returns: the serial of the mapping of @layer
+ */
+guint
+_gdv_layer_get_mapping_serial (GdvLayer *layer)
+{
+  return layer->priv->mapping_serial;
+}
+
+/*
+ * _gdv_layer_is_updating:
+ * @layer: a #GdvLayer
+ *
+ * Returns: %TRUE, if @layer is within a transaction and the axes should
+ *     defer their allocation until it ends
+ */
+gboolean
+_gdv_layer_is_updating (GdvLayer *layer)
+{
+  return layer->priv->update_depth > 0;
 }
@@ -26,6 +26,8 @@
 #include <stdlib.h>
 #include <gtk/gtk.h>
 
+#include "gdvaxis.h"
+#include "gdvhair.h"
 #include "gdvlayercontent.h"
 
 G_BEGIN_DECLS
@@ -63,6 +65,10 @@ struct _GdvLayer
  * @eval_inner_point: Method to evaluate if a point on screen is more central
  *   with respect to the layer than another one. This is used by #GdvTic to know where
  *   to plot the outside- and inside-length.
+ * @evaluate_points: Batched version of @evaluate_point that maps @n_points
+ *   samples in one call. Bit i of @in_range (bit i & 7 of byte i >> 3) is set
+ *   for every point that is within the range of the layer-axes. The default
+ *   implementation calls @evaluate_point for every single point.
  */
 struct _GdvLayerClass
 {
@@ -80,11 +86,21 @@ struct _GdvLayerClass
                                     guint point_1_x, guint point_1_y,
                                     guint point_2_x, guint point_2_y);
 
+  void     (*evaluate_points)      (GdvLayer      *layer,
+                                    const gdouble *x_values,
+                                    const gdouble *y_values,
+                                    const gdouble *z_values,
+                                    gsize          n_points,
+                                    gsize          stride,
+                                    gdouble       *pos_x,
+                                    gdouble       *pos_y,
+                                    guint8        *in_range);
+
   /*< private >*/
 
-  /* Padding to allow adding up to 12 new virtual functions without
+  /* Padding to allow adding up to 11 new virtual functions without
    * breaking ABI. */
-  gpointer _gdv_reserve[12];
+  gpointer _gdv_reserve[11];
 };
 
 /* Public Method definitions. */
@@ -101,12 +117,32 @@ gboolean gdv_layer_evaluate_data_point(GdvLayer *layer,
                                        gdouble *pos_x,
                                        gdouble *pos_y);
 
+void gdv_layer_evaluate_data_points (GdvLayer      *layer,
+                                     const gdouble *x_values,
+                                     const gdouble *y_values,
+                                     const gdouble *z_values,
+                                     gsize          n_points,
+                                     gsize          stride,
+                                     gdouble       *pos_x,
+                                     gdouble       *pos_y,
+                                     guint8        *in_range);
+
 GList *gdv_layer_get_content_list (GdvLayer *layer);
 
 GList *gdv_layer_get_axis_list (GdvLayer *layer);
 
 GList *gdv_layer_get_hair_list (GdvLayer *layer);
 
+GdvLayerContent **gdv_layer_peek_contents (GdvLayer *layer, guint *n_contents);
+
+GdvAxis **gdv_layer_peek_axes (GdvLayer *layer, guint *n_axes);
+
+GdvHair **gdv_layer_peek_hairs (GdvLayer *layer, guint *n_hairs);
+
+void gdv_layer_begin_update (GdvLayer *layer);
+
+void gdv_layer_end_update (GdvLayer *layer);
+
 G_END_DECLS
 
 #endif /* GDV_LAYER_H_INCLUDED */
@@ -25,12 +25,20 @@
 #endif
 
 #include <math.h>
+#include <string.h>
 
 #include "gdvlayercontent.h"
+#include "gdvtheme-private.h"
 #include "gdvlayer.h"
+#include "gdvtwodlayer.h"
 #include "gdvrender.h"
 #include "gdv-data-boxed.h"
+#include "gdv-enums.h"
 #include "gdvaxis-private.h"
+#include "gdvlayer-private.h"
+#include "gdvmarker-private.h"
+#include "gdvrender-private.h"
+#include "gdvtilerender-private.h"
 
 /**
  * SECTION:gdvlayercontent
@@ -40,8 +48,76 @@
  * #GdvLayerContent is a object-class, thats intention is to basically contain
  * all the information, that will be plotted in a single data-series of a plot.
  *
+ * The data is stored column-wise: every dimension of the data-series is kept
+ * in its own contiguous array and the capacity of these arrays grows
+ * geometrically. Appending a single data-point is therefore cheap, even for
+ * very long series. If the final size of a series is known in advance,
+ * gdv_layer_content_reserve() avoids any reallocation at all.
+ *
+ * For live-monitoring, the content can be limited to a sliding window by
+ * setting #GdvLayerContent:max-points or #GdvLayerContent:window-span. The
+ * storage then works as a circular buffer, that overwrites the oldest
+ * data-points, while the bounds of the content are kept up to date in
+ * constant amortized time.
+ *
+ * Very long time-series can enable #GdvLayerContent:level-of-detail. The
+ * content then maintains a pyramid of min/max-buckets along the y-values,
+ * that is updated on every append. While drawing within a #GdvTwodLayer,
+ * only the first, minimum, maximum and last data-point of each pixel-column
+ * is plotted; the extremes of a column are combined from the largest buckets,
+ * that fit into it. This keeps the envelope of the plot intact, however the
+ * data-points are spaced, while the drawing-costs depend on the width of the
+ * plot instead of the number of data-points.
+ *
+ * As long as the x-values of a content within a #GdvTwodLayer are not
+ * decreasing, only the data-points within the visible part of the layer (and
+ * their direct neighbours) are drawn. They are found by a binary search, so
+ * zooming into a long series is cheap.
+ *
+ * Every content renders into an offscreen surface of its own. As long as
+ * neither the data nor the style or the axes change, drawing the content
+ * just copies this surface. Appended data-points are drawn onto the existing
+ * surface, without rendering the older ones again. Within a #GdvTwodLayer in
+ * strip-chart mode, the surface is also kept, while the x-scale scrolls; it
+ * is moved by whole pixels and only the uncovered columns are rendered.
+ *
+ * With #GdvLayerContent:threaded-rendering, a content with very many visible
+ * data-points is rendered in tiles on several worker-threads. The previous
+ * image stays on screen, until all tiles are done; if the axes or the data
+ * change meanwhile, the pending rendering is dropped.
+ *
+ * Scatter-plots with more data-points than pixels can be drawn with
+ * #GdvLayerContent:render-mode set to %GDV_RENDER_MODE_DENSITY. The
+ * data-points are then counted per block of pixels and every block is
+ * painted in the point-color, with an opacity that depends on its count.
+ * This shows, where the data-points pile up, at costs, that hardly depend on
+ * their number. Appended data-points are added to the existing counts.
  */
 
+/* the minimum capacity that will be allocated for a new column-storage */
+#define GDV_LAYER_CONTENT_MIN_CAPACITY 64
+/* the number of columns, every layer-content provides (x, y and z) */
+#define GDV_LAYER_CONTENT_MIN_COLUMNS 3
+/* the finest level-of-detail collects 2^3 samples per bucket, every further
+ * level 2^2 times as many as the previous one */
+#define GDV_LAYER_CONTENT_LOD_BASE_SHIFT 3
+#define GDV_LAYER_CONTENT_LOD_LEVEL_SHIFT 2
+#define GDV_LAYER_CONTENT_LOD_LEVELS 10
+/* below this number of samples, the visible range is not searched for */
+#define GDV_LAYER_CONTENT_SEARCH_MIN 64
+/* in strip-chart mode, the pixels this far left of the last rendered sample
+ * are drawn again together with the appended ones; this covers the join of
+ * the line and the point-symbol around the sample */
+#define GDV_LAYER_CONTENT_STRIP_MARGIN 4.0
+/* translations of the axes, that differ by less pixels, are the same */
+#define GDV_LAYER_CONTENT_STRIP_TOLERANCE 1e-6
+/* with threaded rendering, less visible samples are still rendered directly */
+#define GDV_LAYER_CONTENT_THREADED_MIN 100000
+/* in density-mode, the blocks with the lowest count keep this opacity */
+#define GDV_LAYER_CONTENT_DENSITY_MIN_ALPHA 0.15
+/* the number of entries of the color-table of the density-mode */
+#define GDV_LAYER_CONTENT_DENSITY_LEVELS 256
+
 /* Define Properties */
 enum
 {
@@ -60,11 +136,78 @@ enum
   PROP_FILL_BELOW,
   PROP_FILL_ABOVE,
 
+  PROP_MAX_POINTS,
+  PROP_WINDOW_SPAN,
+
+  PROP_LEVEL_OF_DETAIL,
+  PROP_THREADED_RENDERING,
+
+  PROP_RENDER_MODE,
+  PROP_DENSITY_BLOCK_SIZE,
+  PROP_DENSITY_SCALE,
+
   N_PROPERTIES
 };
 
 static GParamSpec *layer_content_properties[N_PROPERTIES] = { NULL, };
 
+/* A double-ended queue of sample sequence-numbers, used to track the minimum
+ * or maximum of a sliding window */
+typedef struct
+{
+  guint64 *items;
+  gsize capacity;
+  gsize head;
+  gsize length;
+} GdvSeqDeque;
+
+/* The extreme y-values of a bucket of samples of the level-of-detail pyramid
+ * together with their sequence-numbers */
+typedef struct
+{
+  gdouble min;
+  gdouble max;
+  guint64 min_seq;
+  guint64 max_seq;
+} GdvLodBucket;
+
+/* One level of the pyramid; a circular buffer of buckets, where first is the
+ * number of the oldest bucket */
+typedef struct
+{
+  GdvLodBucket *buckets;
+  gsize capacity;
+  gsize head;
+  gsize length;
+  guint64 first;
+} GdvLodLevel;
+
+/* One entry of the key of the offscreen-surface; the layer and each of its
+ * axes add their object and a serial, that changes with their mapping */
+typedef struct
+{
+  gpointer object;
+  guint serial;
+  gboolean visible;
+} GdvLayerContentKeyEntry;
+
+/* The state of the offscreen-surface, once a job on the worker-threads is
+ * done; see _gdv_layer_content_update_cache() for the members */
+typedef struct
+{
+  GArray *key;
+  GtkAllocation allocation;
+  gint scale;
+  gboolean strip_chart;
+  guint64 head_seq;
+  guint64 end_seq;
+  gboolean continuable;
+  gboolean has_last;
+  gdouble last_x;
+  gdouble last_y;
+  GArray *translations;
+} GdvLayerContentJobState;
+
 /* TODO: implement instance-member registration */
 struct _GdvLayerContentPrivate
 {
@@ -93,7 +236,84 @@ struct _GdvLayerContentPrivate
   gboolean fill_below;
   gboolean fill_above;
 
-  GslMatrix * content;
+  /* column-oriented circular storage; the value of column c of the logical
+   * sample i is located at data[c * capacity + (head + i) % capacity] */
+  gdouble *data;
+  guint n_columns;
+  gsize n_points;
+  gsize capacity;
+  gsize head;
+
+  /* sliding window; the sequence-number counts all samples ever added */
+  guint max_points;
+  gdouble window_span;
+  guint64 head_seq;
+  GdvSeqDeque min_deques[GDV_LAYER_CONTENT_MIN_COLUMNS];
+  GdvSeqDeque max_deques[GDV_LAYER_CONTENT_MIN_COLUMNS];
+
+  /* matrix-view on data; only valid as long as the storage is not grown */
+  gsl_matrix_view content_view;
+
+  /* pixel-positions of all samples in logical order, as evaluated by the
+   * layer during drawing; the in-range bitmask of the samples behind the
+   * wrap-around of the storage starts at the next full byte */
+  gdouble *pixel_x;
+  gdouble *pixel_y;
+  guint8 *in_range;
+  gsize scratch_capacity;
+  gsize scratch_split;
+
+  /* level-of-detail pyramid and the samples selected from it for drawing;
+   * the selection is stored column-wise with lod_capacity values each */
+  gboolean lod;
+  GdvLodLevel lod_levels[GDV_LAYER_CONTENT_LOD_LEVELS];
+  gdouble *lod_samples;
+  gsize lod_capacity;
+
+  /* the sequence-number of the newest sample, whose x-value is smaller than
+   * the one of its predecessor (or NAN); the x-values of all samples are in
+   * order, as long as this sample is not newer than the oldest one */
+  guint64 x_break_seq;
+
+  /* offscreen-rendering; the surface contains the samples from cache_head_seq
+   * up to cache_end_seq, as mapped by the layer and the axes with the given
+   * key; key is the one of the current drawing */
+  cairo_surface_t *cache;
+  gboolean cache_valid;
+  GtkAllocation cache_allocation;
+  gint cache_scale;
+  GArray *key;
+  GArray *cache_key;
+  guint64 cache_head_seq;
+  guint64 cache_end_seq;
+  gboolean cache_continuable;
+  gboolean cache_has_last;
+  gdouble cache_last_x;
+  gdouble cache_last_y;
+
+  /* strip-chart mode; the translations of all axes in x and y, as they are
+   * rendered into the surface and as they are now. The x-translation of an
+   * axis, that does not map onto x, is NAN. */
+  gboolean cache_strip_chart;
+  GArray *cache_translations;
+  GArray *translations;
+
+  /* rendering on worker-threads; the surface keeps the last complete image,
+   * until the job is done */
+  gboolean threaded;
+  GdvTileJob *job;
+  GdvLayerContentJobState job_state;
+
+  /* density-mode; the counts of the samples in the surface per block of
+   * density_block pixels, stored row by row */
+  guint render_mode;
+  guint density_block;
+  guint density_scale;
+  guint32 *density_counts;
+  gint density_columns;
+  gint density_rows;
+  guint32 density_max;
+  cairo_surface_t *density_image;
 };
 
 static void
@@ -116,10 +336,631 @@ static gboolean
 gdv_layer_content_on_draw (GtkWidget    *widget,
                            cairo_t      *cr);
 
+static void
+gdv_layer_content_style_updated (GtkWidget *widget);
+
 G_DEFINE_TYPE_WITH_PRIVATE (GdvLayerContent,
                             gdv_layer_content,
                             GTK_TYPE_WIDGET)
 
+/* sequence-deque helpers */
+static void
+_gdv_seq_deque_push_back (GdvSeqDeque *deque,
+                          guint64      seq)
+{
+  if (deque->length == deque->capacity)
+    {
+      gsize capacity = MAX (16, deque->capacity * 2);
+      guint64 *items = g_new (guint64, capacity);
+      gsize i;
+
+      for (i = 0; i < deque->length; i++)
+        items[i] = deque->items[(deque->head + i) % deque->capacity];
+
+      g_free (deque->items);
+      deque->items = items;
+      deque->capacity = capacity;
+      deque->head = 0;
+    }
+
+  deque->items[(deque->head + deque->length) % deque->capacity] = seq;
+  deque->length++;
+}
+
+static inline guint64
+_gdv_seq_deque_front (GdvSeqDeque *deque)
+{
+  return deque->items[deque->head];
+}
+
+static inline guint64
+_gdv_seq_deque_back (GdvSeqDeque *deque)
+{
+  return deque->items[(deque->head + deque->length - 1) % deque->capacity];
+}
+
+static inline void
+_gdv_seq_deque_pop_front (GdvSeqDeque *deque)
+{
+  deque->head = (deque->head + 1) % deque->capacity;
+  deque->length--;
+}
+
+static inline void
+_gdv_seq_deque_clear (GdvSeqDeque *deque)
+{
+  deque->head = 0;
+  deque->length = 0;
+}
+
+/* level-of-detail helpers */
+static inline guint
+_gdv_lod_level_shift (guint level)
+{
+  return GDV_LAYER_CONTENT_LOD_BASE_SHIFT +
+         GDV_LAYER_CONTENT_LOD_LEVEL_SHIFT * level;
+}
+
+static inline GdvLodBucket *
+_gdv_lod_level_nth (GdvLodLevel *level,
+                    gsize        index)
+{
+  return &level->buckets[(level->head + index) % level->capacity];
+}
+
+static GdvLodBucket *
+_gdv_lod_level_push_back (GdvLodLevel *level)
+{
+  if (level->length == level->capacity)
+    {
+      gsize capacity = MAX (16, level->capacity * 2);
+      GdvLodBucket *buckets = g_new (GdvLodBucket, capacity);
+      gsize i;
+
+      for (i = 0; i < level->length; i++)
+        buckets[i] = *_gdv_lod_level_nth (level, i);
+
+      g_free (level->buckets);
+      level->buckets = buckets;
+      level->capacity = capacity;
+      level->head = 0;
+    }
+
+  level->length++;
+
+  return _gdv_lod_level_nth (level, level->length - 1);
+}
+
+static inline void
+_gdv_lod_level_pop_front (GdvLodLevel *level)
+{
+  level->head = (level->head + 1) % level->capacity;
+  level->length--;
+  level->first++;
+}
+
+static inline void
+_gdv_lod_level_clear (GdvLodLevel *level)
+{
+  level->head = 0;
+  level->length = 0;
+  level->first = 0;
+}
+
+/* drops the rendering on the worker-threads, if there is one */
+static inline void
+_gdv_layer_content_cancel_job (GdvLayerContentPrivate *priv)
+{
+  if (!priv->job)
+    return;
+
+  _gdv_tile_job_cancel (priv->job);
+  g_clear_pointer (&priv->job, _gdv_tile_job_unref);
+}
+
+/* the offscreen-surface has to be rendered from scratch on the next draw */
+static inline void
+_gdv_layer_content_invalidate_cache (GdvLayerContentPrivate *priv)
+{
+  priv->cache_valid = FALSE;
+  _gdv_layer_content_cancel_job (priv);
+}
+
+/* column-storage helpers */
+static inline gboolean
+_gdv_layer_content_is_windowed (GdvLayerContentPrivate *priv)
+{
+  return priv->max_points > 0 || priv->window_span > 0.0;
+}
+
+static inline gdouble *
+_gdv_layer_content_column (GdvLayerContentPrivate *priv,
+                           guint                   column)
+{
+  return priv->data + (gsize) column * priv->capacity;
+}
+
+/* translates the logical index of a sample into its position in a column */
+static inline gsize
+_gdv_layer_content_physical_index (GdvLayerContentPrivate *priv,
+                                   gsize                   index)
+{
+  index += priv->head;
+
+  return index >= priv->capacity ? index - priv->capacity : index;
+}
+
+static inline gdouble
+_gdv_layer_content_value (GdvLayerContentPrivate *priv,
+                          guint                   column,
+                          gsize                   index)
+{
+  return _gdv_layer_content_column (priv, column)
+    [_gdv_layer_content_physical_index (priv, index)];
+}
+
+static inline gdouble
+_gdv_layer_content_seq_value (GdvLayerContentPrivate *priv,
+                              guint                   column,
+                              guint64                 seq)
+{
+  return _gdv_layer_content_value (priv, column, seq - priv->head_seq);
+}
+
+/* Changes the layout of the storage to n_columns with a capacity of capacity
+ * samples each. The samples are stored in logical order afterwards. */
+static void
+_gdv_layer_content_relayout (GdvLayerContentPrivate *priv,
+                             guint                   n_columns,
+                             gsize                   capacity)
+{
+  gdouble *data;
+  guint column;
+  gsize first_part;
+
+  g_assert (n_columns >= priv->n_columns);
+  g_assert (capacity >= priv->n_points);
+
+  if (n_columns == priv->n_columns &&
+      capacity == priv->capacity &&
+      priv->head == 0)
+    return;
+
+  data = g_new (gdouble, (gsize) n_columns * capacity);
+  first_part = MIN (priv->n_points, priv->capacity - priv->head);
+
+  for (column = 0; column < priv->n_columns; column++)
+    {
+      const gdouble *old_column = _gdv_layer_content_column (priv, column);
+      gdouble *new_column = data + (gsize) column * capacity;
+
+      memcpy (new_column,
+              old_column + priv->head,
+              first_part * sizeof (gdouble));
+      memcpy (new_column + first_part,
+              old_column,
+              (priv->n_points - first_part) * sizeof (gdouble));
+    }
+
+  /* new columns are filled up with zeros */
+  for (column = priv->n_columns; column < n_columns; column++)
+    memset (data + (gsize) column * capacity,
+            0,
+            priv->n_points * sizeof (gdouble));
+
+  g_free (priv->data);
+  priv->data = data;
+  priv->n_columns = n_columns;
+  priv->capacity = capacity;
+  priv->head = 0;
+}
+
+/* Makes sure that at least n_points samples fit into the storage. The capacity
+ * grows geometrically, so appending is amortized O(1), but never beyond
+ * max-points, where the circular buffer starts to overwrite samples. */
+static void
+_gdv_layer_content_ensure_capacity (GdvLayerContentPrivate *priv,
+                                    gsize                   n_points)
+{
+  gsize capacity;
+
+  if (n_points <= priv->capacity)
+    return;
+
+  capacity = MAX (priv->capacity, GDV_LAYER_CONTENT_MIN_CAPACITY);
+
+  while (capacity < n_points)
+    capacity *= 2;
+
+  if (priv->max_points > 0)
+    capacity = MAX (n_points, MIN (capacity, priv->max_points));
+
+  _gdv_layer_content_relayout (priv, priv->n_columns, capacity);
+}
+
+/* makes sure the samples are stored contiguously, to give direct access */
+static void
+_gdv_layer_content_linearize (GdvLayerContentPrivate *priv)
+{
+  if (priv->head + priv->n_points > priv->capacity)
+    _gdv_layer_content_relayout (priv, priv->n_columns, priv->capacity);
+}
+
+static void
+_gdv_layer_content_update_bounds (GdvLayerContentPrivate *priv,
+                                  gdouble                 x_value,
+                                  gdouble                 y_value,
+                                  gdouble                 z_value)
+{
+  priv->layer_max->x = fmax (priv->layer_max->x, x_value);
+  priv->layer_max->y = fmax (priv->layer_max->y, y_value);
+  priv->layer_max->z = fmax (priv->layer_max->z, z_value);
+
+  priv->layer_min->x = fmin (priv->layer_min->x, x_value);
+  priv->layer_min->y = fmin (priv->layer_min->y, y_value);
+  priv->layer_min->z = fmin (priv->layer_min->z, z_value);
+}
+
+static void
+_gdv_layer_content_reset_bounds (GdvLayerContentPrivate *priv)
+{
+  guint column;
+
+  priv->layer_max->x = -G_MAXDOUBLE;
+  priv->layer_max->y = -G_MAXDOUBLE;
+  priv->layer_max->z = -G_MAXDOUBLE;
+
+  priv->layer_min->x = G_MAXDOUBLE;
+  priv->layer_min->y = G_MAXDOUBLE;
+  priv->layer_min->z = G_MAXDOUBLE;
+
+  for (column = 0; column < GDV_LAYER_CONTENT_MIN_COLUMNS; column++)
+    {
+      _gdv_seq_deque_clear (&priv->min_deques[column]);
+      _gdv_seq_deque_clear (&priv->max_deques[column]);
+    }
+}
+
+/* feeds the newest sample into the monotonic deques of the window */
+static void
+_gdv_layer_content_window_push (GdvLayerContentPrivate *priv)
+{
+  guint64 seq = priv->head_seq + priv->n_points - 1;
+  guint column;
+
+  for (column = 0; column < GDV_LAYER_CONTENT_MIN_COLUMNS; column++)
+    {
+      GdvSeqDeque *min_deque = &priv->min_deques[column];
+      GdvSeqDeque *max_deque = &priv->max_deques[column];
+      gdouble value = _gdv_layer_content_seq_value (priv, column, seq);
+
+      if (isnan (value))
+        continue;
+
+      while (min_deque->length > 0 &&
+             _gdv_layer_content_seq_value (
+               priv, column, _gdv_seq_deque_back (min_deque)) >= value)
+        min_deque->length--;
+
+      while (max_deque->length > 0 &&
+             _gdv_layer_content_seq_value (
+               priv, column, _gdv_seq_deque_back (max_deque)) <= value)
+        max_deque->length--;
+
+      _gdv_seq_deque_push_back (min_deque, seq);
+      _gdv_seq_deque_push_back (max_deque, seq);
+    }
+}
+
+/* copies the fronts of the monotonic deques into the bounds */
+static void
+_gdv_layer_content_window_bounds (GdvLayerContentPrivate *priv)
+{
+  gdouble min[GDV_LAYER_CONTENT_MIN_COLUMNS];
+  gdouble max[GDV_LAYER_CONTENT_MIN_COLUMNS];
+  guint column;
+
+  for (column = 0; column < GDV_LAYER_CONTENT_MIN_COLUMNS; column++)
+    {
+      GdvSeqDeque *min_deque = &priv->min_deques[column];
+      GdvSeqDeque *max_deque = &priv->max_deques[column];
+
+      min[column] = min_deque->length == 0 ? NAN :
+        _gdv_layer_content_seq_value (
+          priv, column, _gdv_seq_deque_front (min_deque));
+      max[column] = max_deque->length == 0 ? NAN :
+        _gdv_layer_content_seq_value (
+          priv, column, _gdv_seq_deque_front (max_deque));
+    }
+
+  priv->layer_min->x = min[0];
+  priv->layer_min->y = min[1];
+  priv->layer_min->z = min[2];
+
+  priv->layer_max->x = max[0];
+  priv->layer_max->y = max[1];
+  priv->layer_max->z = max[2];
+}
+
+/* removes the oldest sample in O(1) */
+static void
+_gdv_layer_content_evict_oldest (GdvLayerContentPrivate *priv)
+{
+  guint column;
+
+  for (column = 0; column < GDV_LAYER_CONTENT_MIN_COLUMNS; column++)
+    {
+      GdvSeqDeque *min_deque = &priv->min_deques[column];
+      GdvSeqDeque *max_deque = &priv->max_deques[column];
+
+      if (min_deque->length > 0 &&
+          _gdv_seq_deque_front (min_deque) == priv->head_seq)
+        _gdv_seq_deque_pop_front (min_deque);
+
+      if (max_deque->length > 0 &&
+          _gdv_seq_deque_front (max_deque) == priv->head_seq)
+        _gdv_seq_deque_pop_front (max_deque);
+    }
+
+  priv->head = _gdv_layer_content_physical_index (priv, 1);
+  priv->head_seq++;
+  priv->n_points--;
+}
+
+/* Reserves the slot for a new sample at the end of the content and returns
+ * its position in the columns. The oldest sample is overwritten, if the
+ * content is limited by max-points. */
+static gsize
+_gdv_layer_content_push (GdvLayerContentPrivate *priv)
+{
+  if (priv->max_points > 0 && priv->n_points >= priv->max_points)
+    _gdv_layer_content_evict_oldest (priv);
+
+  _gdv_layer_content_ensure_capacity (priv, priv->n_points + 1);
+  priv->n_points++;
+
+  return _gdv_layer_content_physical_index (priv, priv->n_points - 1);
+}
+
+/* feeds the y-value of the sample with the sequence-number seq into every
+ * level of the pyramid */
+static void
+_gdv_layer_content_lod_push (GdvLayerContentPrivate *priv,
+                             guint64                 seq,
+                             gdouble                 value)
+{
+  guint level;
+
+  for (level = 0; level < GDV_LAYER_CONTENT_LOD_LEVELS; level++)
+    {
+      GdvLodLevel *lod = &priv->lod_levels[level];
+      guint shift = _gdv_lod_level_shift (level);
+      guint64 bucket_index = seq >> shift;
+      GdvLodBucket *bucket;
+
+      if (lod->length == 0 || lod->first + lod->length <= bucket_index)
+        {
+          /* drop the buckets, that only contain evicted samples */
+          while (lod->length > 0 &&
+                 (lod->first + 1) << shift <= priv->head_seq)
+            _gdv_lod_level_pop_front (lod);
+
+          if (lod->length == 0)
+            lod->first = bucket_index;
+
+          bucket = _gdv_lod_level_push_back (lod);
+          bucket->min = INFINITY;
+          bucket->max = -INFINITY;
+          bucket->min_seq = seq;
+          bucket->max_seq = seq;
+        }
+      else
+        bucket = _gdv_lod_level_nth (lod, lod->length - 1);
+
+      if (value < bucket->min)
+        {
+          bucket->min = value;
+          bucket->min_seq = seq;
+        }
+      if (value > bucket->max)
+        {
+          bucket->max = value;
+          bucket->max_seq = seq;
+        }
+    }
+}
+
+static void
+_gdv_layer_content_lod_clear (GdvLayerContentPrivate *priv)
+{
+  guint level;
+
+  for (level = 0; level < GDV_LAYER_CONTENT_LOD_LEVELS; level++)
+    _gdv_lod_level_clear (&priv->lod_levels[level]);
+}
+
+static void
+_gdv_layer_content_lod_rebuild (GdvLayerContentPrivate *priv)
+{
+  gsize i;
+
+  _gdv_layer_content_lod_clear (priv);
+
+  if (!priv->lod)
+    return;
+
+  for (i = 0; i < priv->n_points; i++)
+    _gdv_layer_content_lod_push (priv,
+                                 priv->head_seq + i,
+                                 _gdv_layer_content_value (priv, 1, i));
+}
+
+static inline void
+_gdv_layer_content_track_order (GdvLayerContentPrivate *priv,
+                                guint64                 seq,
+                                gdouble                 previous_x,
+                                gdouble                 x_value)
+{
+  if (!(x_value >= previous_x))
+    priv->x_break_seq = seq;
+}
+
+static inline gboolean
+_gdv_layer_content_is_x_ordered (GdvLayerContentPrivate *priv)
+{
+  return priv->x_break_seq <= priv->head_seq;
+}
+
+static void
+_gdv_layer_content_rebuild_order (GdvLayerContentPrivate *priv)
+{
+  gsize i;
+
+  priv->x_break_seq = 0;
+
+  for (i = 1; i < priv->n_points; i++)
+    _gdv_layer_content_track_order (priv,
+                                    priv->head_seq + i,
+                                    _gdv_layer_content_value (priv, 0, i - 1),
+                                    _gdv_layer_content_value (priv, 0, i));
+}
+
+/* updates bounds and window after the newest sample was written */
+static void
+_gdv_layer_content_commit (GdvLayerContentPrivate *priv)
+{
+  if (priv->n_points > 1)
+    _gdv_layer_content_track_order (
+      priv,
+      priv->head_seq + priv->n_points - 1,
+      _gdv_layer_content_value (priv, 0, priv->n_points - 2),
+      _gdv_layer_content_value (priv, 0, priv->n_points - 1));
+
+  if (priv->lod)
+    _gdv_layer_content_lod_push (
+      priv,
+      priv->head_seq + priv->n_points - 1,
+      _gdv_layer_content_value (priv, 1, priv->n_points - 1));
+
+  if (!_gdv_layer_content_is_windowed (priv))
+    {
+      gsize index = priv->n_points - 1;
+
+      _gdv_layer_content_update_bounds (
+        priv,
+        _gdv_layer_content_value (priv, 0, index),
+        _gdv_layer_content_value (priv, 1, index),
+        _gdv_layer_content_value (priv, 2, index));
+      return;
+    }
+
+  _gdv_layer_content_window_push (priv);
+
+  if (priv->window_span > 0.0)
+    {
+      gdouble newest = _gdv_layer_content_value (priv, 0, priv->n_points - 1);
+
+      while (priv->n_points > 1 &&
+             newest - _gdv_layer_content_value (priv, 0, 0) > priv->window_span)
+        _gdv_layer_content_evict_oldest (priv);
+    }
+
+  _gdv_layer_content_window_bounds (priv);
+}
+
+/* recalculates all bounds from scratch */
+static void
+_gdv_layer_content_rebuild_bounds (GdvLayerContentPrivate *priv)
+{
+  gsize n_points = priv->n_points;
+
+  _gdv_layer_content_reset_bounds (priv);
+
+  if (n_points == 0)
+    return;
+
+  /* replay all samples as if they were just committed */
+  for (priv->n_points = 1; priv->n_points <= n_points; priv->n_points++)
+    {
+      if (_gdv_layer_content_is_windowed (priv))
+        _gdv_layer_content_window_push (priv);
+      else
+        _gdv_layer_content_update_bounds (
+          priv,
+          _gdv_layer_content_value (priv, 0, priv->n_points - 1),
+          _gdv_layer_content_value (priv, 1, priv->n_points - 1),
+          _gdv_layer_content_value (priv, 2, priv->n_points - 1));
+    }
+
+  priv->n_points = n_points;
+
+  if (_gdv_layer_content_is_windowed (priv))
+    _gdv_layer_content_window_bounds (priv);
+}
+
+/* applies a changed max-points or window-span to the stored samples */
+static void
+_gdv_layer_content_apply_window (GdvLayerContentPrivate *priv)
+{
+  if (priv->window_span > 0.0 && priv->n_points > 0)
+    {
+      gdouble newest = _gdv_layer_content_value (priv, 0, priv->n_points - 1);
+
+      while (priv->n_points > 1 &&
+             newest - _gdv_layer_content_value (priv, 0, 0) > priv->window_span)
+        {
+          priv->head = _gdv_layer_content_physical_index (priv, 1);
+          priv->head_seq++;
+          priv->n_points--;
+        }
+    }
+
+  if (priv->max_points > 0)
+    {
+      if (priv->n_points > priv->max_points)
+        {
+          gsize surplus = priv->n_points - priv->max_points;
+
+          priv->head = _gdv_layer_content_physical_index (priv, surplus);
+          priv->head_seq += surplus;
+          priv->n_points = priv->max_points;
+        }
+
+      /* the storage grows with the samples, but not beyond the limit */
+      _gdv_layer_content_relayout (priv, priv->n_columns,
+                                   MIN (priv->capacity, priv->max_points));
+    }
+  else
+    /* without a window the samples always start at the front of the columns */
+    _gdv_layer_content_relayout (priv, priv->n_columns, priv->capacity);
+
+  _gdv_layer_content_rebuild_bounds (priv);
+  _gdv_layer_content_lod_rebuild (priv);
+  _gdv_layer_content_rebuild_order (priv);
+  _gdv_layer_content_invalidate_cache (priv);
+}
+
+static void
+_gdv_layer_content_append (GdvLayerContentPrivate *priv,
+                           gdouble                 x_value,
+                           gdouble                 y_value,
+                           gdouble                 z_value)
+{
+  gsize index = _gdv_layer_content_push (priv);
+  guint column;
+
+  _gdv_layer_content_column (priv, 0)[index] = x_value;
+  _gdv_layer_content_column (priv, 1)[index] = y_value;
+  _gdv_layer_content_column (priv, 2)[index] = z_value;
+
+  for (column = GDV_LAYER_CONTENT_MIN_COLUMNS;
+       column < priv->n_columns;
+       column++)
+    _gdv_layer_content_column (priv, column)[index] = 0.0;
+
+  _gdv_layer_content_commit (priv);
+}
+
 /* define the property-setter */
 static void
 gdv_layer_content_set_property (GObject      *object,
@@ -133,20 +974,10 @@ gdv_layer_content_set_property (GObject      *object,
   {
   case PROP_DATA_POINT:
       {
-        gsize rows;
         GdvDataPoint * dp;
 
-        if (self->priv->content == NULL)
-          {
-            self->priv->content = gsl_matrix_alloc(3, 1);
-            g_object_notify (G_OBJECT (self), "content-matrix");
-          }
-
         dp = g_value_get_boxed (value);
-        rows = self->priv->content->size2;
-        gsl_matrix_set_and_expand(self->priv->content, 0, rows, dp->x);
-        gsl_matrix_set_and_expand(self->priv->content, 1, rows, dp->y);
-        gsl_matrix_set_and_expand(self->priv->content, 2, rows, dp->z);
+        _gdv_layer_content_append (self->priv, dp->x, dp->y, dp->z);
       }
     break;
 
@@ -159,6 +990,8 @@ gdv_layer_content_set_property (GObject      *object,
 
   case PROP_POINT_TYPE:
     self->priv->point_style = g_value_get_uint (value);
+    _gdv_layer_content_invalidate_cache (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
     break;
 
   case PROP_LINE_STYLE:
@@ -184,6 +1017,50 @@ gdv_layer_content_set_property (GObject      *object,
     self->priv->fill_above = g_value_get_boolean (value);
     break;
 
+  case PROP_MAX_POINTS:
+    self->priv->max_points = g_value_get_uint (value);
+    _gdv_layer_content_apply_window (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
+  case PROP_WINDOW_SPAN:
+    self->priv->window_span = g_value_get_double (value);
+    _gdv_layer_content_apply_window (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
+  case PROP_LEVEL_OF_DETAIL:
+    self->priv->lod = g_value_get_boolean (value);
+    _gdv_layer_content_lod_rebuild (self->priv);
+    _gdv_layer_content_invalidate_cache (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
+  case PROP_THREADED_RENDERING:
+    self->priv->threaded = g_value_get_boolean (value);
+    if (!self->priv->threaded)
+      _gdv_layer_content_cancel_job (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
+  case PROP_RENDER_MODE:
+    self->priv->render_mode = g_value_get_uint (value);
+    _gdv_layer_content_invalidate_cache (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
+  case PROP_DENSITY_BLOCK_SIZE:
+    self->priv->density_block = g_value_get_uint (value);
+    _gdv_layer_content_invalidate_cache (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
+  case PROP_DENSITY_SCALE:
+    self->priv->density_scale = g_value_get_uint (value);
+    _gdv_layer_content_invalidate_cache (self->priv);
+    gtk_widget_queue_draw (GTK_WIDGET (self));
+    break;
+
   default:
     /* unknown property */
     G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
@@ -205,12 +1082,12 @@ gdv_layer_content_get_property (GObject    *object,
   case PROP_DATA_POINT:
       {
         GdvDataPoint dp;
-        if (self->priv->content != NULL)
+        if (self->priv->n_points > 0)
           {
-            gsize last_row = self->priv->content->size2 - 1;
-            dp.x = gsl_matrix_get(self->priv->content, 0, last_row);
-            dp.y = gsl_matrix_get(self->priv->content, 1, last_row);
-            dp.z = gsl_matrix_get(self->priv->content, 2, last_row);
+            gsize last_row = self->priv->n_points - 1;
+            dp.x = _gdv_layer_content_value (self->priv, 0, last_row);
+            dp.y = _gdv_layer_content_value (self->priv, 1, last_row);
+            dp.z = _gdv_layer_content_value (self->priv, 2, last_row);
           }
         else
           {
@@ -255,190 +1132,1405 @@ gdv_layer_content_get_property (GObject    *object,
     g_value_set_boolean (value, self->priv->fill_above);
     break;
 
-  default:
-    /* unknown property */
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+  case PROP_MAX_POINTS:
+    g_value_set_uint (value, self->priv->max_points);
     break;
-  }
-}
 
-static void
-gdv_layer_content_init (GdvLayerContent *content)
-{
+  case PROP_WINDOW_SPAN:
+    g_value_set_double (value, self->priv->window_span);
+    break;
+
+  case PROP_LEVEL_OF_DETAIL:
+    g_value_set_boolean (value, self->priv->lod);
+    break;
+
+  case PROP_THREADED_RENDERING:
+    g_value_set_boolean (value, self->priv->threaded);
+    break;
+
+  case PROP_RENDER_MODE:
+    g_value_set_uint (value, self->priv->render_mode);
+    break;
+
+  case PROP_DENSITY_BLOCK_SIZE:
+    g_value_set_uint (value, self->priv->density_block);
+    break;
+
+  case PROP_DENSITY_SCALE:
+    g_value_set_uint (value, self->priv->density_scale);
+    break;
+
+  default:
+    /* unknown property */
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
+    break;
+  }
+}
+
+static void
+gdv_layer_content_init (GdvLayerContent *content)
+{
   GtkWidget *widget;
   GtkStyleContext *style_context;
-  GtkCssProvider *css_provider;
 
-  widget = GTK_WIDGET (content);
+  widget = GTK_WIDGET (content);
+
+  gtk_widget_set_name (widget, "new layer");
+
+  /* initializing style-properties */
+  style_context = gtk_widget_get_style_context (widget);
+  _gdv_theme_add_to_context (style_context);
+
+  gtk_widget_set_can_focus (GTK_WIDGET (content), TRUE);
+  gtk_widget_set_receives_default (GTK_WIDGET (content), TRUE);
+  gtk_widget_set_has_window (GTK_WIDGET (content), FALSE);
+
+  content->priv = gdv_layer_content_get_instance_private (content);
+
+  content->priv->event_win = NULL;
+
+  content->priv->point_width = 3;
+  content->priv->point_line_width = 0;
+  content->priv->point_style = 0;
+  content->priv->point_source = cairo_pattern_create_rgba (0, 0, 0, 1);
+  content->priv->point_fill = TRUE;
+  content->priv->point_fill_source = NULL;
+
+  content->priv->title = g_strdup ("new data\0");
+  content->priv->show_in_legend = TRUE;
+
+  content->priv->line_source = cairo_pattern_create_rgba (0, 0, 0, 1);
+  content->priv->line_style = 1;
+
+  content->priv->layer_min = g_new (GdvDataPoint, 1);
+  content->priv->layer_max = g_new (GdvDataPoint, 1);
+
+  content->priv->layer_max->x = NAN;
+  content->priv->layer_max->y = NAN;
+  content->priv->layer_max->z = NAN;
+
+  content->priv->layer_min->x = NAN;
+  content->priv->layer_min->y = NAN;
+  content->priv->layer_min->z = NAN;
+
+  content->priv->data = NULL;
+  content->priv->n_columns = GDV_LAYER_CONTENT_MIN_COLUMNS;
+  content->priv->n_points = 0;
+  content->priv->capacity = 0;
+  content->priv->head = 0;
+
+  content->priv->max_points = 0;
+  content->priv->window_span = 0.0;
+  content->priv->head_seq = 0;
+
+  content->priv->pixel_x = NULL;
+  content->priv->pixel_y = NULL;
+  content->priv->in_range = NULL;
+  content->priv->scratch_capacity = 0;
+  content->priv->scratch_split = 0;
+
+  content->priv->lod = FALSE;
+  memset (content->priv->lod_levels, 0, sizeof (content->priv->lod_levels));
+  content->priv->lod_samples = NULL;
+  content->priv->lod_capacity = 0;
+
+  content->priv->x_break_seq = 0;
+
+  content->priv->cache = NULL;
+  content->priv->cache_valid = FALSE;
+  content->priv->cache_scale = 0;
+  content->priv->key = g_array_new (FALSE, FALSE,
+                                    sizeof (GdvLayerContentKeyEntry));
+  content->priv->cache_key = g_array_new (FALSE, FALSE,
+                                          sizeof (GdvLayerContentKeyEntry));
+  content->priv->cache_head_seq = 0;
+  content->priv->cache_end_seq = 0;
+  content->priv->cache_continuable = FALSE;
+  content->priv->cache_has_last = FALSE;
+
+  content->priv->cache_strip_chart = FALSE;
+  content->priv->cache_translations = g_array_new (FALSE, FALSE,
+                                                   sizeof (gdouble));
+  content->priv->translations = g_array_new (FALSE, FALSE, sizeof (gdouble));
+
+  content->priv->threaded = FALSE;
+  content->priv->job = NULL;
+  content->priv->job_state.key =
+    g_array_new (FALSE, FALSE, sizeof (GdvLayerContentKeyEntry));
+  content->priv->job_state.translations = g_array_new (FALSE, FALSE,
+                                                       sizeof (gdouble));
+
+  content->priv->render_mode = GDV_RENDER_MODE_LINES;
+  content->priv->density_block = 1;
+  content->priv->density_scale = GDV_DENSITY_SCALE_LOG;
+  content->priv->density_counts = NULL;
+  content->priv->density_columns = 0;
+  content->priv->density_rows = 0;
+  content->priv->density_max = 0;
+  content->priv->density_image = NULL;
+}
+
+static void
+_gdv_layer_content_ensure_scratch (GdvLayerContentPrivate *priv,
+                                   gsize                   n_points)
+{
+  if (priv->scratch_capacity >= n_points)
+    return;
+
+  priv->scratch_capacity = MAX (n_points, priv->capacity);
+  priv->pixel_x =
+    g_renew (gdouble, priv->pixel_x, priv->scratch_capacity);
+  priv->pixel_y =
+    g_renew (gdouble, priv->pixel_y, priv->scratch_capacity);
+  priv->in_range =
+    g_renew (guint8, priv->in_range, (priv->scratch_capacity + 7) / 8 + 1);
+}
+
+/* maps all samples onto the layer in one go; the storage is handed over to
+ * the layer as (up to) two contiguous segments */
+static void
+_gdv_layer_content_evaluate (GdvLayerContentPrivate *priv,
+                             GdvLayer               *layer,
+                             gsize                   first,
+                             gsize                   n_points)
+{
+  const gdouble *x_column, *y_column, *z_column;
+  gsize start, first_part;
+
+  _gdv_layer_content_ensure_scratch (priv, n_points);
+
+  x_column = _gdv_layer_content_column (priv, 0);
+  y_column = _gdv_layer_content_column (priv, 1);
+  z_column = _gdv_layer_content_column (priv, 2);
+
+  start = _gdv_layer_content_physical_index (priv, first);
+  first_part = MIN (n_points, priv->capacity - start);
+  priv->scratch_split = first_part;
+
+  gdv_layer_evaluate_data_points (layer,
+                                  x_column + start,
+                                  y_column + start,
+                                  z_column + start,
+                                  first_part, 1,
+                                  priv->pixel_x, priv->pixel_y,
+                                  priv->in_range);
+
+  if (n_points > first_part)
+    gdv_layer_evaluate_data_points (layer,
+                                    x_column, y_column, z_column,
+                                    n_points - first_part, 1,
+                                    priv->pixel_x + first_part,
+                                    priv->pixel_y + first_part,
+                                    priv->in_range + (first_part + 7) / 8);
+}
+
+/* the horizontal pixel-position of the sample with the logical index */
+static gdouble
+_gdv_layer_content_pixel_x (GdvLayerContentPrivate *priv,
+                            GdvLayer               *layer,
+                            gsize                   index)
+{
+  gdouble pixel_x = NAN, pixel_y;
+
+  gdv_layer_evaluate_data_point (layer,
+                                 _gdv_layer_content_value (priv, 0, index),
+                                 _gdv_layer_content_value (priv, 1, index),
+                                 _gdv_layer_content_value (priv, 2, index),
+                                 &pixel_x, &pixel_y);
+
+  return pixel_x;
+}
+
+/* the first sample from low up to high, whose pixel-position (multiplied by
+ * direction) is larger than bound (or equal, if inclusive) */
+static gsize
+_gdv_layer_content_bisect (GdvLayerContentPrivate *priv,
+                           GdvLayer               *layer,
+                           gsize                   low,
+                           gsize                   high,
+                           gdouble                 direction,
+                           gdouble                 bound,
+                           gboolean                inclusive)
+{
+  while (low < high)
+    {
+      gsize mid = low + (high - low) / 2;
+      gdouble key = direction * _gdv_layer_content_pixel_x (priv, layer, mid);
+
+      if (key > bound || (inclusive && key == bound))
+        high = mid;
+      else
+        low = mid + 1;
+    }
+
+  return low;
+}
+
+/* Determines the range of samples, that has to be drawn into the horizontal
+ * extent of allocation, if the x-values are in order. One neighbour on each
+ * side is included, so the line enters and leaves the plot. Only a
+ * #GdvTwodLayer maps the x-values onto the horizontal pixels; other layers
+ * may map them anywhere. */
+static gboolean
+_gdv_layer_content_visible_range (GdvLayerContentPrivate *priv,
+                                  GdvLayer               *layer,
+                                  const GtkAllocation    *allocation,
+                                  gsize                  *first,
+                                  gsize                  *n_points)
+{
+  gdouble first_x, last_x, direction;
+  gsize begin, end;
+
+  if (priv->n_points < GDV_LAYER_CONTENT_SEARCH_MIN ||
+      !GDV_TWOD_IS_LAYER (layer) ||
+      !_gdv_layer_content_is_x_ordered (priv))
+    return FALSE;
+
+  first_x = _gdv_layer_content_pixel_x (priv, layer, 0);
+  last_x = _gdv_layer_content_pixel_x (priv, layer, priv->n_points - 1);
+
+  if (!isfinite (first_x) || !isfinite (last_x))
+    return FALSE;
+
+  /* the axis may also be inverted */
+  direction = last_x >= first_x ? 1.0 : -1.0;
+
+  if (direction > 0.0)
+    {
+      begin = _gdv_layer_content_bisect (priv, layer, 0, priv->n_points,
+                                         direction, allocation->x, TRUE);
+      end = _gdv_layer_content_bisect (priv, layer, 0, priv->n_points,
+                                       direction,
+                                       allocation->x + allocation->width,
+                                       FALSE);
+    }
+  else
+    {
+      begin = _gdv_layer_content_bisect (priv, layer, 0, priv->n_points,
+                                         direction,
+                                         -(allocation->x + allocation->width),
+                                         TRUE);
+      end = _gdv_layer_content_bisect (priv, layer, 0, priv->n_points,
+                                       direction, -allocation->x, FALSE);
+    }
+
+  begin = begin > 0 ? begin - 1 : 0;
+  end = MIN (end + 1, priv->n_points);
+
+  if (begin >= end)
+    return FALSE;
+
+  *first = begin;
+  *n_points = end - begin;
+
+  return TRUE;
+}
+
+/* grows the selection from the pyramid to at least n_samples per column and
+ * keeps the samples selected so far */
+static void
+_gdv_layer_content_lod_reserve (GdvLayerContentPrivate *priv,
+                                gsize                   n_samples)
+{
+  gdouble *samples;
+  gsize capacity, column;
+
+  if (priv->lod_capacity >= n_samples)
+    return;
+
+  capacity = MAX (n_samples, 2 * priv->lod_capacity);
+  samples = g_new (gdouble, 3 * capacity);
+
+  if (priv->lod_samples)
+    for (column = 0; column < 3; column++)
+      memcpy (samples + column * capacity,
+              priv->lod_samples + column * priv->lod_capacity,
+              priv->lod_capacity * sizeof (gdouble));
+
+  g_free (priv->lod_samples);
+  priv->lod_samples = samples;
+  priv->lod_capacity = capacity;
+}
+
+static inline void
+_gdv_layer_content_lod_select (GdvLayerContentPrivate *priv,
+                               guint64                 seq,
+                               gsize                  *n_selected)
+{
+  gsize index = seq - priv->head_seq;
+  gdouble *samples = priv->lod_samples + *n_selected;
+
+  samples[0] = _gdv_layer_content_value (priv, 0, index);
+  samples[priv->lod_capacity] = _gdv_layer_content_value (priv, 1, index);
+  samples[2 * priv->lod_capacity] = _gdv_layer_content_value (priv, 2, index);
+  (*n_selected)++;
+}
+
+/* Finds the samples with the smallest and the largest y-value from the
+ * sequence-number begin up to end. The range is covered by the largest
+ * buckets of the pyramid, that lie completely within it; the remaining
+ * samples at its ends are compared one by one. */
+static void
+_gdv_layer_content_lod_extremes (GdvLayerContentPrivate *priv,
+                                 guint64                 begin,
+                                 guint64                 end,
+                                 guint64                *min_seq,
+                                 guint64                *max_seq)
+{
+  gdouble min = INFINITY, max = -INFINITY;
+  guint64 seq = begin;
+
+  *min_seq = begin;
+  *max_seq = begin;
+
+  while (seq < end)
+    {
+      const GdvLodBucket *bucket = NULL;
+      guint level;
+
+      for (level = GDV_LAYER_CONTENT_LOD_LEVELS; level-- > 0 && !bucket;)
+        {
+          GdvLodLevel *lod = &priv->lod_levels[level];
+          guint64 size = (guint64) 1 << _gdv_lod_level_shift (level);
+          guint64 index = seq >> _gdv_lod_level_shift (level);
+
+          if ((seq & (size - 1)) == 0 && seq + size <= end &&
+              index >= lod->first && index < lod->first + lod->length)
+            {
+              bucket = _gdv_lod_level_nth (lod, index - lod->first);
+              seq += size;
+            }
+        }
+
+      if (bucket)
+        {
+          if (bucket->min < min)
+            {
+              min = bucket->min;
+              *min_seq = bucket->min_seq;
+            }
+          if (bucket->max > max)
+            {
+              max = bucket->max;
+              *max_seq = bucket->max_seq;
+            }
+        }
+      else
+        {
+          gdouble value = _gdv_layer_content_value (priv, 1,
+                                                    seq - priv->head_seq);
+
+          if (value < min)
+            {
+              min = value;
+              *min_seq = seq;
+            }
+          if (value > max)
+            {
+              max = value;
+              *max_seq = seq;
+            }
+          seq++;
+        }
+    }
+}
+
+/* Maps a selection of the samples onto the layer, that is taken from the
+ * level-of-detail pyramid. Every pixel-column keeps its first, minimum,
+ * maximum and last sample, so the envelope of the line does not depend on
+ * the spacing of the samples. The columns are found by bisection, so the
+ * x-values have to be in order and map onto the horizontal pixels of a
+ * #GdvTwodLayer. Returns FALSE, if drawing all samples is not more
+ * expensive. */
+static gboolean
+_gdv_layer_content_evaluate_lod (GdvLayerContentPrivate *priv,
+                                 GdvLayer               *layer,
+                                 gsize                   first,
+                                 gsize                   n_points,
+                                 gsize                  *n_evaluated)
+{
+  gdouble first_x, last_x, direction, samples_per_pixel;
+  gsize begin, end, n_selected;
+
+  if (!priv->lod || n_points < 2 || !GDV_TWOD_IS_LAYER (layer) ||
+      !_gdv_layer_content_is_x_ordered (priv))
+    return FALSE;
+
+  first_x = _gdv_layer_content_pixel_x (priv, layer, first);
+  last_x = _gdv_layer_content_pixel_x (priv, layer, first + n_points - 1);
+
+  if (!isfinite (first_x) || !isfinite (last_x))
+    return FALSE;
+
+  /* on average, the columns have to hold more samples than the finest
+   * buckets */
+  samples_per_pixel = (n_points - 1) / MAX (fabs (last_x - first_x), 1.0);
+
+  if (samples_per_pixel < (1 << _gdv_lod_level_shift (0)))
+    return FALSE;
+
+  /* the axis may also be inverted */
+  direction = last_x >= first_x ? 1.0 : -1.0;
+
+  end = first + n_points;
+  n_selected = 0;
+
+  for (begin = first; begin < end;)
+    {
+      gdouble column;
+      guint64 begin_seq, stop_seq, min_seq, max_seq, low, high;
+      gsize stop;
+
+      column =
+        floor (direction * _gdv_layer_content_pixel_x (priv, layer, begin));
+      stop = _gdv_layer_content_bisect (priv, layer, begin + 1, end,
+                                        direction, column + 1.0, TRUE);
+
+      begin_seq = priv->head_seq + begin;
+      stop_seq = priv->head_seq + stop;
+
+      _gdv_layer_content_lod_extremes (priv, begin_seq, stop_seq,
+                                       &min_seq, &max_seq);
+
+      /* first, min, max and last in the order of the samples */
+      low = MIN (min_seq, max_seq);
+      high = MAX (min_seq, max_seq);
+
+      _gdv_layer_content_lod_reserve (priv, n_selected + 4);
+
+      _gdv_layer_content_lod_select (priv, begin_seq, &n_selected);
+      if (low > begin_seq)
+        _gdv_layer_content_lod_select (priv, low, &n_selected);
+      if (high > low)
+        _gdv_layer_content_lod_select (priv, high, &n_selected);
+      if (stop_seq - 1 > high)
+        _gdv_layer_content_lod_select (priv, stop_seq - 1, &n_selected);
+
+      begin = stop;
+    }
+
+  _gdv_layer_content_ensure_scratch (priv, n_selected);
+  priv->scratch_split = n_selected;
+
+  gdv_layer_evaluate_data_points (layer,
+                                  priv->lod_samples,
+                                  priv->lod_samples + priv->lod_capacity,
+                                  priv->lod_samples + 2 * priv->lod_capacity,
+                                  n_selected, 1,
+                                  priv->pixel_x, priv->pixel_y,
+                                  priv->in_range);
+
+  *n_evaluated = n_selected;
+
+  return TRUE;
+}
+
+static inline gboolean
+_gdv_layer_content_pixel_in_range (const GdvLayerContentPrivate *priv,
+                                   gsize                         i)
+{
+  const guint8 *mask = priv->in_range;
+
+  if (i >= priv->scratch_split)
+  {
+    mask += (priv->scratch_split + 7) / 8;
+    i -= priv->scratch_split;
+  }
+
+  return (mask[i >> 3] >> (i & 7)) & 1;
+}
+
+/* TRUE, if all axes of the layer map linearly or logarithmically; then the
+ * positions of samples outside the range of an axis are meaningful, too */
+static gboolean
+_gdv_layer_content_has_direct_axes (GdvLayer *layer)
+{
+  GdvAxis **axes;
+  guint n_axes, i;
+
+  axes = gdv_layer_peek_axes (layer, &n_axes);
+
+  for (i = 0; i < n_axes; i++)
+    if (!_gdv_axis_has_direct_transform (axes[i]))
+      return FALSE;
+
+  return TRUE;
+}
+
+/* Maps the samples from the logical index first up to the newest one onto
+ * the pixels of the surface and gives their number. If first is 0, only the
+ * samples within area (in coordinates of the layer) are taken, if they are
+ * ordered. Otherwise the line continues from the last point rendered before.
+ * All points are moved by offset_x.
+ *
+ * Samples outside the range of the axes are kept, as long as their position
+ * is finite, so that the line towards them is clipped at the edge of the
+ * surface instead of being dropped. */
+static gsize
+_gdv_layer_content_prepare (GdvLayerContent     *content,
+                            const GtkAllocation *allocation,
+                            const GdkRectangle  *area,
+                            gdouble              offset_x,
+                            gsize                first)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  GdvLayer *layer;
+  gboolean continued, direct;
+  gsize i, n_points, n_evaluated, n_visible;
+
+  continued = first > 0 && priv->cache_has_last;
+  n_points = priv->n_points - first;
+
+  if (!continued)
+    priv->cache_has_last = FALSE;
+
+  priv->cache_continuable = TRUE;
+
+  if (n_points == 0)
+    return 0;
+
+  layer = GDV_LAYER (gtk_widget_get_parent (GTK_WIDGET (content)));
+
+  if (first == 0)
+    _gdv_layer_content_visible_range (priv, layer, area,
+                                      &first, &n_points);
+
+  if (!_gdv_layer_content_evaluate_lod (priv, layer,
+                                        first, n_points, &n_evaluated))
+    {
+      _gdv_layer_content_evaluate (priv, layer, first, n_points);
+      n_evaluated = n_points;
+    }
+
+  priv->cache_continuable = first + n_points == priv->n_points;
+
+  direct = _gdv_layer_content_has_direct_axes (layer);
+
+  /* without a position, a data-point is skipped, and the line connects the
+   * remaining points */
+  for (i = 0, n_visible = 0; i < n_evaluated; i++)
+  {
+    if (!_gdv_layer_content_pixel_in_range (priv, i) &&
+        !(direct && isfinite (priv->pixel_x[i]) && isfinite (priv->pixel_y[i])))
+      continue;
+
+    priv->pixel_x[n_visible] =
+      priv->pixel_x[i] - (gdouble) allocation->x + offset_x;
+    priv->pixel_y[n_visible] = priv->pixel_y[i] - (gdouble) allocation->y;
+    n_visible++;
+  }
+
+  if (n_visible == 0)
+    return 0;
+
+  if (continued)
+  {
+    _gdv_layer_content_ensure_scratch (priv, n_visible + 1);
+
+    memmove (priv->pixel_x + 1, priv->pixel_x, n_visible * sizeof (gdouble));
+    memmove (priv->pixel_y + 1, priv->pixel_y, n_visible * sizeof (gdouble));
+    priv->pixel_x[0] = priv->cache_last_x;
+    priv->pixel_y[0] = priv->cache_last_y;
+    n_visible++;
+  }
+
+  return n_visible;
+}
+
+/* Paints the counts of the density-mode onto the whole surface; every
+ * count is looked up in a table of the point-color with rising opacity */
+static void
+_gdv_layer_content_paint_density (GdvLayerContent *content,
+                                  cairo_t         *cr)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  guint32 table[GDV_LAYER_CONTENT_DENSITY_LEVELS];
+  GdvDataStyle style;
+  cairo_pattern_t *pattern;
+  gdouble norm;
+  guchar *data;
+  gint stride, row, column;
+  guint level;
+
+  if (!priv->density_image ||
+      cairo_image_surface_get_width (priv->density_image) !=
+        priv->density_columns ||
+      cairo_image_surface_get_height (priv->density_image) !=
+        priv->density_rows)
+  {
+    g_clear_pointer (&priv->density_image, cairo_surface_destroy);
+    priv->density_image = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                                      priv->density_columns,
+                                                      priv->density_rows);
+  }
+
+  _gdv_data_style_resolve (gtk_widget_get_style_context (GTK_WIDGET (content)),
+                           &style);
+
+  /* premultiplied ARGB, as stored by cairo */
+  for (level = 0; level < GDV_LAYER_CONTENT_DENSITY_LEVELS; level++)
+  {
+    gdouble alpha = style.point_color.alpha *
+      (GDV_LAYER_CONTENT_DENSITY_MIN_ALPHA +
+       (1.0 - GDV_LAYER_CONTENT_DENSITY_MIN_ALPHA) * level /
+       (GDV_LAYER_CONTENT_DENSITY_LEVELS - 1));
+
+    table[level] =
+      (guint32) round (alpha * 255.0) << 24 |
+      (guint32) round (style.point_color.red * alpha * 255.0) << 16 |
+      (guint32) round (style.point_color.green * alpha * 255.0) << 8 |
+      (guint32) round (style.point_color.blue * alpha * 255.0);
+  }
+
+  if (priv->density_scale == GDV_DENSITY_SCALE_LOG)
+    norm = log1p ((gdouble) priv->density_max);
+  else
+    norm = (gdouble) priv->density_max;
+
+  cairo_surface_flush (priv->density_image);
+
+  data = cairo_image_surface_get_data (priv->density_image);
+  stride = cairo_image_surface_get_stride (priv->density_image);
+
+  for (row = 0; row < priv->density_rows; row++)
+  {
+    const guint32 *counts =
+      priv->density_counts + (gsize) row * priv->density_columns;
+    guint32 *pixels = (guint32 *) (data + (gsize) row * stride);
+
+    for (column = 0; column < priv->density_columns; column++)
+    {
+      gdouble value;
+
+      if (counts[column] == 0)
+      {
+        pixels[column] = 0;
+        continue;
+      }
+
+      if (priv->density_scale == GDV_DENSITY_SCALE_LOG)
+        value = log1p ((gdouble) counts[column]) / norm;
+      else
+        value = (gdouble) counts[column] / norm;
+
+      level = (guint) (value * (GDV_LAYER_CONTENT_DENSITY_LEVELS - 1) + 0.5);
+      pixels[column] = table[MIN (level, GDV_LAYER_CONTENT_DENSITY_LEVELS - 1)];
+    }
+  }
+
+  cairo_surface_mark_dirty (priv->density_image);
+
+  cairo_save (cr);
+
+  cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+  cairo_scale (cr, priv->density_block, priv->density_block);
+  cairo_set_source_surface (cr, priv->density_image, 0.0, 0.0);
+
+  pattern = cairo_get_source (cr);
+  cairo_pattern_set_filter (pattern, CAIRO_FILTER_NEAREST);
+  cairo_pattern_set_extend (pattern, CAIRO_EXTEND_NONE);
+
+  cairo_paint (cr);
+
+  cairo_restore (cr);
+}
+
+/* Counts the samples from the logical index first up to the newest one into
+ * the blocks of the density-mode and paints all counts again. If first is 0,
+ * counting starts anew. */
+static void
+_gdv_layer_content_render_density (GdvLayerContent     *content,
+                                   cairo_t             *cr,
+                                   const GtkAllocation *allocation,
+                                   gsize                first)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  GdvLayer *layer;
+  gint columns, rows;
+  gsize i, n_points;
+
+  columns = MAX ((allocation->width + (gint) priv->density_block - 1) /
+                 (gint) priv->density_block, 1);
+  rows = MAX ((allocation->height + (gint) priv->density_block - 1) /
+              (gint) priv->density_block, 1);
+
+  if (first == 0 || !priv->density_counts ||
+      priv->density_columns != columns || priv->density_rows != rows)
+  {
+    g_free (priv->density_counts);
+    priv->density_counts = g_new0 (guint32, (gsize) columns * rows);
+    priv->density_columns = columns;
+    priv->density_rows = rows;
+    priv->density_max = 0;
+    first = 0;
+  }
+
+  /* the counts are complete for all samples, the surface is drawn with */
+  priv->cache_continuable = TRUE;
+  priv->cache_has_last = FALSE;
+
+  n_points = priv->n_points - first;
+  layer = GDV_LAYER (gtk_widget_get_parent (GTK_WIDGET (content)));
+
+  if (first == 0 && n_points > 0)
+    _gdv_layer_content_visible_range (priv, layer, allocation,
+                                      &first, &n_points);
+
+  if (n_points > 0)
+    _gdv_layer_content_evaluate (priv, layer, first, n_points);
+
+  for (i = 0; i < n_points; i++)
+  {
+    gdouble block_x, block_y;
+    guint32 *count;
+
+    if (!_gdv_layer_content_pixel_in_range (priv, i))
+      continue;
+
+    block_x = floor ((priv->pixel_x[i] - allocation->x) / priv->density_block);
+    block_y = floor ((priv->pixel_y[i] - allocation->y) / priv->density_block);
+
+    /* this also drops NAN */
+    if (!(block_x >= 0.0 && block_x < columns &&
+          block_y >= 0.0 && block_y < rows))
+      continue;
+
+    count = &priv->density_counts[(gsize) block_y * columns + (gsize) block_x];
+    if (*count < G_MAXUINT32)
+      (*count)++;
+
+    priv->density_max = MAX (priv->density_max, *count);
+  }
+
+  _gdv_layer_content_paint_density (content, cr);
+}
+
+/* Renders the samples like they are taken by _gdv_layer_content_prepare() */
+static void
+_gdv_layer_content_render (GdvLayerContent     *content,
+                           cairo_t             *cr,
+                           const GtkAllocation *allocation,
+                           const GdkRectangle  *area,
+                           gdouble              offset_x,
+                           gsize                first)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  GdvDataStyle style;
+  gboolean continued;
+  gsize n_visible;
+
+  if (priv->render_mode == GDV_RENDER_MODE_DENSITY)
+  {
+    _gdv_layer_content_render_density (content, cr, allocation, first);
+    return;
+  }
+
+  continued = first > 0 && priv->cache_has_last;
+
+  n_visible = _gdv_layer_content_prepare (content, allocation, area,
+                                          offset_x, first);
+
+  if (n_visible == 0)
+    return;
+
+  _gdv_data_style_resolve (gtk_widget_get_style_context (GTK_WIDGET (content)),
+                           &style);
+  style.point_type = priv->point_style;
+
+  /* a dash-pattern would start anew with the appended samples */
+  if (style.n_dashes > 0)
+    priv->cache_continuable = FALSE;
+
+  /* the point, that the line continues from, already has its symbol */
+  if (continued && style.point_width)
+  {
+    _gdv_marker_render_points (cr, style.point_type, style.point_width,
+                               &style.point_color,
+                               priv->pixel_x + 1, priv->pixel_y + 1,
+                               n_visible - 1);
+    style.point_width = 0.0;
+  }
+
+  _gdv_render_data_polyline_styled (&style, cr,
+                                    priv->pixel_x, priv->pixel_y, n_visible);
+
+  priv->cache_has_last = TRUE;
+  priv->cache_last_x = priv->pixel_x[n_visible - 1];
+  priv->cache_last_y = priv->pixel_y[n_visible - 1];
+}
+
+/* Clears the columns from x_beg to x_end of the surface and renders them
+ * again; the columns are given in coordinates of the surface. */
+static void
+_gdv_layer_content_render_columns (GdvLayerContent     *content,
+                                   cairo_t             *cr,
+                                   const GtkAllocation *allocation,
+                                   gdouble              offset_x,
+                                   gdouble              x_beg,
+                                   gdouble              x_end)
+{
+  GdkRectangle area;
+
+  if (x_end <= x_beg)
+    return;
+
+  cairo_save (cr);
+
+  cairo_rectangle (cr, x_beg, 0.0, x_end - x_beg, allocation->height);
+  cairo_clip (cr);
+
+  cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+  cairo_paint (cr);
+  cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+
+  area.x = allocation->x + (gint) floor (x_beg - offset_x);
+  area.y = allocation->y;
+  area.width = (gint) ceil (x_end - x_beg) + 1;
+  area.height = allocation->height;
+
+  _gdv_layer_content_render (content, cr, allocation, &area, offset_x, 0);
+
+  cairo_restore (cr);
+}
+
+/* Gives the distance in pixels, the axes were translated along x since the
+ * surface was rendered. Any other change of the axes gives FALSE. */
+static gboolean
+_gdv_layer_content_strip_delta (GdvLayerContentPrivate *priv,
+                                gdouble                *delta)
+{
+  const gdouble *now = (const gdouble *) priv->translations->data;
+  const gdouble *then = (const gdouble *) priv->cache_translations->data;
+  gboolean found = FALSE;
+  guint i;
+
+  *delta = 0.0;
+
+  if (priv->translations->len != priv->cache_translations->len)
+    return FALSE;
+
+  for (i = 0; i < priv->translations->len; i += 2)
+  {
+    if (fabs (now[i + 1] - then[i + 1]) > GDV_LAYER_CONTENT_STRIP_TOLERANCE)
+      return FALSE;
+
+    if (isnan (now[i]) || isnan (then[i]))
+    {
+      if (isnan (now[i]) != isnan (then[i]))
+        return FALSE;
+
+      continue;
+    }
+
+    /* all axes along x have to move together */
+    if (found &&
+        fabs (now[i] - then[i] - *delta) > GDV_LAYER_CONTENT_STRIP_TOLERANCE)
+      return FALSE;
+
+    *delta = now[i] - then[i];
+    found = TRUE;
+  }
+
+  return TRUE;
+}
+
+/* Brings the offscreen-surface of a strip-chart up to date, without rendering
+ * it from scratch. The image is moved by the whole pixels, the axes scrolled
+ * since; the uncovered columns and the ones of appended samples are rendered
+ * with the remaining fraction of a pixel as offset. Gives FALSE, if this is
+ * not possible. */
+static gboolean
+_gdv_layer_content_scroll_cache (GdvLayerContent     *content,
+                                 cairo_t             *cache_cr,
+                                 const GtkAllocation *allocation)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  GdvLayer *layer;
+  gdouble delta, shift, offset_x, width, append_x;
+  gint shift_pix, surface_width, surface_height, bytes, row;
+  guint64 end_seq = priv->head_seq + priv->n_points;
+  gboolean appended, evicted;
+  guint i;
+
+  /* the counts of the density-mode do not move with the image */
+  if (priv->render_mode != GDV_RENDER_MODE_LINES ||
+      !_gdv_layer_content_strip_delta (priv, &delta))
+    return FALSE;
+
+  layer = GDV_LAYER (gtk_widget_get_parent (GTK_WIDGET (content)));
+
+  shift_pix = (gint) round (delta * priv->cache_scale);
+  shift = (gdouble) shift_pix / priv->cache_scale;
+  offset_x = shift - delta;
+  width = (gdouble) allocation->width;
+
+  surface_width = cairo_image_surface_get_width (priv->cache);
+  surface_height = cairo_image_surface_get_height (priv->cache);
+
+  appended = priv->cache_end_seq < end_seq;
+  evicted = priv->cache_head_seq != priv->head_seq;
+
+  /* the line may only be extended to the right, and evicted samples must
+   * have left the plot */
+  if (ABS (shift_pix) >= surface_width ||
+      ((appended || evicted) && !_gdv_layer_content_is_x_ordered (priv)) ||
+      (evicted && priv->n_points > 0 &&
+       !(_gdv_layer_content_pixel_x (priv, layer, 0) <= allocation->x)))
+    return FALSE;
+
+  /* where the samples, rendered last time, end */
+  append_x = width;
+  if (appended && priv->cache_end_seq > priv->head_seq)
+    append_x = _gdv_layer_content_pixel_x (
+                 priv, layer, priv->cache_end_seq - priv->head_seq - 1) -
+               allocation->x + offset_x - GDV_LAYER_CONTENT_STRIP_MARGIN;
+  else if (appended)
+    append_x = 0.0;
+
+  if (!isfinite (append_x) || append_x < 0.0)
+    append_x = 0.0;
+
+  if (shift_pix != 0)
+  {
+    guchar *data;
+    gint stride;
+
+    cairo_surface_flush (priv->cache);
+
+    data = cairo_image_surface_get_data (priv->cache);
+    stride = cairo_image_surface_get_stride (priv->cache);
+    bytes = 4 * (surface_width - ABS (shift_pix));
+
+    for (row = 0; row < surface_height; row++)
+    {
+      guchar *line = data + (gsize) row * stride;
+
+      if (shift_pix > 0)
+        memmove (line + 4 * shift_pix, line, bytes);
+      else
+        memmove (line, line - 4 * shift_pix, bytes);
+    }
+
+    cairo_surface_mark_dirty (priv->cache);
+
+    /* the image now shows the axes translated by shift */
+    for (i = 0; i < priv->cache_translations->len; i += 2)
+      g_array_index (priv->cache_translations, gdouble, i) += shift;
+  }
+
+  if (shift_pix > 0)
+    _gdv_layer_content_render_columns (content, cache_cr, allocation,
+                                       offset_x, 0.0, MIN (shift, append_x));
+  else if (shift_pix < 0)
+    append_x = MIN (append_x, width + shift);
+
+  _gdv_layer_content_render_columns (content, cache_cr, allocation,
+                                     offset_x, append_x, width);
+
+  return TRUE;
+}
+
+/* Compares two keys of the surface entry by entry */
+static gboolean
+_gdv_layer_content_keys_equal (GArray *key_a,
+                               GArray *key_b)
+{
+  guint i;
+
+  if (key_a->len != key_b->len)
+    return FALSE;
+
+  for (i = 0; i < key_a->len; i++)
+  {
+    const GdvLayerContentKeyEntry *entry_a =
+      &g_array_index (key_a, GdvLayerContentKeyEntry, i);
+    const GdvLayerContentKeyEntry *entry_b =
+      &g_array_index (key_b, GdvLayerContentKeyEntry, i);
+
+    if (entry_a->object != entry_b->object ||
+        entry_a->serial != entry_b->serial ||
+        entry_a->visible != entry_b->visible)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+static void
+_gdv_layer_content_copy_key (GArray *dest,
+                             GArray *src)
+{
+  g_array_set_size (dest, 0);
+  g_array_append_vals (dest, src->data, src->len);
+}
+
+/* TRUE, if the rendering on the worker-threads is still what the surface
+ * needs; appended or evicted samples are handled once it is done */
+static gboolean
+_gdv_layer_content_job_matches (GdvLayerContentPrivate *priv,
+                                const GtkAllocation    *allocation,
+                                GArray                 *key,
+                                gboolean                strip_chart,
+                                gint                    scale)
+{
+  const GdvLayerContentJobState *state = &priv->job_state;
+
+  return _gdv_layer_content_keys_equal (state->key, key) &&
+         state->strip_chart == strip_chart &&
+         state->scale == scale &&
+         state->allocation.x == allocation->x &&
+         state->allocation.y == allocation->y &&
+         state->allocation.width == allocation->width &&
+         state->allocation.height == allocation->height;
+}
+
+/* Takes the tiles of a finished job as the new image */
+static void
+_gdv_layer_content_job_done (GdvTileJob *job,
+                             gpointer    user_data)
+{
+  GdvLayerContent *content = user_data;
+  GdvLayerContentPrivate *priv = content->priv;
+  GdvLayerContentJobState *state = &priv->job_state;
+  cairo_t *cache_cr;
+
+  cache_cr = cairo_create (priv->cache);
+
+  cairo_set_operator (cache_cr, CAIRO_OPERATOR_CLEAR);
+  cairo_paint (cache_cr);
+  cairo_set_operator (cache_cr, CAIRO_OPERATOR_OVER);
+
+  _gdv_tile_job_composite (job, cache_cr);
+
+  cairo_destroy (cache_cr);
+
+  priv->cache_valid = TRUE;
+  priv->cache_allocation = state->allocation;
+  priv->cache_scale = state->scale;
+  _gdv_layer_content_copy_key (priv->cache_key, state->key);
+  priv->cache_strip_chart = state->strip_chart;
+  priv->cache_head_seq = state->head_seq;
+  priv->cache_end_seq = state->end_seq;
+  priv->cache_continuable = state->continuable;
+  priv->cache_has_last = state->has_last;
+  priv->cache_last_x = state->last_x;
+  priv->cache_last_y = state->last_y;
+
+  g_array_set_size (priv->cache_translations, 0);
+  g_array_append_vals (priv->cache_translations,
+                       state->translations->data,
+                       state->translations->len);
+
+  g_clear_pointer (&priv->job, _gdv_tile_job_unref);
+
+  gtk_widget_queue_draw (GTK_WIDGET (content));
+}
+
+/* Starts to render the whole surface on the worker-threads; gives FALSE, if
+ * it is rendered on the main-thread instead */
+static gboolean
+_gdv_layer_content_start_job (GdvLayerContent     *content,
+                              const GtkAllocation *allocation,
+                              GArray              *key,
+                              gboolean             strip_chart,
+                              gint                 scale)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  GdvLayerContentJobState *state = &priv->job_state;
+  GdvDataStyle style;
+  gboolean has_last, continuable, ordered;
+  gdouble *px, *py;
+  gsize n_visible;
+
+  /* the counts of the density-mode are cheap on the main-thread */
+  if (priv->render_mode != GDV_RENDER_MODE_LINES)
+    return FALSE;
+
+  /* the samples are not mapped twice, if the job does not pay off anyway */
+  if (priv->n_points < GDV_LAYER_CONTENT_THREADED_MIN)
+    return FALSE;
+
+  _gdv_data_style_resolve (gtk_widget_get_style_context (GTK_WIDGET (content)),
+                           &style);
+  style.point_type = priv->point_style;
+
+  /* a dash-pattern would start anew in every tile */
+  if (style.n_dashes > 0)
+    return FALSE;
+
+  /* the current image stays valid for appending, until the job is done */
+  has_last = priv->cache_has_last;
+  continuable = priv->cache_continuable;
+
+  n_visible = _gdv_layer_content_prepare (content, allocation, allocation,
+                                          0.0, 0);
+
+  state->continuable = priv->cache_continuable;
+  priv->cache_has_last = has_last;
+  priv->cache_continuable = continuable;
+
+  if (n_visible < GDV_LAYER_CONTENT_THREADED_MIN)
+    return FALSE;
+
+  ordered = _gdv_layer_content_is_x_ordered (priv) &&
+            priv->pixel_x[0] <= priv->pixel_x[n_visible - 1];
+
+  _gdv_layer_content_copy_key (state->key, key);
+  state->allocation = *allocation;
+  state->scale = scale;
+  state->strip_chart = strip_chart;
+  state->head_seq = priv->head_seq;
+  state->end_seq = priv->head_seq + priv->n_points;
+  state->has_last = TRUE;
+  state->last_x = priv->pixel_x[n_visible - 1];
+  state->last_y = priv->pixel_y[n_visible - 1];
+
+  g_array_set_size (state->translations, 0);
+  g_array_append_vals (state->translations,
+                       priv->translations->data,
+                       priv->translations->len);
+
+  /* the workers get copies, the scratch-buffers are reused meanwhile */
+  px = g_new (gdouble, n_visible);
+  py = g_new (gdouble, n_visible);
+  memcpy (px, priv->pixel_x, n_visible * sizeof (gdouble));
+  memcpy (py, priv->pixel_y, n_visible * sizeof (gdouble));
+
+  priv->job = _gdv_tile_job_new (&style, px, py, n_visible, ordered,
+                                 allocation->width, allocation->height,
+                                 scale);
+
+  _gdv_tile_job_start (priv->job, _gdv_layer_content_job_done, content);
+
+  return TRUE;
+}
+
+/* Brings the offscreen-surface up to date; only appended samples are
+ * rendered, if nothing else has changed. */
+static void
+_gdv_layer_content_update_cache (GdvLayerContent     *content,
+                                 const GtkAllocation *allocation,
+                                 GArray              *key,
+                                 gboolean             strip_chart)
+{
+  GdvLayerContentPrivate *priv = content->priv;
+  GtkWidget *widget = GTK_WIDGET (content);
+  guint64 end_seq = priv->head_seq + priv->n_points;
+  gint scale = gtk_widget_get_scale_factor (widget);
+  gboolean full;
+  cairo_t *cache_cr;
+
+  if (!priv->cache ||
+      priv->cache_scale != scale ||
+      priv->cache_allocation.width != allocation->width ||
+      priv->cache_allocation.height != allocation->height)
+    {
+      g_clear_pointer (&priv->cache, cairo_surface_destroy);
+      priv->cache = gdk_window_create_similar_image_surface (
+                      gtk_widget_get_window (widget),
+                      CAIRO_FORMAT_ARGB32,
+                      MAX (allocation->width, 1),
+                      MAX (allocation->height, 1),
+                      scale);
+      priv->cache_valid = FALSE;
+      priv->cache_allocation = *allocation;
+      priv->cache_scale = scale;
+    }
+
+  /* the last complete image stays, until the job is done */
+  if (priv->job)
+  {
+    if (_gdv_layer_content_job_matches (priv, allocation, key, strip_chart,
+                                        scale))
+      return;
 
-  gtk_widget_set_name (widget, "new layer");
+    _gdv_layer_content_cancel_job (priv);
+  }
 
-  /* initializing style-properties */
-  css_provider = gtk_css_provider_new ();
-  style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
+  full = !priv->cache_valid ||
+         !_gdv_layer_content_keys_equal (priv->cache_key, key) ||
+         priv->cache_strip_chart != strip_chart ||
+         priv->cache_allocation.x != allocation->x ||
+         priv->cache_allocation.y != allocation->y ||
+         priv->cache_end_seq > end_seq;
 
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+  if (!full && !strip_chart)
+    full = priv->cache_head_seq != priv->head_seq ||
+           (priv->cache_end_seq < end_seq && !priv->cache_continuable);
 
-  gtk_widget_set_can_focus (GTK_WIDGET (content), TRUE);
-  gtk_widget_set_receives_default (GTK_WIDGET (content), TRUE);
-  gtk_widget_set_has_window (GTK_WIDGET (content), FALSE);
+  if (!full && !strip_chart && priv->cache_end_seq == end_seq)
+    return;
 
-  content->priv = gdv_layer_content_get_instance_private (content);
+  cache_cr = cairo_create (priv->cache);
 
-  content->priv->event_win = NULL;
+  if (!full && strip_chart)
+    full = !_gdv_layer_content_scroll_cache (content, cache_cr, allocation);
+  else if (!full)
+    _gdv_layer_content_render (content, cache_cr, allocation, allocation,
+                               0.0, priv->cache_end_seq - priv->head_seq);
 
-  content->priv->point_width = 3;
-  content->priv->point_line_width = 0;
-  content->priv->point_style = 0;
-  content->priv->point_source = cairo_pattern_create_rgba (0, 0, 0, 1);
-  content->priv->point_fill = TRUE;
-  content->priv->point_fill_source = NULL;
+  if (full && priv->threaded &&
+      _gdv_layer_content_start_job (content, allocation, key, strip_chart,
+                                    scale))
+  {
+    cairo_destroy (cache_cr);
+    return;
+  }
 
-  content->priv->title = g_strdup ("new data\0");
-  content->priv->show_in_legend = TRUE;
+  if (full)
+    {
+      cairo_set_operator (cache_cr, CAIRO_OPERATOR_CLEAR);
+      cairo_paint (cache_cr);
+      cairo_set_operator (cache_cr, CAIRO_OPERATOR_OVER);
 
-  content->priv->line_source = cairo_pattern_create_rgba (0, 0, 0, 1);
-  content->priv->line_style = 1;
+      _gdv_layer_content_render (content, cache_cr, allocation, allocation,
+                                 0.0, 0);
 
-  content->priv->layer_min = g_new (GdvDataPoint, 1);
-  content->priv->layer_max = g_new (GdvDataPoint, 1);
+      g_array_set_size (priv->cache_translations, 0);
+      g_array_append_vals (priv->cache_translations,
+                           priv->translations->data,
+                           priv->translations->len);
+    }
 
-  content->priv->layer_max->x = NAN;
-  content->priv->layer_max->y = NAN;
-  content->priv->layer_max->z = NAN;
+  cairo_destroy (cache_cr);
 
-  content->priv->layer_min->x = NAN;
-  content->priv->layer_min->y = NAN;
-  content->priv->layer_min->z = NAN;
-  content->priv->content = NULL;
+  priv->cache_valid = TRUE;
+  priv->cache_allocation = *allocation;
+  priv->cache_scale = scale;
+  _gdv_layer_content_copy_key (priv->cache_key, key);
+  priv->cache_strip_chart = strip_chart;
+  priv->cache_head_seq = priv->head_seq;
+  priv->cache_end_seq = end_seq;
 }
 
 static gboolean
 gdv_layer_content_on_draw (GtkWidget    *widget,
                            cairo_t      *cr)
 {
-  gboolean first_point;
-  gdouble prev_pixel_x = 0.0, prev_pixel_y = 0.0;
-  GtkStyleContext *context;
   GtkAllocation allocation;
-
   GdvLayerContent *content;
-  gsize i;
-
-  first_point = TRUE;
+  GdvLayer *layer;
+  GdvLayerContentKeyEntry entry;
+  gboolean strip_chart;
 
   g_return_val_if_fail (GDV_LAYER_IS_CONTENT (widget), FALSE);
 
-  context = gtk_widget_get_style_context (widget);
-
   gtk_widget_get_allocation (widget, &allocation);
 
   content = GDV_LAYER_CONTENT (widget);
+  layer = GDV_LAYER (gtk_widget_get_parent (widget));
+
+  strip_chart = GDV_TWOD_IS_LAYER (layer) &&
+                gdv_twod_layer_get_strip_chart (GDV_TWOD_LAYER (layer));
+
+  g_array_set_size (content->priv->translations, 0);
+
+  /* the mapping of the samples depends on the layer and on all its axes; the
+   * serial of the layer also changes, if an axis is replaced by another one
+   * at the same address */
+  g_array_set_size (content->priv->key, 0);
+
+  entry.object = layer;
+  entry.serial = _gdv_layer_get_mapping_serial (layer);
+  entry.visible = TRUE;
+  g_array_append_val (content->priv->key, entry);
 
   {
-    GList *orig_axes_list, *local_axes_list;
+    GdvAxis **axes;
+    guint n_axes, i;
 
-    orig_axes_list =
-      gdv_layer_get_axis_list (GDV_LAYER (gtk_widget_get_parent (widget)));
+    axes = gdv_layer_peek_axes (layer, &n_axes);
 
-    for (local_axes_list = orig_axes_list;
-         local_axes_list; local_axes_list = local_axes_list->next)
+    for (i = 0; i < n_axes; i++)
     {
-      gboolean resize_axis = _gdv_axis_get_resize_during_redraw(local_axes_list->data);
+      GdvAxis *axis = axes[i];
+      guint serial;
 
-      if (resize_axis)
+      /* in strip-chart mode, translations are handled apart from the key */
+      if (strip_chart)
       {
-        gtk_widget_queue_resize (GTK_WIDGET (widget));
-        return FALSE;
-      }
-    }
-
-    g_list_free (orig_axes_list);
-  }
+        gdouble translation[2];
 
-  if (content->priv->content == NULL)
-    return TRUE;
+        serial = _gdv_axis_get_geometry_serial (axis, &translation[0],
+                                                &translation[1]);
 
-  {
-    gdouble tmp_x, tmp_y;
-    gdouble tmp_x2, tmp_y2;
-
-    gdv_layer_evaluate_data_point (GDV_LAYER (gtk_widget_get_parent (widget)),
-                                   0.0,
-                                   0.0,
-                                   0.0,
-                                   &tmp_x,
-                                   &tmp_y);
-    gdv_layer_evaluate_data_point (GDV_LAYER (gtk_widget_get_parent (widget)),
-                                   100.0,
-                                   100.0,
-                                   100.0,
-                                   &tmp_x2,
-                                   &tmp_y2);
-  }
+        if (_gdv_axis_get_transform (axis)->slope_x == 0.0)
+          translation[0] = NAN;
 
-  for (i = 0;
-       i < content->priv->content->size2;
-       i++)
-  {
-    GdvLayer *layer = GDV_LAYER (gtk_widget_get_parent (widget));
-    gboolean paint_point;
-    gdouble pixel_x, pixel_y;
-
-    paint_point =
-      gdv_layer_evaluate_data_point (layer,
-                                     gsl_matrix_get(content->priv->content, 0, i),
-                                     gsl_matrix_get(content->priv->content, 1, i),
-                                     gsl_matrix_get(content->priv->content, 2, i),
-                                     &pixel_x,
-                                     &pixel_y);
-
-    /* skip data-points outside the range of the layer */
-    if (!paint_point)
-      continue;
+        g_array_append_vals (content->priv->translations, translation, 2);
+      }
+      else
+        serial = _gdv_axis_get_transform_serial (axis);
 
-    if (((pixel_x != prev_pixel_x) || (pixel_y != prev_pixel_y)))
-    {
-      gdv_render_data_point (
-        context,
-        cr,
-        pixel_x - (gdouble) allocation.x,
-        pixel_y - (gdouble) allocation.y);
-
-      if (!first_point)
-        gdv_render_data_line (
-          context,
-          cr,
-          prev_pixel_x - (gdouble) allocation.x,
-          prev_pixel_y - (gdouble) allocation.y,
-          pixel_x - (gdouble) allocation.x,
-          pixel_y - (gdouble) allocation.y);
+      entry.object = axis;
+      entry.serial = serial;
+      entry.visible = gtk_widget_get_visible (GTK_WIDGET (axis));
+      g_array_append_val (content->priv->key, entry);
     }
+  }
 
-    first_point = FALSE;
+  _gdv_layer_content_update_cache (content, &allocation, content->priv->key,
+                                   strip_chart);
 
-    prev_pixel_x = pixel_x;
-    prev_pixel_y = pixel_y;
-  }
+  cairo_set_source_surface (cr, content->priv->cache, 0.0, 0.0);
+  cairo_paint (cr);
 
   return TRUE;
 }
 
+static void
+gdv_layer_content_style_updated (GtkWidget *widget)
+{
+  GTK_WIDGET_CLASS (gdv_layer_content_parent_class)->style_updated (widget);
+
+  _gdv_layer_content_invalidate_cache (GDV_LAYER_CONTENT (widget)->priv);
+  gtk_widget_queue_draw (widget);
+}
+
 static void
 gdv_layer_content_dispose (GObject *object)
 {
+  _gdv_layer_content_cancel_job (GDV_LAYER_CONTENT (object)->priv);
+
   G_OBJECT_CLASS (gdv_layer_content_parent_class)->dispose (object);
 }
 
 static void
 gdv_layer_content_finalize (GObject *object)
 {
+  GdvLayerContent *content = GDV_LAYER_CONTENT (object);
+
+  guint column, level;
+
+  g_clear_pointer (&content->priv->data, g_free);
+
+  for (column = 0; column < GDV_LAYER_CONTENT_MIN_COLUMNS; column++)
+    {
+      g_clear_pointer (&content->priv->min_deques[column].items, g_free);
+      g_clear_pointer (&content->priv->max_deques[column].items, g_free);
+    }
+
+  g_clear_pointer (&content->priv->pixel_x, g_free);
+  g_clear_pointer (&content->priv->pixel_y, g_free);
+  g_clear_pointer (&content->priv->in_range, g_free);
+
+  for (level = 0; level < GDV_LAYER_CONTENT_LOD_LEVELS; level++)
+    g_clear_pointer (&content->priv->lod_levels[level].buckets, g_free);
+  g_clear_pointer (&content->priv->lod_samples, g_free);
+  g_clear_pointer (&content->priv->cache, cairo_surface_destroy);
+  g_clear_pointer (&content->priv->cache_translations, g_array_unref);
+  g_clear_pointer (&content->priv->translations, g_array_unref);
+  g_clear_pointer (&content->priv->job_state.translations, g_array_unref);
+  g_clear_pointer (&content->priv->key, g_array_unref);
+  g_clear_pointer (&content->priv->cache_key, g_array_unref);
+  g_clear_pointer (&content->priv->job_state.key, g_array_unref);
+  g_clear_pointer (&content->priv->density_counts, g_free);
+  g_clear_pointer (&content->priv->density_image, cairo_surface_destroy);
+
+  g_clear_pointer (&content->priv->layer_min, g_free);
+  g_clear_pointer (&content->priv->layer_max, g_free);
+  g_clear_pointer (&content->priv->title, g_free);
+
   G_OBJECT_CLASS (gdv_layer_content_parent_class)->finalize (object);
 }
 
@@ -460,6 +2552,7 @@ gdv_layer_content_class_init (GdvLayerContentClass *klass)
 
   widget_class->size_allocate = gdv_layer_content_size_allocate;
   widget_class->draw = gdv_layer_content_on_draw;
+  widget_class->style_updated = gdv_layer_content_style_updated;
 
   gtk_widget_class_set_css_name (widget_class, "layercontent");
 
@@ -508,7 +2601,9 @@ gdv_layer_content_class_init (GdvLayerContentClass *klass)
   /**
    * GdvLayerContent:point-type:
    *
-   * The style-type to plot a point.
+   * The symbol to plot a point; takes a #GdvPointType. Unknown values are
+   * drawn as circles. The size and the color of the symbol are given by the
+   * style-properties point-width and point-color.
    */
   layer_content_properties[PROP_POINT_TYPE] =
     g_param_spec_uint ("point-type",
@@ -584,6 +2679,117 @@ gdv_layer_content_class_init (GdvLayerContentClass *klass)
                           FALSE,
                           G_PARAM_READWRITE);
 
+  /**
+   * GdvLayerContent:max-points:
+   *
+   * Limits the content to the given number of data-points. If more points are
+   * added, the oldest ones are dropped. A value of 0 disables the limit.
+   */
+  layer_content_properties[PROP_MAX_POINTS] =
+    g_param_spec_uint ("max-points",
+                       "maximum number of data-points",
+                       "limits the content to the newest data-points; 0 "
+                       "means no limit",
+                       0,
+                       G_MAXUINT,
+                       0,
+                       G_PARAM_READWRITE);
+
+  /**
+   * GdvLayerContent:window-span:
+   *
+   * Limits the content to the data-points, whose x-value is at most this span
+   * below the x-value of the newest data-point. A value of 0 disables the
+   * limit.
+   */
+  layer_content_properties[PROP_WINDOW_SPAN] =
+    g_param_spec_double ("window-span",
+                         "span of the sliding window",
+                         "limits the content to the data-points within this "
+                         "x-range from the newest data-point; 0 means no limit",
+                         0.0,
+                         G_MAXDOUBLE,
+                         0.0,
+                         G_PARAM_READWRITE);
+
+  /**
+   * GdvLayerContent:level-of-detail:
+   *
+   * Maintains a min/max-pyramid of the y-values, so that only a few
+   * data-points per pixel-column have to be drawn for very long series. This
+   * is meant for time-series within a #GdvTwodLayer, where the x-values are
+   * increasing; otherwise all data-points are drawn.
+   */
+  layer_content_properties[PROP_LEVEL_OF_DETAIL] =
+    g_param_spec_boolean ("level-of-detail",
+                          "level of detail",
+                          "draw long series from a min/max pyramid",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  /**
+   * GdvLayerContent:threaded-rendering:
+   *
+   * Renders very many visible data-points in tiles on a pool of
+   * worker-threads instead of the main-thread. Until the new image is
+   * complete, the previous one is shown. Dashed lines are always rendered on
+   * the main-thread, since the pattern would not continue across the tiles.
+   */
+  layer_content_properties[PROP_THREADED_RENDERING] =
+    g_param_spec_boolean ("threaded-rendering",
+                          "threaded rendering",
+                          "render large contents on worker-threads",
+                          FALSE,
+                          G_PARAM_READWRITE);
+
+  /**
+   * GdvLayerContent:render-mode:
+   *
+   * Decides, whether the data-points are drawn as symbols and lines or as a
+   * density-map; takes a #GdvRenderMode. In density-mode, neither
+   * #GdvLayerContent:level-of-detail nor #GdvLayerContent:threaded-rendering
+   * are used, since every data-point has to be counted.
+   */
+  layer_content_properties[PROP_RENDER_MODE] =
+    g_param_spec_uint ("render-mode",
+                       "render mode",
+                       "draw symbols and lines or a density-map",
+                       GDV_RENDER_MODE_LINES,
+                       GDV_RENDER_MODE_DENSITY,
+                       GDV_RENDER_MODE_LINES,
+                       G_PARAM_READWRITE);
+
+  /**
+   * GdvLayerContent:density-block-size:
+   *
+   * The edge-length of the square blocks of pixels, whose data-points are
+   * counted together in density-mode.
+   */
+  layer_content_properties[PROP_DENSITY_BLOCK_SIZE] =
+    g_param_spec_uint ("density-block-size",
+                       "size of a density-block",
+                       "edge-length of the blocks of pixels, that are counted "
+                       "together in density-mode",
+                       1,
+                       256,
+                       1,
+                       G_PARAM_READWRITE);
+
+  /**
+   * GdvLayerContent:density-scale:
+   *
+   * Maps the counts of the blocks onto their opacity in density-mode; takes
+   * a #GdvDensityScale.
+   */
+  layer_content_properties[PROP_DENSITY_SCALE] =
+    g_param_spec_uint ("density-scale",
+                       "scale of the density-map",
+                       "linear or logarithmic mapping of the counts",
+                       GDV_DENSITY_SCALE_LINEAR,
+                       GDV_DENSITY_SCALE_LOG,
+                       GDV_DENSITY_SCALE_LOG,
+                       G_PARAM_READWRITE);
+
   g_object_class_install_properties (object_class,
                                      N_PROPERTIES,
                                      layer_content_properties);
@@ -723,35 +2929,354 @@ gdv_layer_content_add_data_point (GdvLayerContent *layer_content,
                                   gdouble          y_value,
                                   gdouble          z_value)
 {
-  gsize rows;
+  g_return_if_fail (GDV_LAYER_IS_CONTENT (layer_content));
+
+  _gdv_layer_content_append (layer_content->priv, x_value, y_value, z_value);
+
+  g_object_notify (G_OBJECT (layer_content), "data-point");
+}
+
+/* copies n values with a distance of stride from src into dest, or zeros if
+ * src is NULL */
+static void
+_gdv_layer_content_copy_strided (gdouble       *dest,
+                                 const gdouble *src,
+                                 gsize          n,
+                                 gsize          stride)
+{
+  gsize i;
+
+  if (src == NULL)
+    memset (dest, 0, n * sizeof (gdouble));
+  else if (stride == 1)
+    memcpy (dest, src, n * sizeof (gdouble));
+  else
+    for (i = 0; i < n; i++)
+      dest[i] = src[i * stride];
+}
+
+/* determines minimum and maximum of a contiguous array in a single pass;
+ * NAN-values are ignored */
+static void
+_gdv_layer_content_array_bounds (const gdouble *values,
+                                 gsize          n,
+                                 gdouble       *min,
+                                 gdouble       *max)
+{
+  gdouble local_min = G_MAXDOUBLE, local_max = -G_MAXDOUBLE;
+  gsize i;
+
+  for (i = 0; i < n; i++)
+    {
+      local_min = values[i] < local_min ? values[i] : local_min;
+      local_max = values[i] > local_max ? values[i] : local_max;
+    }
+
+  *min = fmin (*min, local_min);
+  *max = fmax (*max, local_max);
+}
+
+/* appends a block of samples to a content without a sliding window, where
+ * the samples always start at the front of the columns */
+static void
+_gdv_layer_content_append_block (GdvLayerContentPrivate *priv,
+                                 const gdouble          *x_values,
+                                 const gdouble          *y_values,
+                                 const gdouble          *z_values,
+                                 gsize                   n_points,
+                                 gsize                   stride)
+{
+  const gdouble *sources[GDV_LAYER_CONTENT_MIN_COLUMNS];
+  gsize index;
+  guint column;
+
+  sources[0] = x_values;
+  sources[1] = y_values;
+  sources[2] = z_values;
+
+  index = priv->n_points;
+  _gdv_layer_content_ensure_capacity (priv, index + n_points);
+
+  for (column = 0; column < priv->n_columns; column++)
+    _gdv_layer_content_copy_strided (
+      _gdv_layer_content_column (priv, column) + index,
+      column < GDV_LAYER_CONTENT_MIN_COLUMNS ? sources[column] : NULL,
+      n_points,
+      stride);
+
+  _gdv_layer_content_array_bounds (_gdv_layer_content_column (priv, 0) + index,
+                                   n_points,
+                                   &priv->layer_min->x,
+                                   &priv->layer_max->x);
+  _gdv_layer_content_array_bounds (_gdv_layer_content_column (priv, 1) + index,
+                                   n_points,
+                                   &priv->layer_min->y,
+                                   &priv->layer_max->y);
+  _gdv_layer_content_array_bounds (_gdv_layer_content_column (priv, 2) + index,
+                                   n_points,
+                                   &priv->layer_min->z,
+                                   &priv->layer_max->z);
+
+  if (priv->lod)
+    {
+      const gdouble *y_column = _gdv_layer_content_column (priv, 1);
+      gsize i;
+
+      for (i = index; i < index + n_points; i++)
+        _gdv_layer_content_lod_push (priv, priv->head_seq + i, y_column[i]);
+    }
+
+  {
+    const gdouble *x_column = _gdv_layer_content_column (priv, 0);
+    gsize i;
+
+    for (i = MAX (index, 1); i < index + n_points; i++)
+      _gdv_layer_content_track_order (priv, priv->head_seq + i,
+                                      x_column[i - 1], x_column[i]);
+  }
+
+  priv->n_points += n_points;
+}
+
+/**
+ * gdv_layer_content_add_data_points: (skip)
+ * @layer_content: a #GdvLayerContent
+ * @x_values: (nullable): the x values of the new data-points
+ * @y_values: (nullable): the y values of the new data-points
+ * @z_values: (nullable): the z values of the new data-points
+ * @n_points: the number of new data-points
+ * @stride: the distance between two consecutive values in each array,
+ *   counted in #gdouble elements; use 1 for densely packed arrays
+ *
+ * Adds a whole block of cartesian points to the @layer_content. A missing
+ * array is interpreted as a series of zeros.
+ *
+ * In contrast to calling gdv_layer_content_add_data_point() for every single
+ * point, the bounds are updated in a single pass and only one notification
+ * and redraw is issued for the whole block.
+ **/
+void
+gdv_layer_content_add_data_points (GdvLayerContent *layer_content,
+                                   const gdouble   *x_values,
+                                   const gdouble   *y_values,
+                                   const gdouble   *z_values,
+                                   gsize            n_points,
+                                   gsize            stride)
+{
+  GdvLayerContentPrivate *priv;
+  gsize i;
+
+  g_return_if_fail (GDV_LAYER_IS_CONTENT (layer_content));
+  g_return_if_fail (stride > 0);
+
+  if (n_points == 0)
+    return;
+
+  priv = layer_content->priv;
+
+  if (!_gdv_layer_content_is_windowed (priv))
+    _gdv_layer_content_append_block (priv,
+                                     x_values, y_values, z_values,
+                                     n_points, stride);
+  else
+    /* samples may be evicted while appending, so do this one by one */
+    for (i = 0; i < n_points; i++)
+      _gdv_layer_content_append (priv,
+                                 x_values ? x_values[i * stride] : 0.0,
+                                 y_values ? y_values[i * stride] : 0.0,
+                                 z_values ? z_values[i * stride] : 0.0);
+
+  g_object_notify_by_pspec (G_OBJECT (layer_content),
+                            layer_content_properties[PROP_DATA_POINT]);
+  gtk_widget_queue_draw (GTK_WIDGET (layer_content));
+}
+
+/**
+ * gdv_layer_content_add_data_points_bytes:
+ * @layer_content: a #GdvLayerContent
+ * @x_values: (nullable): the x values as packed array of #gdouble
+ * @y_values: (nullable): the y values as packed array of #gdouble
+ * @z_values: (nullable): the z values as packed array of #gdouble
+ *
+ * Binding-friendly variant of gdv_layer_content_add_data_points(). All given
+ * #GBytes have to contain the same number of values in host byte-order.
+ **/
+void
+gdv_layer_content_add_data_points_bytes (GdvLayerContent *layer_content,
+                                         GBytes          *x_values,
+                                         GBytes          *y_values,
+                                         GBytes          *z_values)
+{
+  GBytes *values[GDV_LAYER_CONTENT_MIN_COLUMNS];
+  const gdouble *data[GDV_LAYER_CONTENT_MIN_COLUMNS] = {NULL, NULL, NULL};
+  gsize n_points = 0;
+  gboolean n_points_known = FALSE;
+  guint i;
+
+  g_return_if_fail (GDV_LAYER_IS_CONTENT (layer_content));
+
+  values[0] = x_values;
+  values[1] = y_values;
+  values[2] = z_values;
+
+  for (i = 0; i < GDV_LAYER_CONTENT_MIN_COLUMNS; i++)
+    {
+      gsize size;
+
+      if (values[i] == NULL)
+        continue;
+
+      data[i] = g_bytes_get_data (values[i], &size);
+
+      g_return_if_fail (size % sizeof (gdouble) == 0);
+      g_return_if_fail (!n_points_known || n_points == size / sizeof (gdouble));
+
+      n_points = size / sizeof (gdouble);
+      n_points_known = TRUE;
+    }
+
+  gdv_layer_content_add_data_points (layer_content,
+                                     data[0], data[1], data[2],
+                                     n_points, 1);
+}
+
+/**
+ * gdv_layer_content_add_data_n_point:
+ * @layer_content: a #GdvLayerContent
+ * @point: the new n-dimensional data-point
+ *
+ * Adds a new n-dimensional data-point to the @layer_content. If @point has
+ * more dimensions than the @layer_content, all other points are extended by
+ * zeros. If @point has less dimensions, the missing values are set to zero.
+ *
+ * The first three dimensions are interpreted as x-, y- and z-value.
+ **/
+void
+gdv_layer_content_add_data_n_point (GdvLayerContent     *layer_content,
+                                    const GdvDataNPoint *point)
+{
+  GdvLayerContentPrivate *priv;
+  gsize index;
+  guint column;
 
   g_return_if_fail (GDV_LAYER_IS_CONTENT (layer_content));
+  g_return_if_fail (point != NULL);
+  g_return_if_fail (point->length == 0 || point->x != NULL);
 
-  layer_content->priv->layer_max->x =
-    fmax (layer_content->priv->layer_max->x, x_value);
-  layer_content->priv->layer_max->y =
-    fmax (layer_content->priv->layer_max->y, y_value);
-  layer_content->priv->layer_max->z =
-    fmax (layer_content->priv->layer_max->z, z_value);
+  priv = layer_content->priv;
 
-  layer_content->priv->layer_min->x =
-    fmin (layer_content->priv->layer_min->x, x_value);
-  layer_content->priv->layer_min->y =
-    fmin (layer_content->priv->layer_min->y, y_value);
-  layer_content->priv->layer_min->z =
-    fmin (layer_content->priv->layer_min->z, z_value);
+  if (point->length > priv->n_columns)
+    _gdv_layer_content_relayout (priv, point->length, priv->capacity);
 
-  if (layer_content->priv->content == NULL)
-    layer_content->priv->content = gsl_matrix_calloc(3, 1);
+  index = _gdv_layer_content_push (priv);
 
-  rows = layer_content->priv->content->size2;
-  gsl_matrix_set_and_expand(layer_content->priv->content, 0, rows, x_value);
-  gsl_matrix_set_and_expand(layer_content->priv->content, 1, rows, y_value);
-  gsl_matrix_set_and_expand(layer_content->priv->content, 2, rows, z_value);
+  for (column = 0; column < priv->n_columns; column++)
+    _gdv_layer_content_column (priv, column)[index] =
+      column < point->length ? point->x[column] : 0.0;
+
+  _gdv_layer_content_commit (priv);
 
   g_object_notify (G_OBJECT (layer_content), "data-point");
 }
 
+/**
+ * gdv_layer_content_reserve:
+ * @layer_content: a #GdvLayerContent
+ * @n_points: the number of data-points
+ *
+ * Preallocates the storage of @layer_content for at least @n_points
+ * data-points, so no further reallocation happens until this number is
+ * exceeded. This does not change the content itself.
+ *
+ * If the content is limited by #GdvLayerContent:max-points, no more than
+ * this number of data-points is preallocated.
+ **/
+void
+gdv_layer_content_reserve (GdvLayerContent *layer_content,
+                           gsize            n_points)
+{
+  GdvLayerContentPrivate *priv;
+
+  g_return_if_fail (GDV_LAYER_IS_CONTENT (layer_content));
+
+  priv = layer_content->priv;
+
+  if (priv->max_points > 0)
+    n_points = MIN (n_points, priv->max_points);
+
+  if (n_points > priv->capacity)
+    _gdv_layer_content_relayout (priv, priv->n_columns, n_points);
+}
+
+/**
+ * gdv_layer_content_get_n_points:
+ * @layer_content: a #GdvLayerContent
+ *
+ * Returns: the number of data-points in @layer_content.
+ **/
+gsize
+gdv_layer_content_get_n_points (GdvLayerContent *layer_content)
+{
+  g_return_val_if_fail (GDV_LAYER_IS_CONTENT (layer_content), 0);
+
+  return layer_content->priv->n_points;
+}
+
+/**
+ * gdv_layer_content_get_n_columns:
+ * @layer_content: a #GdvLayerContent
+ *
+ * Returns: the number of dimensions, every data-point of @layer_content has.
+ * This is at least three.
+ **/
+guint
+gdv_layer_content_get_n_columns (GdvLayerContent *layer_content)
+{
+  g_return_val_if_fail (GDV_LAYER_IS_CONTENT (layer_content), 0);
+
+  return layer_content->priv->n_columns;
+}
+
+/**
+ * gdv_layer_content_get_column:
+ * @layer_content: a #GdvLayerContent
+ * @column: the index of the column
+ * @n_points: (out) (optional): the place to store the length of the column
+ *
+ * Gives direct access to all values of a single dimension. The returned array
+ * is owned by @layer_content and is only valid until the next data-point is
+ * added or the @layer_content is reset.
+ *
+ * For a content with a sliding window, the storage may have to be reordered
+ * once to provide a contiguous array.
+ *
+ * Returns: (array length=n_points) (transfer none) (nullable): the values
+ * of @column
+ **/
+const gdouble *
+gdv_layer_content_get_column (GdvLayerContent *layer_content,
+                              guint            column,
+                              gsize           *n_points)
+{
+  GdvLayerContentPrivate *priv;
+
+  g_return_val_if_fail (GDV_LAYER_IS_CONTENT (layer_content), NULL);
+
+  priv = layer_content->priv;
+
+  g_return_val_if_fail (column < priv->n_columns, NULL);
+
+  if (n_points)
+    *n_points = priv->n_points;
+
+  if (priv->data == NULL)
+    return NULL;
+
+  _gdv_layer_content_linearize (priv);
+
+  return _gdv_layer_content_column (priv, column) + priv->head;
+}
+
 /* FIXME: Update the minimum and maximum values! */
 /*
  * gdv_layer_content_remove_data_point_by_index:
@@ -799,37 +3324,105 @@ gdv_layer_content_remove_data_point_by_index (
     return FALSE;
 }*/
 
-/* FIXME: determine (element-type GdvDataPoint) */
 /**
  * gdv_layer_content_get_content:
  * @content: a #GdvLayerContent
  *
- * Returns: (transfer full): The copy of the content.
+ * Gives a matrix-view on the content. Each row of the matrix holds one
+ * dimension and each column one data-point. The view shares its memory with
+ * @content and is only valid until the next data-point is added or the
+ * @content is reset.
+ *
+ * Returns: (transfer none) (nullable): A view on the content or %NULL, if the
+ * @content is empty.
  *
  **/
 GslMatrix *
 gdv_layer_content_get_content (GdvLayerContent *content)
 {
+  GdvLayerContentPrivate *priv;
+
   g_return_val_if_fail (GDV_LAYER_IS_CONTENT (content), NULL);
 
-  return content->priv->content;
+  priv = content->priv;
+
+  if (priv->n_points == 0)
+    return NULL;
+
+  _gdv_layer_content_linearize (priv);
+
+  priv->content_view =
+    gsl_matrix_view_array_with_tda (priv->data + priv->head,
+                                    priv->n_columns,
+                                    priv->n_points,
+                                    priv->capacity);
+
+  return &priv->content_view.matrix;
 }
 
 /**
  * gdv_layer_content_set_content:
  * @content: a #GdvLayerContent
- * @matrix: a #GslMatrix
+ * @matrix: (transfer full) (nullable): a #GslMatrix
+ *
+ * Replaces the data of @content by the values of @matrix. Each row of @matrix
+ * is interpreted as one dimension and each column as one data-point. The
+ * @content takes ownership of @matrix.
  **/
 void
 gdv_layer_content_set_content (GdvLayerContent *content, GslMatrix *matrix)
 {
+  GdvLayerContentPrivate *priv;
+  gsize row, offset, n_points;
+
   g_return_if_fail(GDV_LAYER_IS_CONTENT(content));
 
-  if (content->priv->content != NULL) {
-    gsl_matrix_free(content->priv->content);
-  }
+  priv = content->priv;
+
+  /* the view on our own storage can not be set again */
+  if (matrix == &priv->content_view.matrix)
+    return;
+
+  priv->head_seq += priv->n_points;
+  priv->n_points = 0;
+  priv->head = 0;
+  _gdv_layer_content_reset_bounds (priv);
+  _gdv_layer_content_lod_clear (priv);
+  _gdv_layer_content_invalidate_cache (priv);
+
+  if (matrix != NULL)
+    {
+      /* only the newest samples fit into a limited content */
+      n_points = matrix->size2;
+      if (priv->max_points > 0)
+        n_points = MIN (n_points, priv->max_points);
+      offset = matrix->size2 - n_points;
+
+      if (matrix->size1 > priv->n_columns)
+        _gdv_layer_content_relayout (priv, matrix->size1, priv->capacity);
+
+      _gdv_layer_content_ensure_capacity (priv, n_points);
 
-  content->priv->content = matrix;
+      for (row = 0; row < priv->n_columns; row++)
+        {
+          gdouble *column = _gdv_layer_content_column (priv, row);
+
+          if (row < matrix->size1)
+            memcpy (column,
+                    matrix->data + row * matrix->tda + offset,
+                    n_points * sizeof (gdouble));
+          else
+            memset (column, 0, n_points * sizeof (gdouble));
+        }
+
+      priv->n_points = n_points;
+
+      _gdv_layer_content_apply_window (priv);
+
+      gsl_matrix_free (matrix);
+    }
+
+  g_object_notify (G_OBJECT (content), "content-matrix");
 }
 
 /**
@@ -905,7 +3498,8 @@ gdv_layer_content_get_min_max_z (GdvLayerContent *content,
  * gdv_layer_content_reset:
  * @layer_content: a #GdvLayerContent
  *
- * Resets the #layer_content.
+ * Resets the #layer_content. All data-points are removed, but the allocated
+ * storage is kept.
  *
  **/
 void
@@ -913,19 +3507,16 @@ gdv_layer_content_reset (GdvLayerContent *layer_content)
 {
   g_return_if_fail (GDV_LAYER_IS_CONTENT (layer_content));
 
-  if (layer_content->priv->content == NULL)
-    g_object_unref(layer_content->priv->content);
-
-  layer_content->priv->content = NULL;
+  /* the storage is kept, so refilling the content does not reallocate */
+  layer_content->priv->head_seq += layer_content->priv->n_points;
+  layer_content->priv->n_points = 0;
+  layer_content->priv->head = 0;
 
   g_object_notify (G_OBJECT (layer_content), "content-matrix");
 
-  layer_content->priv->layer_max->x = -G_MAXDOUBLE;
-  layer_content->priv->layer_max->y = -G_MAXDOUBLE;
-  layer_content->priv->layer_max->z = -G_MAXDOUBLE;
-
-  layer_content->priv->layer_min->x = G_MAXDOUBLE;
-  layer_content->priv->layer_min->y = G_MAXDOUBLE;
-  layer_content->priv->layer_min->z = G_MAXDOUBLE;
+  _gdv_layer_content_reset_bounds (layer_content->priv);
+  _gdv_layer_content_lod_clear (layer_content->priv);
+  _gdv_layer_content_invalidate_cache (layer_content->priv);
+  gtk_widget_queue_draw (GTK_WIDGET (layer_content));
 }
 
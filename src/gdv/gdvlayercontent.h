@@ -29,6 +29,8 @@
 //#include <libggsl/matrix/libggsl-matrix.h>
 #include<gigsl/gigsl.h>
 
+#include "gdv-data-boxed.h"
+
 G_BEGIN_DECLS
 
 #define GDV_LAYER_TYPE_CONTENT\
@@ -86,6 +88,39 @@ gdv_layer_content_add_data_point (GdvLayerContent *layer_content,
                                   gdouble          y_value,
                                   gdouble          z_value);
 
+void
+gdv_layer_content_add_data_points (GdvLayerContent *layer_content,
+                                   const gdouble   *x_values,
+                                   const gdouble   *y_values,
+                                   const gdouble   *z_values,
+                                   gsize            n_points,
+                                   gsize            stride);
+
+void
+gdv_layer_content_add_data_points_bytes (GdvLayerContent *layer_content,
+                                         GBytes          *x_values,
+                                         GBytes          *y_values,
+                                         GBytes          *z_values);
+
+void
+gdv_layer_content_add_data_n_point (GdvLayerContent     *layer_content,
+                                    const GdvDataNPoint *point);
+
+void
+gdv_layer_content_reserve (GdvLayerContent *layer_content,
+                           gsize            n_points);
+
+gsize
+gdv_layer_content_get_n_points (GdvLayerContent *layer_content);
+
+guint
+gdv_layer_content_get_n_columns (GdvLayerContent *layer_content);
+
+const gdouble *
+gdv_layer_content_get_column (GdvLayerContent *layer_content,
+                              guint            column,
+                              gsize           *n_points);
+
 //gboolean
 //gdv_layer_content_remove_data_point_by_index (
 //  GdvLayerContent *layer_content,
@@ -39,6 +39,7 @@
  */
 
 #include "gdvlegend.h"
+#include "gdvtheme-private.h"
 #include "gdvaxis.h"
 #include "gdvlayer.h"
 #include "gdvlegendelement.h"
@@ -90,23 +91,14 @@ gdv_legend_init (GdvLegend *legend)
 {
   GtkWidget *widget = GTK_WIDGET (legend);
   GtkStyleContext *style_context;
-  GtkCssProvider *css_provider;
 
   legend->priv = gdv_legend_get_instance_private (legend);
 
   gtk_widget_set_receives_default (GTK_WIDGET (legend), TRUE);
   gtk_widget_set_has_window (GTK_WIDGET (legend), FALSE);
 
-  css_provider = gtk_css_provider_new ();
   style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
-
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+  _gdv_theme_add_to_context (style_context);
 
   /* data */
   legend->priv->attached_layer = NULL;
@@ -314,25 +306,24 @@ static void
 gdv_legend_refresh (GdvLegend *legend)
 {
   guint current_row, current_col;
-  GList *contents =
-    gdv_layer_get_content_list (GDV_LAYER (legend->priv->attached_layer));
-  GList *contents_copy = contents;
-  GList *axes =
-    gdv_layer_get_axis_list (GDV_LAYER (legend->priv->attached_layer));
-  GList *axes_copy = axes;
+  GdvLayer *layer = GDV_LAYER (legend->priv->attached_layer);
+  GdvLayerContent **contents;
+  GdvAxis **axes;
+  guint n_contents, n_axes, current_content = 0, i;
   GList *indicator_list = NULL;
   GList *indicators_copy;
 
-  while (axes)
+  contents = gdv_layer_peek_contents (layer, &n_contents);
+  axes = gdv_layer_peek_axes (layer, &n_axes);
+
+  /* axes are visited backwards, so the lists can be prepended */
+  for (i = n_axes; i > 0; i--)
   {
     GList *local_indicators =
-      gdv_axis_get_indicator_list (GDV_AXIS (axes->data));
-    indicator_list = g_list_concat (indicator_list, local_indicators);
-
-    axes = axes->next;
+      gdv_axis_get_indicator_list (axes[i - 1]);
+    indicator_list = g_list_concat (local_indicators, indicator_list);
   }
 
-  g_list_free (axes_copy);
   indicators_copy = indicator_list;
 
   for (current_row = 0; current_row < legend->priv->rows; current_row++)
@@ -382,11 +373,8 @@ gdv_legend_refresh (GdvLegend *legend)
 
       /* receiving the next element */
       /* TODO: receive "show-in-legend"-property and toggle over elements */
-      if (contents)
-      {
-        current_element = contents->data;
-        contents = contents->next;
-      }
+      if (current_content < n_contents)
+        current_element = GTK_WIDGET (contents[current_content++]);
       else if (indicator_list)
       {
         current_element = indicator_list->data;
@@ -467,7 +455,6 @@ gdv_legend_refresh (GdvLegend *legend)
     }
   }
 
-  g_list_free (contents_copy);
   g_list_free (indicators_copy);
 }
 
@@ -460,12 +460,18 @@ gdv_legend_element_draw (GtkWidget    *widget,
   {
     GtkStyleContext *context =
       gtk_widget_get_style_context (GTK_WIDGET (element->priv->connected_element));
+    guint point_type;
 
-    gdv_render_data_point (
+    g_object_get (element->priv->connected_element,
+                  "point-type", &point_type,
+                  NULL);
+
+    gdv_render_data_marker (
       context,
       cr,
       allocation.x + 0.5 * allocation.width,
-      allocation.y + 0.5 * allocation.height);
+      allocation.y + 0.5 * allocation.height,
+      point_type);
     gdv_render_data_line (
       context,
       cr,
@@ -41,6 +41,7 @@
  */
 
 #include "gdvaxis.h"
+#include "gdvaxis-private.h"
 #include "gdvtic.h"
 #include "gdvmtic.h"
 #include "gdvlogaxis.h"
@@ -54,12 +55,6 @@ static void
 gdv_log_axis_size_allocate (GtkWidget           *widget,
                             GtkAllocation       *allocation);
 static gboolean
-gdv_log_axis_on_get_point (
-  GdvAxis *axis,
-  gdouble value,
-  gdouble *pos_x,
-  gdouble *pos_y);
-static gboolean
 gdv_log_axis_on_get_inner_dir (
   GdvAxis *axis,
   gdouble value,
@@ -90,6 +85,8 @@ static void
 gdv_log_axis_init (GdvLogAxis *axis)
 {
   axis->priv = gdv_log_axis_get_instance_private (axis);
+
+  _gdv_axis_set_transform_type (GDV_AXIS (axis), GDV_AXIS_TRANSFORM_LOG);
 }
 
 static void
@@ -116,7 +113,7 @@ gdv_log_axis_class_init (GdvLogAxisClass *klass)
 
   widget_class->size_allocate = gdv_log_axis_size_allocate;
 
-  axis_class->get_point = gdv_log_axis_on_get_point;
+  axis_class->get_point = _gdv_axis_transform_get_point;
   axis_class->get_inner_dir = gdv_log_axis_on_get_inner_dir;
   axis_class->make_tic_label_markup = gdv_log_axis_make_tic_label_markup;
   axis_class->get_space_to_beg_position =
@@ -1003,75 +1000,6 @@ gdv_log_axis_size_allocate (GtkWidget           *widget,
     widget, allocation);
 }
 
-static gboolean
-gdv_log_axis_on_get_point (
-  GdvAxis *axis,
-  gdouble value,
-  gdouble *pos_x,
-  gdouble *pos_y)
-{
-  gdouble begin_val, end_val;
-  gdouble begin_x, begin_y, end_x, end_y;
-  gdouble tmp_slope_x, tmp_slope_y;
-  gdouble scale_incrmenet;
-
-  if (value <= 0.0)
-    return FALSE;
-
-  g_object_get (axis,
-                "scale-beg-val", &begin_val,
-                "scale-end-val", &end_val,
-                "scale-increment-val", &scale_incrmenet,
-                "axis-beg-pix-x", &begin_x,
-                "axis-end-pix-x", &end_x,
-                "axis-beg-pix-y", &begin_y,
-                "axis-end-pix-y", &end_y,
-                NULL);
-
-  /* TODO: automatically correct the values depending on the others */
-  if (!begin_val && end_val)
-  {
-    begin_val = fmax (begin_val, 1e-1);
-  }
-  else if (!end_val && begin_val)
-  {
-    end_val = fmax (end_val, 1e2);
-  }
-  else if (!begin_val && !end_val)
-  {
-    begin_val = fmax (begin_val, 1e-1);
-    end_val = fmax (end_val, 1e2);
-  }
-
-  if (pos_x && begin_x != end_x && begin_val != end_val)
-  {
-    tmp_slope_x =
-      (log(begin_val) - log(end_val)) /
-      ((begin_x - end_x));
-    *pos_x =
-      begin_x + (log(value) -
-                 log(begin_val)) / tmp_slope_x;
-  }
-  else if (pos_x)
-    *pos_x = (end_x + begin_x) / 2.0;
-
-  if (pos_y && begin_y != end_y && begin_val != end_val)
-  {
-    tmp_slope_y =
-      (log(begin_val) - log(end_val)) /
-      ((begin_y - end_y));
-    *pos_y =
-      begin_y + (log(value) -
-                 log(begin_val)) / tmp_slope_y;
-  }
-  else if (pos_y)
-    *pos_y = (end_y + begin_y) / 2.0;
-
-  return (
-           (value <= (begin_val >= end_val ? begin_val : end_val)) &&
-           (value >= (begin_val <= end_val ? begin_val : end_val)));
-}
-
 static gboolean
 gdv_log_axis_on_get_inner_dir (
   GdvAxis *axis,
@@ -0,0 +1,44 @@
+/* gdvmarker-private.h
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+G_GNUC_INTERNAL void _gdv_marker_draw (cairo_t       *cr,
+                                       guint          point_type,
+                                       gdouble        x,
+                                       gdouble        y,
+                                       gdouble        radius,
+                                       const GdkRGBA *color);
+
+G_GNUC_INTERNAL void _gdv_marker_render_points (cairo_t       *cr,
+                                                guint          point_type,
+                                                gdouble        radius,
+                                                const GdkRGBA *color,
+                                                const gdouble *px,
+                                                const gdouble *py,
+                                                gsize          n_points);
+
+G_END_DECLS
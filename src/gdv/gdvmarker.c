@@ -0,0 +1,525 @@
+/*
+ * gdvmarker.c
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include <config.h>
+#endif
+
+#include <math.h>
+#include <string.h>
+
+#include "gdv-enums.h"
+#include "gdvmarker-private.h"
+
+/* Every combination of symbol, radius, color and device-scale is rasterized
+ * once into a small image, the stamp. Stamps are kept in a cache, that is
+ * shared by all contents and worker-threads. Drawing a data-point then only
+ * copies its stamp: onto image surfaces by blending the pixels directly,
+ * onto all other targets with cairo. */
+
+/* the number of stamps, that are kept at most */
+#define GDV_MARKER_MAX_STAMPS 64
+/* larger stamps are not worth caching; the symbols are drawn as paths */
+#define GDV_MARKER_MAX_STAMP_SIZE 255
+
+typedef struct
+{
+  guint point_type;
+  gdouble radius;
+  GdkRGBA color;
+  gdouble scale;
+} GdvMarkerKey;
+
+typedef struct
+{
+  GdvMarkerKey key;
+  cairo_surface_t *surface;
+} GdvMarkerStamp;
+
+G_LOCK_DEFINE_STATIC (marker_stamps);
+static GHashTable *marker_stamps = NULL;
+
+static guint
+_gdv_marker_key_hash (gconstpointer data)
+{
+  const GdvMarkerKey *key = data;
+  guint hash = key->point_type;
+
+  hash = hash * 31 + g_double_hash (&key->radius);
+  hash = hash * 31 + g_double_hash (&key->color.red);
+  hash = hash * 31 + g_double_hash (&key->color.green);
+  hash = hash * 31 + g_double_hash (&key->color.blue);
+  hash = hash * 31 + g_double_hash (&key->color.alpha);
+  hash = hash * 31 + g_double_hash (&key->scale);
+
+  return hash;
+}
+
+static gboolean
+_gdv_marker_key_equal (gconstpointer a,
+                       gconstpointer b)
+{
+  const GdvMarkerKey *key_a = a, *key_b = b;
+
+  return key_a->point_type == key_b->point_type &&
+         key_a->radius == key_b->radius &&
+         key_a->scale == key_b->scale &&
+         gdk_rgba_equal (&key_a->color, &key_b->color);
+}
+
+static void
+_gdv_marker_stamp_free (gpointer data)
+{
+  GdvMarkerStamp *stamp = data;
+
+  cairo_surface_destroy (stamp->surface);
+  g_free (stamp);
+}
+
+/* the distance from the center, up to which a symbol may cover pixels */
+static inline gdouble
+_gdv_marker_reach (gdouble radius)
+{
+  return 1.6 * radius + 1.0;
+}
+
+/* appends a closed polygon with n corners on a circle around (x, y) to the
+ * path; the radius alternates between outer and inner for stars */
+static void
+_gdv_marker_append_polygon (cairo_t *cr,
+                            gdouble  x,
+                            gdouble  y,
+                            gdouble  outer,
+                            gdouble  inner,
+                            guint    n_corners,
+                            gdouble  angle)
+{
+  guint i;
+
+  for (i = 0; i < n_corners; i++)
+  {
+    gdouble radius = (i % 2 == 1) ? inner : outer;
+    gdouble phi = angle + 2.0 * G_PI * i / n_corners;
+
+    if (i == 0)
+      cairo_move_to (cr, x + radius * cos (phi), y + radius * sin (phi));
+    else
+      cairo_line_to (cr, x + radius * cos (phi), y + radius * sin (phi));
+  }
+
+  cairo_close_path (cr);
+}
+
+/* Draws a single symbol centered on (x, y). The filled symbols cover about
+ * the area of the circle with the same radius, so all of them look equally
+ * heavy. The source and the line-width of cr are changed. */
+G_GNUC_INTERNAL void
+_gdv_marker_draw (cairo_t       *cr,
+                  guint          point_type,
+                  gdouble        x,
+                  gdouble        y,
+                  gdouble        radius,
+                  const GdkRGBA *color)
+{
+  gdouble half;
+
+  cairo_new_path (cr);
+  gdk_cairo_set_source_rgba (cr, color);
+
+  switch (point_type)
+  {
+  case GDV_POINT_TYPE_SQUARE:
+    half = 0.886 * radius;
+    cairo_rectangle (cr, x - half, y - half, 2.0 * half, 2.0 * half);
+    cairo_fill (cr);
+    break;
+
+  case GDV_POINT_TYPE_DIAMOND:
+    _gdv_marker_append_polygon (cr, x, y, 1.253 * radius, 1.253 * radius,
+                                4, -0.5 * G_PI);
+    cairo_fill (cr);
+    break;
+
+  case GDV_POINT_TYPE_TRIANGLE_UP:
+    _gdv_marker_append_polygon (cr, x, y, 1.555 * radius, 1.555 * radius,
+                                3, -0.5 * G_PI);
+    cairo_fill (cr);
+    break;
+
+  case GDV_POINT_TYPE_TRIANGLE_DOWN:
+    _gdv_marker_append_polygon (cr, x, y, 1.555 * radius, 1.555 * radius,
+                                3, 0.5 * G_PI);
+    cairo_fill (cr);
+    break;
+
+  case GDV_POINT_TYPE_CROSS:
+  case GDV_POINT_TYPE_PLUS:
+    half = point_type == GDV_POINT_TYPE_CROSS ? M_SQRT1_2 * radius : radius;
+
+    if (point_type == GDV_POINT_TYPE_CROSS)
+    {
+      cairo_move_to (cr, x - half, y - half);
+      cairo_line_to (cr, x + half, y + half);
+      cairo_move_to (cr, x - half, y + half);
+      cairo_line_to (cr, x + half, y - half);
+    }
+    else
+    {
+      cairo_move_to (cr, x - half, y);
+      cairo_line_to (cr, x + half, y);
+      cairo_move_to (cr, x, y - half);
+      cairo_line_to (cr, x, y + half);
+    }
+
+    cairo_set_line_width (cr, MAX (0.4 * radius, 1.0));
+    cairo_set_line_cap (cr, CAIRO_LINE_CAP_BUTT);
+    cairo_stroke (cr);
+    break;
+
+  case GDV_POINT_TYPE_STAR:
+    _gdv_marker_append_polygon (cr, x, y, 1.5 * radius, 0.6 * radius,
+                                10, -0.5 * G_PI);
+    cairo_fill (cr);
+    break;
+
+  case GDV_POINT_TYPE_CIRCLE:
+  default:
+    cairo_arc (cr, x, y, radius, 0, 2 * G_PI);
+    cairo_fill (cr);
+    break;
+  }
+}
+
+/* Gives a new reference to the stamp of the symbol or NULL, if it is too
+ * large to be stamped. The stamp has an odd size of pixels; the symbol is
+ * centered on its middle pixel. */
+static cairo_surface_t *
+_gdv_marker_lookup (guint          point_type,
+                    gdouble        radius,
+                    const GdkRGBA *color,
+                    gdouble        scale)
+{
+  GdvMarkerKey key;
+  GdvMarkerStamp *stamp;
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  gdouble center;
+  gint half, size;
+
+  center = _gdv_marker_reach (radius) * scale;
+
+  if (!(center <= GDV_MARKER_MAX_STAMP_SIZE / 2))
+    return NULL;
+
+  half = (gint) ceil (center);
+  size = 2 * half + 1;
+
+  memset (&key, 0, sizeof (key));
+  key.point_type = point_type;
+  key.radius = radius;
+  key.color = *color;
+  key.scale = scale;
+
+  G_LOCK (marker_stamps);
+
+  if (!marker_stamps)
+    marker_stamps = g_hash_table_new_full (_gdv_marker_key_hash,
+                                           _gdv_marker_key_equal,
+                                           NULL,
+                                           _gdv_marker_stamp_free);
+
+  stamp = g_hash_table_lookup (marker_stamps, &key);
+
+  if (stamp)
+  {
+    surface = cairo_surface_reference (stamp->surface);
+    G_UNLOCK (marker_stamps);
+
+    return surface;
+  }
+
+  G_UNLOCK (marker_stamps);
+
+  /* rendered without the lock; a concurrent thread may do the same */
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, size, size);
+  cairo_surface_set_device_scale (surface, scale, scale);
+
+  center = (half + 0.5) / scale;
+  cr = cairo_create (surface);
+  _gdv_marker_draw (cr, point_type, center, center, radius, color);
+  cairo_destroy (cr);
+
+  cairo_surface_flush (surface);
+
+  stamp = g_new (GdvMarkerStamp, 1);
+  stamp->key = key;
+  stamp->surface = cairo_surface_reference (surface);
+
+  G_LOCK (marker_stamps);
+
+  /* styles change seldom, so the whole cache is just dropped when full */
+  if (g_hash_table_size (marker_stamps) >= GDV_MARKER_MAX_STAMPS)
+    g_hash_table_remove_all (marker_stamps);
+
+  g_hash_table_replace (marker_stamps, &stamp->key, stamp);
+
+  G_UNLOCK (marker_stamps);
+
+  return surface;
+}
+
+/* dst = src + dst * (1 - alpha(src)) for premultiplied ARGB */
+static inline guint32
+_gdv_marker_over (guint32 src,
+                  guint32 dst)
+{
+  guint32 inverse = 255 - (src >> 24);
+  guint32 rb = (dst & 0x00ff00ff) * inverse + 0x00800080;
+  guint32 ag = ((dst >> 8) & 0x00ff00ff) * inverse + 0x00800080;
+
+  rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+  ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+
+  return src + (rb | ag);
+}
+
+/* Blends the stamp into the pixels of the target directly. This is only
+ * possible for image surfaces, if cr neither rotates nor scales and clips at
+ * most to a single rectangle on whole pixels; gives FALSE otherwise.
+ *
+ * Within cairo_push_group(), e.g. for the opacity of a widget, the pixels
+ * are written into the group; its device-offset includes the position of
+ * the group within the original target. */
+static gboolean
+_gdv_marker_blend (cairo_t         *cr,
+                   cairo_surface_t *stamp,
+                   const gdouble   *px,
+                   const gdouble   *py,
+                   gsize            n_points)
+{
+  cairo_surface_t *target = cairo_get_group_target (cr);
+  cairo_rectangle_list_t *clips;
+  cairo_matrix_t matrix;
+  gdouble scale, offset_x, offset_y;
+  gint clip_x0, clip_y0, clip_x1, clip_y1;
+  gint size, half, stride, stamp_stride, last_x = G_MININT, last_y = G_MININT;
+  guchar *data;
+  const guchar *stamp_data;
+  gsize i;
+
+  if (cairo_surface_get_type (target) != CAIRO_SURFACE_TYPE_IMAGE ||
+      cairo_image_surface_get_format (target) != CAIRO_FORMAT_ARGB32 ||
+      cairo_get_operator (cr) != CAIRO_OPERATOR_OVER)
+    return FALSE;
+
+  cairo_get_matrix (cr, &matrix);
+
+  if (matrix.xx != 1.0 || matrix.yy != 1.0 ||
+      matrix.xy != 0.0 || matrix.yx != 0.0)
+    return FALSE;
+
+  clips = cairo_copy_clip_rectangle_list (cr);
+
+  if (clips->status != CAIRO_STATUS_SUCCESS || clips->num_rectangles > 1)
+  {
+    cairo_rectangle_list_destroy (clips);
+    return FALSE;
+  }
+
+  /* nothing is visible at all */
+  if (clips->num_rectangles == 0)
+  {
+    cairo_rectangle_list_destroy (clips);
+    return TRUE;
+  }
+
+  cairo_surface_get_device_scale (target, &scale, NULL);
+  cairo_surface_get_device_offset (target, &offset_x, &offset_y);
+
+  /* the clip in pixels of the target, where user-space (u, v) maps onto
+   * ((u + x0) * scale + offset_x, (v + y0) * scale + offset_y) */
+  {
+    const cairo_rectangle_t *clip = &clips->rectangles[0];
+    gdouble x0 = (clip->x + matrix.x0) * scale + offset_x;
+    gdouble y0 = (clip->y + matrix.y0) * scale + offset_y;
+
+    clip_x0 = (gint) MAX (floor (x0 + 0.5), 0.0);
+    clip_y0 = (gint) MAX (floor (y0 + 0.5), 0.0);
+    clip_x1 = (gint) MIN (floor (x0 + clip->width * scale + 0.5),
+                          (gdouble) cairo_image_surface_get_width (target));
+    clip_y1 = (gint) MIN (floor (y0 + clip->height * scale + 0.5),
+                          (gdouble) cairo_image_surface_get_height (target));
+  }
+
+  cairo_rectangle_list_destroy (clips);
+
+  if (clip_x1 <= clip_x0 || clip_y1 <= clip_y0)
+    return TRUE;
+
+  cairo_surface_flush (target);
+
+  data = cairo_image_surface_get_data (target);
+  stride = cairo_image_surface_get_stride (target);
+
+  size = cairo_image_surface_get_width (stamp);
+  half = (size - 1) / 2;
+  stamp_data = cairo_image_surface_get_data (stamp);
+  stamp_stride = cairo_image_surface_get_stride (stamp);
+
+  for (i = 0; i < n_points; i++)
+  {
+    gdouble center_x = (px[i] + 0.5 + matrix.x0) * scale + offset_x;
+    gdouble center_y = (py[i] + 0.5 + matrix.y0) * scale + offset_y;
+    gint stamp_x, stamp_y, x_beg, x_end, y_beg, y_end, x, y;
+
+    /* this also drops NAN */
+    if (!(center_x >= clip_x0 - half - 1 && center_x < clip_x1 + half + 1 &&
+          center_y >= clip_y0 - half - 1 && center_y < clip_y1 + half + 1))
+      continue;
+
+    stamp_x = (gint) floor (center_x) - half;
+    stamp_y = (gint) floor (center_y) - half;
+
+    /* points on the same pixel would only darken the symbol */
+    if (stamp_x == last_x && stamp_y == last_y)
+      continue;
+
+    last_x = stamp_x;
+    last_y = stamp_y;
+
+    x_beg = MAX (stamp_x, clip_x0);
+    x_end = MIN (stamp_x + size, clip_x1);
+    y_beg = MAX (stamp_y, clip_y0);
+    y_end = MIN (stamp_y + size, clip_y1);
+
+    for (y = y_beg; y < y_end; y++)
+    {
+      const guint32 *src = (const guint32 *)
+        (stamp_data + (gsize) (y - stamp_y) * stamp_stride);
+      guint32 *dst = (guint32 *) (data + (gsize) y * stride);
+
+      for (x = x_beg; x < x_end; x++)
+      {
+        guint32 pixel = src[x - stamp_x];
+
+        if (pixel == 0)
+          continue;
+
+        dst[x] = (pixel >> 24) == 255 ? pixel : _gdv_marker_over (pixel, dst[x]);
+      }
+    }
+  }
+
+  cairo_surface_mark_dirty (target);
+
+  return TRUE;
+}
+
+/* Paints the stamp for every point with cairo; works with any target */
+static void
+_gdv_marker_paint (cairo_t         *cr,
+                   cairo_surface_t *stamp,
+                   const gdouble   *px,
+                   const gdouble   *py,
+                   gsize            n_points)
+{
+  gdouble scale, extent, center, last_x = NAN, last_y = NAN;
+  gdouble clip_x0, clip_y0, clip_x1, clip_y1;
+  gsize i;
+
+  cairo_surface_get_device_scale (stamp, &scale, NULL);
+  extent = cairo_image_surface_get_width (stamp) / scale;
+  center = 0.5 * extent;
+
+  /* the positions, whose stamp overlaps the clip */
+  cairo_clip_extents (cr, &clip_x0, &clip_y0, &clip_x1, &clip_y1);
+  clip_x0 -= 0.5 + center;
+  clip_y0 -= 0.5 + center;
+  clip_x1 += center - 0.5;
+  clip_y1 += center - 0.5;
+
+  cairo_save (cr);
+
+  for (i = 0; i < n_points; i++)
+  {
+    /* this also drops NAN */
+    if (!(px[i] > clip_x0 && px[i] < clip_x1 &&
+          py[i] > clip_y0 && py[i] < clip_y1))
+      continue;
+
+    if (fabs (px[i] - last_x) < 0.5 / scale &&
+        fabs (py[i] - last_y) < 0.5 / scale)
+      continue;
+
+    last_x = px[i];
+    last_y = py[i];
+
+    cairo_set_source_surface (cr, stamp,
+                              px[i] + 0.5 - center, py[i] + 0.5 - center);
+    cairo_rectangle (cr, px[i] + 0.5 - center, py[i] + 0.5 - center,
+                     extent, extent);
+    cairo_fill (cr);
+  }
+
+  cairo_restore (cr);
+}
+
+/* Draws the symbol on every point; like the lines, the symbols are centered
+ * half a pixel right of and below the given positions. */
+G_GNUC_INTERNAL void
+_gdv_marker_render_points (cairo_t       *cr,
+                           guint          point_type,
+                           gdouble        radius,
+                           const GdkRGBA *color,
+                           const gdouble *px,
+                           const gdouble *py,
+                           gsize          n_points)
+{
+  cairo_surface_t *stamp;
+  gdouble scale_x, scale_y;
+  gsize i;
+
+  if (n_points == 0 || !(radius > 0.0) || color->alpha <= 0.0)
+    return;
+
+  cairo_surface_get_device_scale (cairo_get_target (cr), &scale_x, &scale_y);
+
+  stamp = _gdv_marker_lookup (point_type, radius, color, scale_x);
+
+  if (!stamp)
+  {
+    cairo_save (cr);
+
+    for (i = 0; i < n_points; i++)
+      _gdv_marker_draw (cr, point_type, px[i] + 0.5, py[i] + 0.5,
+                        radius, color);
+
+    cairo_restore (cr);
+    return;
+  }
+
+  if (scale_x != scale_y ||
+      !_gdv_marker_blend (cr, stamp, px, py, n_points))
+    _gdv_marker_paint (cr, stamp, px, py, n_points);
+
+  cairo_surface_destroy (stamp);
+}
@@ -28,6 +28,7 @@
 
 #include <math.h>
 #include <float.h>
+#include <string.h>
 
 /**
  * SECTION:gdvonedlayer
@@ -47,6 +48,8 @@
 #include "gdv-data-boxed.h"
 #include "gdv-enums.h"
 #include "gdvlinearaxis.h"
+#include "gdvaxis-private.h"
+#include "gdvlayer-private.h"
 
 /* Define Properties */
 enum
@@ -107,6 +110,16 @@ evaluate_data_point (GdvLayer *layer,
                      gdouble data_point_z_value,
                      gdouble *pixel_x_value,
                      gdouble *pixel_y_value);
+static void
+evaluate_data_points (GdvLayer      *layer,
+                      const gdouble *x_values,
+                      const gdouble *y_values,
+                      const gdouble *z_values,
+                      gsize          n_points,
+                      gsize          stride,
+                      gdouble       *pos_x,
+                      gdouble       *pos_y,
+                      guint8        *in_range);
 static void _replace_axis (GdvOnedLayer *layer, GdvAxis *axis);
 
 static void
@@ -196,6 +209,7 @@ gdv_oned_layer_class_init (GdvOnedLayerClass *klass)
   container_class->remove = gdv_oned_layer_remove;
 
   layer_class->evaluate_point = evaluate_data_point;
+  layer_class->evaluate_points = evaluate_data_points;
 
   gtk_widget_class_set_css_name (widget_class, "layeroned");
 
@@ -267,7 +281,7 @@ gdv_oned_layer_init (GdvOnedLayer *layer)
                                     "halign", GTK_ALIGN_FILL,
                                     "valign", GTK_ALIGN_FILL,
                                     NULL);
-  gtk_overlay_add_overlay (GTK_OVERLAY (layer), GTK_WIDGET (layer->priv->axis));
+  _gdv_layer_add_overlay (GDV_LAYER (layer), GTK_WIDGET (layer->priv->axis));
 
   layer->priv->base_orientation = GTK_ORIENTATION_VERTICAL;
   layer->priv->orientation = 0.0;
@@ -312,35 +326,59 @@ evaluate_data_point (GdvLayer *layer,
                      gdouble *pixel_x_value,
                      gdouble *pixel_y_value)
 {
-  GdvOnedLayer *layeroned;
-  gboolean return_value;
+  guint8 in_range;
 
   g_return_val_if_fail (GDV_ONED_IS_LAYER (layer), FALSE);
 
-  layeroned = GDV_ONED_LAYER (layer);
+  evaluate_data_points (layer,
+                        &data_point_x_value,
+                        &data_point_y_value,
+                        &data_point_z_value,
+                        1, 1,
+                        pixel_x_value, pixel_y_value,
+                        &in_range);
 
-  return_value = FALSE;
+  return in_range & 1;
+}
 
-  layeroned = GDV_ONED_LAYER (layer);
+static void
+evaluate_data_points (GdvLayer      *layer,
+                      const gdouble *x_values,
+                      const gdouble *y_values,
+                      const gdouble *z_values,
+                      gsize          n_points,
+                      gsize          stride,
+                      gdouble       *pos_x,
+                      gdouble       *pos_y,
+                      guint8        *in_range)
+{
+  GdvOnedLayerPrivate *priv = GDV_ONED_LAYER (layer)->priv;
+  gboolean use_axis;
+  gsize i;
 
-  if (layeroned->priv->axis_using == 0)
+  if (!x_values)
   {
-    GdvAxis *local_axis = layeroned->priv->axis;
-    gboolean on_axis = FALSE;
-
-    if (local_axis)
-      g_signal_emit_by_name (
-        local_axis,
-        "get-point",
-        data_point_x_value,
-        pixel_x_value,
-        pixel_y_value,
-        &on_axis);
-
-    return_value = layeroned->priv->stay_in_range || on_axis;
+    GDV_LAYER_CLASS (gdv_oned_layer_parent_class)->evaluate_points (
+      layer, x_values, y_values, z_values, n_points, stride,
+      pos_x, pos_y, in_range);
+    return;
   }
 
-  return return_value;
+  use_axis = priv->axis_using == 0 && priv->axis;
+
+  if (in_range)
+    memset (in_range,
+            priv->axis_using == 0 && (priv->stay_in_range || use_axis) ?
+            0xff : 0x00,
+            (n_points + 7) / 8);
+
+  if (use_axis)
+    _gdv_axis_map_values (priv->axis, x_values, n_points, stride, 0.0, 0.0,
+                          pos_x, pos_y,
+                          priv->stay_in_range ? NULL : in_range);
+  else
+    for (i = 0; i < n_points; i++)
+      pos_x[i] = pos_y[i] = 0.0;
 }
 
 GdvOnedLayer *gdv_oned_layer_new (void)
@@ -355,7 +393,7 @@ static void _replace_axis (GdvOnedLayer *layer, GdvAxis *axis)
     gtk_container_remove (GTK_CONTAINER (layer), GTK_WIDGET (layer->priv->axis));
 
   layer->priv->axis = axis;
-  gtk_overlay_add_overlay (GTK_OVERLAY (layer), GTK_WIDGET (layer->priv->axis));
+  _gdv_layer_add_overlay (GDV_LAYER (layer), GTK_WIDGET (layer->priv->axis));
 }
 
 /**
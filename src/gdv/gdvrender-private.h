@@ -0,0 +1,61 @@
+/* gdvrender-private.h
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GdvDataStyle GdvDataStyle;
+
+/*
+ * GdvDataStyle:
+ *
+ * All style-properties, that are needed to render data. Once resolved from
+ * a style-context, it is a plain record, that can be used on any thread.
+ */
+struct _GdvDataStyle
+{
+  /* a #GdvPointType; it is a property of the content, not of the style, so
+   * it is always resolved as a circle */
+  guint point_type;
+  gdouble point_width;
+  GdkRGBA point_color;
+
+  gdouble line_width;
+  GdkRGBA line_color;
+  gdouble dash_array[4];
+  gint n_dashes;
+};
+
+G_GNUC_INTERNAL void _gdv_data_style_resolve (GtkStyleContext *context,
+                                              GdvDataStyle    *style);
+
+G_GNUC_INTERNAL void _gdv_render_data_polyline_styled (
+  const GdvDataStyle *style,
+  cairo_t            *cr,
+  const gdouble      *px,
+  const gdouble      *py,
+  gsize               n_points);
+
+G_END_DECLS
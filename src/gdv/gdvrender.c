@@ -27,6 +27,8 @@
 #include <math.h>
 
 #include "gdvrender.h"
+#include "gdvrender-private.h"
+#include "gdvmarker-private.h"
 
 static void
 gtk_do_render_line (GtkStyleContext *context,
@@ -381,52 +383,85 @@ void        gdv_render_mtic                 (GtkStyleContext     *context,
   cairo_restore (cr);
 }
 
-/* FIXME: This function is not even close to a good look */
+/**
+ * gdv_render_data_point:
+ * @context: a #GtkStyleContext
+ * @cr: a #cairo_t
+ * @x: the x-position of the data-point
+ * @y: the y-position of the data-point
+ *
+ * Renders a single data-point as a circle; see gdv_render_data_marker().
+ **/
 void        gdv_render_data_point           (GtkStyleContext     *context,
     cairo_t             *cr,
     gdouble              x,
     gdouble              y)
 {
-  GdkRGBA *color;
-  gdouble point_width;
-  GValue value_lw = G_VALUE_INIT;
-  GValue value_lc = G_VALUE_INIT;
+  gdv_render_data_marker (context, cr, x, y, GDV_POINT_TYPE_CIRCLE);
+}
+
+/**
+ * gdv_render_data_marker:
+ * @context: a #GtkStyleContext
+ * @cr: a #cairo_t
+ * @x: the x-position of the data-point
+ * @y: the y-position of the data-point
+ * @point_type: the symbol of the data-point
+ *
+ * Renders a single data-point with the given symbol, as it is done for the
+ * data-points of a #GdvLayerContent with this #GdvLayerContent:point-type.
+ *
+ * Since: 0.1
+ **/
+void
+gdv_render_data_marker (GtkStyleContext *context,
+                        cairo_t         *cr,
+                        gdouble          x,
+                        gdouble          y,
+                        GdvPointType     point_type)
+{
+  GdvDataStyle style;
 
   g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
   g_return_if_fail (cr != NULL);
 
-  cairo_new_path (cr);
-
-  g_value_init (&value_lw, G_TYPE_DOUBLE);
-  g_value_init (&value_lc, GDK_TYPE_RGBA);
-
-  cairo_save (cr);
-
-  gtk_style_context_get_style_property (context,
-                                        "point-width", &value_lw);
-  gtk_style_context_get_style_property (context,
-                                        "point-color", &value_lc);
-
-  point_width = g_value_get_double (&value_lw);
-  color = g_value_get_boxed (&value_lc);
-
-  cairo_move_to (cr, x + 0.5, y + 0.5);
-
-  gdk_cairo_set_source_rgba(cr, color);
+  _gdv_data_style_resolve (context, &style);
 
-  if (point_width)
-  {
-    cairo_arc (cr,
-               x + 0.5, y + 0.5,
-               point_width,
-               0, 2 * G_PI);
-    cairo_fill (cr);
-  }
+  _gdv_marker_render_points (cr, point_type, style.point_width,
+                             &style.point_color, &x, &y, 1);
+}
 
-  cairo_restore (cr);
+/* resolves all style-properties needed to render data at once */
+G_GNUC_INTERNAL void
+_gdv_data_style_resolve (GtkStyleContext *context,
+                         GdvDataStyle    *style)
+{
+  GdkRGBA *point_color, *line_color;
+  gdouble prim_dash_port;
+  gdouble secon_dash_port;
+  gint dash_length;
 
-  g_value_unset (&value_lw);
-  g_value_unset (&value_lc);
+  gtk_style_context_get_style (context,
+                               "point-width", &style->point_width,
+                               "point-color", &point_color,
+                               "line-width", &style->line_width,
+                               "line-color", &line_color,
+                               "line-dash-portion", &prim_dash_port,
+                               "line-secondary-dash-portion", &secon_dash_port,
+                               "line-dash-length", &dash_length,
+                               NULL);
+
+  style->point_type = GDV_POINT_TYPE_CIRCLE;
+  style->point_color = *point_color;
+  style->line_color = *line_color;
+  gdk_rgba_free (point_color);
+  gdk_rgba_free (line_color);
+
+  style->dash_array[0] = prim_dash_port;
+  style->dash_array[1] = (1.0 - prim_dash_port - secon_dash_port) / 2.0;
+  style->dash_array[2] = secon_dash_port;
+  style->dash_array[3] = (1.0 - prim_dash_port - secon_dash_port) / 2.0;
+  style->n_dashes = CLAMP (dash_length, 0, G_N_ELEMENTS (style->dash_array));
 }
 
 static void
@@ -437,65 +472,22 @@ gdv_do_render_data_line (GtkStyleContext *context,
                          gdouble          x1,
                          gdouble          y1)
 {
-  GdkRGBA *color;
-  gdouble line_width;
-  gdouble prim_dash_port;
-  gdouble secon_dash_port;
-  gint dash_length;
-  GValue value_lw = G_VALUE_INIT;
-  GValue value_lc = G_VALUE_INIT;
-  GValue value_prim_dp = G_VALUE_INIT;
-  GValue value_sec_dp = G_VALUE_INIT;
-  GValue value_dash_length = G_VALUE_INIT;
-
-  g_value_init (&value_lw, G_TYPE_DOUBLE);
-  g_value_init (&value_lc, GDK_TYPE_RGBA);
-  g_value_init (&value_prim_dp, G_TYPE_DOUBLE);
-  g_value_init (&value_sec_dp, G_TYPE_DOUBLE);
-  g_value_init (&value_dash_length, G_TYPE_INT);
-
-  gtk_style_context_get_style_property (context,
-                                        "line-width", &value_lw);
-  gtk_style_context_get_style_property (context,
-                                        "line-color", &value_lc);
-  gtk_style_context_get_style_property (context,
-                                        "line-dash-portion", &value_prim_dp);
-  gtk_style_context_get_style_property (context,
-                                        "line-secondary-dash-portion", &value_sec_dp);
-  gtk_style_context_get_style_property (context,
-                                        "line-dash-length", &value_dash_length);
+  GdvDataStyle style;
 
-  line_width = g_value_get_double (&value_lw);
-  color = g_value_get_boxed (&value_lc);
-  prim_dash_port = g_value_get_double (&value_prim_dp);
-  secon_dash_port = g_value_get_double (&value_sec_dp);
-  dash_length = g_value_get_int (&value_dash_length);
+  _gdv_data_style_resolve (context, &style);
 
-  if (line_width)
+  if (style.line_width)
   {
-    gdouble dash_array[] =
-    {
-      prim_dash_port, (1.0 - prim_dash_port - secon_dash_port) / 2.0,
-      secon_dash_port, (1.0 - prim_dash_port - secon_dash_port) / 2.0
-    };
-
     cairo_move_to (cr, x0 + 0.5, y0 + 0.5);
     cairo_line_to (cr, x1 + 0.5, y1 + 0.5);
-    cairo_set_line_width (cr, line_width);
+    cairo_set_line_width (cr, style.line_width);
 
-//    g_print ("LC\n");
-    gdk_cairo_set_source_rgba(cr, color);
+    gdk_cairo_set_source_rgba(cr, &style.line_color);
 
-    cairo_set_dash (cr, dash_array, dash_length, 0.0);
+    cairo_set_dash (cr, style.dash_array, style.n_dashes, 0.0);
 
     cairo_stroke (cr);
   }
-
-  g_value_unset (&value_lw);
-  g_value_unset (&value_lc);
-  g_value_unset (&value_prim_dp);
-  g_value_unset (&value_sec_dp);
-  g_value_unset (&value_dash_length);
 }
 
 
@@ -517,3 +509,379 @@ void        gdv_render_data_line            (GtkStyleContext     *context,
 
   cairo_restore (cr);
 }
+
+/* points closer than this (in pixels and in both directions) are merged */
+#define GDV_RENDER_SUBPIXEL 0.5
+/* maximum distance (in pixels) of a dropped vertex from the line, that
+ * replaces it */
+#define GDV_RENDER_COLLINEAR_TOLERANCE 0.25
+
+static inline gboolean
+_gdv_render_is_subpixel (gdouble x0, gdouble y0, gdouble x1, gdouble y1)
+{
+  return fabs (x1 - x0) < GDV_RENDER_SUBPIXEL &&
+         fabs (y1 - y0) < GDV_RENDER_SUBPIXEL;
+}
+
+static inline gdouble
+_gdv_render_cross (gdouble x0, gdouble y0, gdouble x1, gdouble y1)
+{
+  return x0 * y1 - y0 * x1;
+}
+
+/* The visible rectangle, against which the segments are clipped */
+typedef struct
+{
+  gdouble x0;
+  gdouble y0;
+  gdouble x1;
+  gdouble y1;
+} GdvRenderClip;
+
+/* Clips the segment from (x0, y0) to (x1, y1) with the algorithm of
+ * Liang and Barsky. Gives FALSE, if the segment is outside the rectangle, and
+ * the parameters of the begin and the end of the inner part otherwise. */
+static inline gboolean
+_gdv_render_clip_segment (const GdvRenderClip *clip,
+                          gdouble              x0,
+                          gdouble              y0,
+                          gdouble              x1,
+                          gdouble              y1,
+                          gdouble             *t_beg,
+                          gdouble             *t_end)
+{
+  gdouble p[4], q[4];
+  guint k;
+
+  /* a gap in the data */
+  if (!isfinite (x0) || !isfinite (y0) || !isfinite (x1) || !isfinite (y1))
+    return FALSE;
+
+  p[0] = x0 - x1;
+  q[0] = x0 - clip->x0;
+  p[1] = x1 - x0;
+  q[1] = clip->x1 - x0;
+  p[2] = y0 - y1;
+  q[2] = y0 - clip->y0;
+  p[3] = y1 - y0;
+  q[3] = clip->y1 - y0;
+
+  *t_beg = 0.0;
+  *t_end = 1.0;
+
+  for (k = 0; k < 4; k++)
+  {
+    gdouble t;
+
+    /* parallel to this edge */
+    if (p[k] == 0.0)
+    {
+      if (q[k] < 0.0)
+        return FALSE;
+
+      continue;
+    }
+
+    t = q[k] / p[k];
+
+    if (p[k] < 0.0)
+    {
+      if (t > *t_end)
+        return FALSE;
+      if (t > *t_beg)
+        *t_beg = t;
+    }
+    else
+    {
+      if (t < *t_beg)
+        return FALSE;
+      if (t < *t_end)
+        *t_end = t;
+    }
+  }
+
+  return TRUE;
+}
+
+/* The state of a path, while it is built from the clipped segments; a vertex
+ * is kept pending, until it is clear, that it makes a visible difference */
+typedef struct
+{
+  cairo_t *cr;
+  gboolean open;
+  gdouble last_x;
+  gdouble last_y;
+  gboolean has_pending;
+  gdouble pend_x;
+  gdouble pend_y;
+
+  /* the directions from the last vertex, in which a line passes all dropped
+   * vertices within GDV_RENDER_COLLINEAR_TOLERANCE; they reach from lo
+   * counter-clockwise to hi */
+  gboolean has_corridor;
+  gdouble lo_x;
+  gdouble lo_y;
+  gdouble hi_x;
+  gdouble hi_y;
+} GdvRenderPath;
+
+static void
+_gdv_render_path_close (GdvRenderPath *path)
+{
+  if (path->has_pending)
+    cairo_line_to (path->cr, path->pend_x + 0.5, path->pend_y + 0.5);
+
+  path->has_pending = FALSE;
+  path->has_corridor = FALSE;
+  path->open = FALSE;
+}
+
+static void
+_gdv_render_path_move_to (GdvRenderPath *path,
+                          gdouble        x,
+                          gdouble        y)
+{
+  _gdv_render_path_close (path);
+
+  cairo_move_to (path->cr, x + 0.5, y + 0.5);
+  path->last_x = x;
+  path->last_y = y;
+  path->open = TRUE;
+}
+
+/* TRUE, if the pending vertex may be dropped in favour of a line from the
+ * last vertex to (x, y). This is the case, if the line passes the pending
+ * vertex and all vertices dropped before within the tolerance; the corridor
+ * of the path is narrowed to the directions, that still do so. */
+static gboolean
+_gdv_render_path_narrow (GdvRenderPath *path,
+                         gdouble        x,
+                         gdouble        y)
+{
+  gdouble vx = path->pend_x - path->last_x;
+  gdouble vy = path->pend_y - path->last_y;
+  gdouble dx = x - path->last_x;
+  gdouble dy = y - path->last_y;
+  gdouble lo_x, lo_y, hi_x, hi_y;
+  gdouble length;
+
+  /* the pending vertex has to lie between both ends */
+  if (vx * (x - path->pend_x) + vy * (y - path->pend_y) < 0.0)
+    return FALSE;
+
+  length = hypot (vx, vy);
+
+  if (length > GDV_RENDER_COLLINEAR_TOLERANCE)
+  {
+    gdouble sin_a = GDV_RENDER_COLLINEAR_TOLERANCE / length;
+    gdouble cos_a = sqrt (1.0 - sin_a * sin_a);
+
+    vx /= length;
+    vy /= length;
+
+    /* the cone of directions, that pass the pending vertex */
+    lo_x = vx * cos_a + vy * sin_a;
+    lo_y = vy * cos_a - vx * sin_a;
+    hi_x = vx * cos_a - vy * sin_a;
+    hi_y = vy * cos_a + vx * sin_a;
+
+    if (path->has_corridor)
+    {
+      if (_gdv_render_cross (lo_x, lo_y, path->lo_x, path->lo_y) > 0.0)
+      {
+        lo_x = path->lo_x;
+        lo_y = path->lo_y;
+      }
+
+      if (_gdv_render_cross (path->hi_x, path->hi_y, hi_x, hi_y) > 0.0)
+      {
+        hi_x = path->hi_x;
+        hi_y = path->hi_y;
+      }
+    }
+  }
+  else if (path->has_corridor)
+  {
+    lo_x = path->lo_x;
+    lo_y = path->lo_y;
+    hi_x = path->hi_x;
+    hi_y = path->hi_y;
+  }
+  else
+    return TRUE;
+
+  if (_gdv_render_cross (lo_x, lo_y, dx, dy) < 0.0 ||
+      _gdv_render_cross (dx, dy, hi_x, hi_y) < 0.0)
+    return FALSE;
+
+  path->has_corridor = TRUE;
+  path->lo_x = lo_x;
+  path->lo_y = lo_y;
+  path->hi_x = hi_x;
+  path->hi_y = hi_y;
+
+  return TRUE;
+}
+
+static void
+_gdv_render_path_line_to (GdvRenderPath *path,
+                          gdouble        x,
+                          gdouble        y)
+{
+  if (!path->has_pending)
+  {
+    if (_gdv_render_is_subpixel (path->last_x, path->last_y, x, y))
+      return;
+
+    path->pend_x = x;
+    path->pend_y = y;
+    path->has_pending = TRUE;
+    return;
+  }
+
+  if (_gdv_render_is_subpixel (path->pend_x, path->pend_y, x, y))
+    return;
+
+  if (!_gdv_render_path_narrow (path, x, y))
+  {
+    cairo_line_to (path->cr, path->pend_x + 0.5, path->pend_y + 0.5);
+    path->last_x = path->pend_x;
+    path->last_y = path->pend_y;
+    path->has_corridor = FALSE;
+  }
+
+  path->pend_x = x;
+  path->pend_y = y;
+}
+
+/* Appends the line through all points to cr. Every segment is clipped, so
+ * no coordinate far outside of clip reaches cairo; a segment, that leaves
+ * the rectangle, ends the sub-path, and the next one, that enters it, starts
+ * a new sub-path at the edge. Vertices that would not make a visible
+ * difference are skipped. */
+static void
+_gdv_render_append_polyline (cairo_t             *cr,
+                             const GdvRenderClip *clip,
+                             const gdouble       *px,
+                             const gdouble       *py,
+                             gsize                n_points)
+{
+  GdvRenderPath path = { cr, FALSE, 0.0, 0.0, FALSE, 0.0, 0.0,
+                         FALSE, 0.0, 0.0, 0.0, 0.0 };
+  gsize i;
+
+  for (i = 1; i < n_points; i++)
+  {
+    gdouble dx = px[i] - px[i - 1];
+    gdouble dy = py[i] - py[i - 1];
+    gdouble t_beg, t_end;
+
+    if (!_gdv_render_clip_segment (clip, px[i - 1], py[i - 1], px[i], py[i],
+                                   &t_beg, &t_end))
+    {
+      _gdv_render_path_close (&path);
+      continue;
+    }
+
+    if (!path.open)
+      _gdv_render_path_move_to (&path,
+                                px[i - 1] + t_beg * dx,
+                                py[i - 1] + t_beg * dy);
+
+    if (t_end < 1.0)
+    {
+      _gdv_render_path_line_to (&path,
+                                px[i - 1] + t_end * dx,
+                                py[i - 1] + t_end * dy);
+      _gdv_render_path_close (&path);
+    }
+    else
+      _gdv_render_path_line_to (&path, px[i], py[i]);
+  }
+
+  _gdv_render_path_close (&path);
+}
+
+/**
+ * gdv_render_data_polyline:
+ * @context: a #GtkStyleContext
+ * @cr: a #cairo_t
+ * @px: (array length=n_points): the x-positions of the data-points
+ * @py: (array length=n_points): the y-positions of the data-points
+ * @n_points: the number of data-points
+ *
+ * Renders a series of data-points together with the line that connects them.
+ * In contrast to calling gdv_render_data_point() and gdv_render_data_line()
+ * for every single point, the style is resolved only once. The symbol of the
+ * points is rasterized once and copied onto every point, and the line is
+ * painted with a single stroke. Segments shorter than a pixel and vertices,
+ * that the line passes within a quarter of a pixel anyway, are collapsed
+ * before drawing. The line is clipped to the clip of @cr, so points far
+ * outside of it are cheap and still connected correctly to the visible
+ * ones. Points, that are not finite, interrupt the line.
+ *
+ * Since: 0.1
+ **/
+void
+gdv_render_data_polyline (GtkStyleContext *context,
+                          cairo_t         *cr,
+                          const gdouble   *px,
+                          const gdouble   *py,
+                          gsize            n_points)
+{
+  GdvDataStyle style;
+
+  g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
+  g_return_if_fail (cr != NULL);
+
+  if (n_points == 0)
+    return;
+
+  g_return_if_fail (px != NULL && py != NULL);
+
+  _gdv_data_style_resolve (context, &style);
+  _gdv_render_data_polyline_styled (&style, cr, px, py, n_points);
+}
+
+/* Does the work of gdv_render_data_polyline() with an already resolved
+ * style; it does not touch any widget, so it may run on a worker-thread. */
+G_GNUC_INTERNAL void
+_gdv_render_data_polyline_styled (const GdvDataStyle *style,
+                                  cairo_t            *cr,
+                                  const gdouble      *px,
+                                  const gdouble      *py,
+                                  gsize               n_points)
+{
+  if (n_points == 0)
+    return;
+
+  cairo_save (cr);
+  cairo_new_path (cr);
+
+  if (style->point_width)
+    _gdv_marker_render_points (cr, style->point_type, style->point_width,
+                               &style->point_color, px, py, n_points);
+
+  if (style->line_width && n_points > 1)
+  {
+    GdvRenderClip clip;
+
+    /* the edges are moved out, until the stroke and the joins of the cut
+     * segments are invisible; the vertices are drawn half a pixel off */
+    cairo_clip_extents (cr, &clip.x0, &clip.y0, &clip.x1, &clip.y1);
+    clip.x0 -= style->line_width + 1.5;
+    clip.y0 -= style->line_width + 1.5;
+    clip.x1 += style->line_width + 0.5;
+    clip.y1 += style->line_width + 0.5;
+
+    _gdv_render_append_polyline (cr, &clip, px, py, n_points);
+
+    cairo_set_line_width (cr, style->line_width);
+    gdk_cairo_set_source_rgba (cr, &style->line_color);
+    cairo_set_dash (cr, style->dash_array, style->n_dashes, 0.0);
+
+    cairo_stroke (cr);
+  }
+
+  cairo_restore (cr);
+}
@@ -27,6 +27,7 @@
 #include <gtk/gtk.h>
 
 #include "gdvcentral.h"
+#include "gdv-enums.h"
 #include <cairo/cairo.h>
 
 G_BEGIN_DECLS
@@ -63,6 +64,18 @@ void        gdv_render_data_point           (GtkStyleContext     *context,
     gdouble              x,
     gdouble              y);
 
+void        gdv_render_data_marker          (GtkStyleContext     *context,
+                                             cairo_t             *cr,
+                                             gdouble              x,
+                                             gdouble              y,
+                                             GdvPointType         point_type);
+
+void        gdv_render_data_polyline        (GtkStyleContext     *context,
+                                             cairo_t             *cr,
+                                             const gdouble       *px,
+                                             const gdouble       *py,
+                                             gsize                n_points);
+
 G_END_DECLS
 
 #endif /* GDV_RENDER_H_INCLUDED */
@@ -0,0 +1,73 @@
+/*
+ * gdvtheme.c
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include <config.h>
+#endif
+
+#include "gdvtheme-private.h"
+
+/* The default style of all gdv widgets; it is parsed only once and shared by
+ * the style-contexts of all instances. */
+#define GDV_THEME_RESOURCE "/net/gdv/libgdv/themes/default_general.css"
+
+static GtkCssProvider *theme_provider = NULL;
+
+/*
+ * _gdv_theme_get_provider:
+ *
+ * Gives the provider of the default theme. It is created, when it is needed
+ * for the first time, and then kept for the lifetime of the library; every
+ * style-context, that uses it, holds another reference.
+ *
+ * Returns: (transfer none): the provider of the default theme
+ */
+GtkStyleProvider *
+_gdv_theme_get_provider (void)
+{
+  if (g_once_init_enter (&theme_provider))
+  {
+    GtkCssProvider *provider = gtk_css_provider_new ();
+
+    gtk_css_provider_load_from_resource (provider, GDV_THEME_RESOURCE);
+    g_once_init_leave (&theme_provider, provider);
+  }
+
+  return GTK_STYLE_PROVIDER (theme_provider);
+}
+
+/*
+ * _gdv_theme_add_to_context:
+ * @context: a #GtkStyleContext
+ *
+ * Adds the default theme to @context with fallback-priority, so that it can
+ * be overridden by every application and theme.
+ */
+void
+_gdv_theme_add_to_context (GtkStyleContext *context)
+{
+  g_return_if_fail (GTK_IS_STYLE_CONTEXT (context));
+
+  gtk_style_context_add_provider (context,
+                                  _gdv_theme_get_provider (),
+                                  GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+}
@@ -41,6 +41,7 @@
  */
 
 #include "gdvtic.h"
+#include "gdvtheme-private.h"
 #include "gdv-data-boxed.h"
 #include "gdvrender.h"
 //#include <gdv/gdvcentral.h>
@@ -141,18 +142,9 @@ gdv_tic_init (GdvTic *tic)
 {
   GtkWidget *widget = GTK_WIDGET (tic);
   GtkStyleContext *style_context;
-  GtkCssProvider *css_provider;
 
-  css_provider = gtk_css_provider_new ();
   style_context = gtk_widget_get_style_context (widget);
-  gtk_css_provider_load_from_resource (
-    css_provider,
-    "/net/gdv/libgdv/themes/default_general.css");
-
-  gtk_style_context_add_provider (
-    style_context,
-    GTK_STYLE_PROVIDER (css_provider),
-    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
+  _gdv_theme_add_to_context (style_context);
 
   tic->priv = gdv_tic_get_instance_private (tic);
 
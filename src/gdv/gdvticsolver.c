@@ -0,0 +1,274 @@
+/*
+ * gdvticsolver.c
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include <config.h>
+#endif
+
+#include <math.h>
+
+#include "gdvticsolver.h"
+
+/**
+ * SECTION:gdvticsolver
+ * @title: Tic solver
+ * @short_description: choosing the increment of a linear scale
+ *
+ * The tic solver determines the increment of a linear scale, so that the
+ * distance of two tics is between the style-properties
+ * GdvAxis:scale-min-diff-pix and GdvAxis:scale-max-diff-pix. It does not
+ * depend on any widget; the space of the labels is estimated by a
+ * #GdvTicLengthFunc.
+ *
+ * All increments are taken from a ladder, that starts at the largest power
+ * of the base below the range. Smaller increments are this value divided by
+ * 2, 4, 5, 10, 20, 40, 50, 100, ...; larger ones are multiplied by 2, 4, 5,
+ * 10, 20, ... Instead of walking down the ladder, the solver estimates the
+ * right step from the available length and verifies the estimate only once.
+ */
+
+/* relative tolerance for values, that are exactly on the ladder */
+#define GDV_TIC_SOLVER_EPSILON 1e-9
+
+static const gdouble ladder_mantissa[] = {1.0, 2.0, 4.0, 5.0};
+
+/* The factor of step k on the ladder, relative to the base increment. Steps
+ * with k > 0 are smaller, steps with k < 0 are larger than the base. */
+static gdouble
+_ladder_factor (gint k)
+{
+  guint step = (guint) ABS (k);
+  gdouble factor = pow (10.0, (gdouble) (step / 4)) * ladder_mantissa[step % 4];
+
+  return k >= 0 ? 1.0 / factor : factor;
+}
+
+/* Gives the step with the smallest factor, that is at least factor */
+static gint
+_ladder_step_at_least (gdouble factor)
+{
+  gint k;
+
+  factor *= 1.0 - GDV_TIC_SOLVER_EPSILON;
+
+  /* start at the power of 10 below the factor; this takes at most 4 steps */
+  if (factor <= 1.0)
+    k = 4 * ((gint) floor (-log10 (factor)) + 1);
+  else
+    k = -4 * (gint) floor (log10 (factor));
+
+  while (_ladder_factor (k) < factor)
+    k--;
+
+  return k;
+}
+
+/**
+ * gdv_tic_solver_get_base_increment:
+ * @beg_val: the begin of the scale
+ * @end_val: the end of the scale
+ * @base: the base of the scale, usually 10
+ *
+ * Gives the largest power of @base, that is not larger than the range of the
+ * scale. This is where the ladder of increments starts.
+ *
+ * Returns: the base increment or 0.0 if the range is empty
+ */
+gdouble
+gdv_tic_solver_get_base_increment (gdouble beg_val,
+                                   gdouble end_val,
+                                   gdouble base)
+{
+  gdouble range = fabs (end_val - beg_val);
+
+  if (range == 0.0 || !isfinite (range) || base <= 1.0)
+    return 0.0;
+
+  return pow (base, floor (log (range) / log (base)));
+}
+
+/**
+ * gdv_tic_solver_round_limits:
+ * @beg_val: the begin of the scale
+ * @end_val: the end of the scale
+ * @increment: the increment of the scale
+ * @outwards: %TRUE to extend the scale to multiples of @increment and %FALSE
+ *     to shrink it
+ * @scale_beg: (out): the rounded begin
+ * @scale_end: (out): the rounded end
+ *
+ * Rounds the limits of a scale to multiples of @increment. Scales with
+ * @end_val below @beg_val are supported.
+ */
+void
+gdv_tic_solver_round_limits (gdouble  beg_val,
+                             gdouble  end_val,
+                             gdouble  increment,
+                             gboolean outwards,
+                             gdouble *scale_beg,
+                             gdouble *scale_end)
+{
+  if ((beg_val <= end_val) == outwards)
+  {
+    *scale_beg = increment * floor (beg_val / increment);
+    *scale_end = increment * ceil (end_val / increment);
+  }
+  else
+  {
+    *scale_beg = increment * ceil (beg_val / increment);
+    *scale_end = increment * floor (end_val / increment);
+  }
+}
+
+/* Evaluates a single step of the ladder */
+static void
+_evaluate_step (gdouble           beg_val,
+                gdouble           end_val,
+                gdouble           base_increment,
+                gint              step,
+                gdouble           pix_length,
+                GdvTicLengthFunc  length_func,
+                gpointer          user_data,
+                GdvTicSolution   *solution)
+{
+  gdouble length, scale_length;
+
+  solution->increment = base_increment * _ladder_factor (step);
+
+  gdv_tic_solver_round_limits (beg_val, end_val, solution->increment, TRUE,
+                               &solution->scale_beg, &solution->scale_end);
+
+  if (length_func)
+  {
+    length = length_func (solution->scale_beg, solution->scale_end,
+                          pix_length, user_data);
+    solution->n_evaluations++;
+  }
+  else
+    length = pix_length;
+
+  scale_length = fabs (solution->scale_end - solution->scale_beg);
+
+  solution->n_tics =
+    (guint) floor (scale_length / solution->increment + 0.5) + 1;
+  solution->diff_pix = length * solution->increment / scale_length;
+}
+
+/**
+ * gdv_tic_solver_solve:
+ * @beg_val: the begin of the scale
+ * @end_val: the end of the scale
+ * @base: the base of the scale, usually 10
+ * @pix_length: the length of the axis in pixels
+ * @length_func: (scope call) (nullable): estimates the length that is left
+ *     for the scale
+ * @user_data: user data for @length_func
+ * @min_diff_pix: the minimal distance of two tics in pixels
+ * @max_diff_pix: the maximal distance of two tics in pixels
+ * @solution: (out caller-allocates): the increment and the rounded scale
+ *
+ * Determines the increment of a scale from @beg_val to @end_val, whose
+ * limits are extended to multiples of the increment.
+ *
+ * If the base increment fits, it is taken. Otherwise the increment is
+ * estimated from the length, that is left for the base increment, and
+ * verified once; if the verification fails, the next larger increment is
+ * taken. So @length_func is called at most three times.
+ *
+ * If there is enough space, the smallest increment is chosen, whose tics
+ * are at least @min_diff_pix apart. Values of @min_diff_pix below 1 are
+ * treated as 1.
+ *
+ * Returns: %FALSE if the range of the scale is empty and %TRUE otherwise
+ */
+gboolean
+gdv_tic_solver_solve (gdouble           beg_val,
+                      gdouble           end_val,
+                      gdouble           base,
+                      gdouble           pix_length,
+                      GdvTicLengthFunc  length_func,
+                      gpointer          user_data,
+                      gint              min_diff_pix,
+                      gint              max_diff_pix,
+                      GdvTicSolution   *solution)
+{
+  gdouble base_increment, length, target;
+  gint step;
+
+  g_return_val_if_fail (solution != NULL, FALSE);
+
+  /* otherwise there is no smallest increment */
+  min_diff_pix = MAX (min_diff_pix, 1);
+
+  solution->increment = 0.0;
+  solution->scale_beg = beg_val;
+  solution->scale_end = end_val;
+  solution->diff_pix = 0.0;
+  solution->n_tics = 0;
+  solution->n_evaluations = 0;
+  solution->fulfilled = FALSE;
+
+  base_increment = gdv_tic_solver_get_base_increment (beg_val, end_val, base);
+
+  if (base_increment == 0.0)
+    return FALSE;
+
+  /* estimate: the base increment */
+  _evaluate_step (beg_val, end_val, base_increment, 0,
+                  pix_length, length_func, user_data, solution);
+
+  if ((solution->diff_pix >= (gdouble) min_diff_pix &&
+       solution->diff_pix <= (gdouble) max_diff_pix) ||
+      /* a single interval, that is already too small */
+      (solution->n_tics <= 2 && solution->diff_pix < (gdouble) min_diff_pix) ||
+      solution->diff_pix <= 0.0)
+  {
+    solution->fulfilled =
+      solution->diff_pix >= (gdouble) min_diff_pix &&
+      solution->diff_pix <= (gdouble) max_diff_pix;
+
+    return TRUE;
+  }
+
+  /* Once the labels are known, the tic-distance scales linearly with the
+   * increment; so the smallest increment, that still keeps min_diff_pix, is
+   * known without trying every step in between. */
+  length = solution->diff_pix * fabs (solution->scale_end - solution->scale_beg) /
+           solution->increment;
+  target = (gdouble) min_diff_pix * fabs (end_val - beg_val) / length;
+  step = _ladder_step_at_least (target / base_increment);
+
+  /* verification */
+  _evaluate_step (beg_val, end_val, base_increment, step,
+                  pix_length, length_func, user_data, solution);
+
+  /* the rounded limits or the labels may take more space than estimated */
+  if (solution->diff_pix < (gdouble) min_diff_pix)
+    _evaluate_step (beg_val, end_val, base_increment, step - 1,
+                    pix_length, length_func, user_data, solution);
+
+  solution->fulfilled =
+    solution->diff_pix >= (gdouble) min_diff_pix &&
+    solution->diff_pix <= (gdouble) max_diff_pix;
+
+  return TRUE;
+}
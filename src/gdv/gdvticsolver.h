@@ -0,0 +1,96 @@
+/*
+ * gdvticsolver.h
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef GDV_TIC_SOLVER_H_INCLUDED
+#define GDV_TIC_SOLVER_H_INCLUDED
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * GdvTicLengthFunc:
+ * @first_value: the value of the first tic
+ * @last_value: the value of the last tic
+ * @pix_length: the length of the axis, that is available for the scale and
+ *     the labels
+ * @user_data: user data
+ *
+ * Estimates the space, that the labels of the first and the last tic will
+ * need.
+ *
+ * Returns: the length in pixels, that is left for the scale
+ */
+typedef gdouble (*GdvTicLengthFunc) (gdouble  first_value,
+                                     gdouble  last_value,
+                                     gdouble  pix_length,
+                                     gpointer user_data);
+
+typedef struct _GdvTicSolution GdvTicSolution;
+
+/**
+ * GdvTicSolution:
+ * @increment: the distance between two tics
+ * @scale_beg: the begin of the scale; a multiple of @increment
+ * @scale_end: the end of the scale; a multiple of @increment
+ * @diff_pix: the distance between two tics in pixels
+ * @n_tics: the number of tics from @scale_beg to @scale_end
+ * @n_evaluations: how often the #GdvTicLengthFunc was called
+ * @fulfilled: %TRUE if @diff_pix is within the requested limits
+ *
+ * The result of gdv_tic_solver_solve().
+ */
+struct _GdvTicSolution
+{
+  gdouble  increment;
+  gdouble  scale_beg;
+  gdouble  scale_end;
+  gdouble  diff_pix;
+  guint    n_tics;
+  guint    n_evaluations;
+  gboolean fulfilled;
+};
+
+gdouble  gdv_tic_solver_get_base_increment (gdouble beg_val,
+                                            gdouble end_val,
+                                            gdouble base);
+
+void     gdv_tic_solver_round_limits       (gdouble  beg_val,
+                                            gdouble  end_val,
+                                            gdouble  increment,
+                                            gboolean outwards,
+                                            gdouble *scale_beg,
+                                            gdouble *scale_end);
+
+gboolean gdv_tic_solver_solve              (gdouble           beg_val,
+                                            gdouble           end_val,
+                                            gdouble           base,
+                                            gdouble           pix_length,
+                                            GdvTicLengthFunc  length_func,
+                                            gpointer          user_data,
+                                            gint              min_diff_pix,
+                                            gint              max_diff_pix,
+                                            GdvTicSolution   *solution);
+
+G_END_DECLS
+
+#endif /* GDV_TIC_SOLVER_H_INCLUDED */
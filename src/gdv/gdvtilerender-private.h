@@ -0,0 +1,65 @@
+/* gdvtilerender-private.h
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#pragma once
+
+#include <gtk/gtk.h>
+
+#include "gdvrender-private.h"
+
+G_BEGIN_DECLS
+
+typedef struct _GdvTileJob GdvTileJob;
+
+/*
+ * GdvTileJobFunc:
+ * @job: the finished job
+ * @user_data: the data given to _gdv_tile_job_start()
+ *
+ * Called on the main-thread, once all tiles of @job are rendered.
+ */
+typedef void (*GdvTileJobFunc) (GdvTileJob *job,
+                                gpointer    user_data);
+
+G_GNUC_INTERNAL GdvTileJob *_gdv_tile_job_new (const GdvDataStyle *style,
+                                               gdouble            *px,
+                                               gdouble            *py,
+                                               gsize               n_points,
+                                               gboolean            ordered,
+                                               gint                width,
+                                               gint                height,
+                                               gint                scale);
+
+G_GNUC_INTERNAL GdvTileJob *_gdv_tile_job_ref (GdvTileJob *job);
+
+G_GNUC_INTERNAL void _gdv_tile_job_unref (GdvTileJob *job);
+
+G_GNUC_INTERNAL void _gdv_tile_job_start (GdvTileJob     *job,
+                                          GdvTileJobFunc  func,
+                                          gpointer        user_data);
+
+G_GNUC_INTERNAL void _gdv_tile_job_cancel (GdvTileJob *job);
+
+G_GNUC_INTERNAL void _gdv_tile_job_composite (GdvTileJob *job,
+                                              cairo_t    *cr);
+
+G_END_DECLS
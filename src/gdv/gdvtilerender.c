@@ -0,0 +1,413 @@
+/*
+ * gdvtilerender.c
+ * This file is part of gdv
+ *
+ * Copyright (C) 2013 - Emanuel Schmidt
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+  #include <config.h>
+#endif
+
+#include <math.h>
+
+#include "gdvtilerender-private.h"
+
+/* A job renders a polyline, whose points are already mapped onto pixels, in
+ * vertical tiles on a pool of worker-threads. Every tile gets an image
+ * surface of its own, so the workers share nothing but the read-only
+ * points; the tiles are composited on the main-thread afterwards.
+ *
+ * A tile only renders the parts of the polyline within its reach. For
+ * ordered points, these are found by bisection. Otherwise the segments are
+ * binned into runs of consecutive points per tile, before the job starts. */
+
+/* tiles are not made narrower than this number of pixels */
+#define GDV_TILE_JOB_MIN_WIDTH 32
+/* more tiles than threads even out tiles, that are more expensive */
+#define GDV_TILE_JOB_TILES_PER_THREAD 2
+
+/* the points begin..end-1 touch a tile */
+typedef struct
+{
+  gsize begin;
+  gsize end;
+} GdvTileRun;
+
+struct _GdvTileJob
+{
+  gint ref_count;
+  gint cancelled;
+  gint next_tile;
+  gint pending;
+
+  GdvDataStyle style;
+  gdouble *px;
+  gdouble *py;
+  gsize n_points;
+  gboolean ordered;
+
+  gint width;
+  gint height;
+  gint scale;
+  gint tile_width;
+  guint n_tiles;
+  cairo_surface_t **tiles;
+  GArray **runs;
+
+  GdvTileJobFunc func;
+  gpointer user_data;
+};
+
+static GThreadPool *tile_pool = NULL;
+
+static void _gdv_tile_job_run (gpointer data,
+                               gpointer user_data);
+
+/* the pool is shared by all jobs and kept for the lifetime of the library */
+static GThreadPool *
+_gdv_tile_job_get_pool (void)
+{
+  if (g_once_init_enter (&tile_pool))
+  {
+    GThreadPool *pool = g_thread_pool_new (_gdv_tile_job_run, NULL,
+                                           g_get_num_processors (),
+                                           FALSE, NULL);
+
+    g_once_init_leave (&tile_pool, pool);
+  }
+
+  return tile_pool;
+}
+
+/* the distance in pixels, up to which a point may color a tile */
+static gdouble
+_gdv_tile_job_reach (const GdvTileJob *job)
+{
+  return 0.5 * job->style.line_width + job->style.point_width + 1.0;
+}
+
+/* Collects the runs of points, that touch each tile; a segment belongs to all
+ * tiles, that the range of its x-positions reaches. */
+static void
+_gdv_tile_job_bin (GdvTileJob *job)
+{
+  gdouble reach = _gdv_tile_job_reach (job);
+  gsize n_segments = job->n_points > 1 ? job->n_points - 1 : job->n_points;
+  gsize i;
+  guint tile;
+
+  job->runs = g_new (GArray *, job->n_tiles);
+
+  for (tile = 0; tile < job->n_tiles; tile++)
+    job->runs[tile] = g_array_new (FALSE, FALSE, sizeof (GdvTileRun));
+
+  for (i = 0; i < n_segments; i++)
+  {
+    gsize last = MIN (i + 1, job->n_points - 1);
+    gdouble x_min = MIN (job->px[i], job->px[last]) - reach;
+    gdouble x_max = MAX (job->px[i], job->px[last]) + reach;
+    guint tile_beg, tile_end;
+
+    if (!isfinite (x_min) || !isfinite (x_max) ||
+        x_max < 0.0 || x_min >= job->width)
+      continue;
+
+    tile_beg = (guint) MAX (x_min, 0.0) / job->tile_width;
+    tile_end = MIN ((guint) MIN (x_max, job->width - 1) / job->tile_width,
+                    job->n_tiles - 1);
+
+    for (tile = tile_beg; tile <= tile_end; tile++)
+    {
+      GArray *runs = job->runs[tile];
+      GdvTileRun *run = runs->len ?
+        &g_array_index (runs, GdvTileRun, runs->len - 1) : NULL;
+
+      /* the run of the previous segment goes on */
+      if (run && run->end == i + 1)
+        run->end = last + 1;
+      else
+      {
+        GdvTileRun new_run = {i, last + 1};
+
+        g_array_append_val (runs, new_run);
+      }
+    }
+  }
+}
+
+/*
+ * _gdv_tile_job_new:
+ * @style: the resolved style of the data
+ * @px: (transfer full): the x-positions of the points
+ * @py: (transfer full): the y-positions of the points
+ * @n_points: the number of points
+ * @ordered: %TRUE, if @px is not decreasing; then the points within the
+ *     reach of a tile are found without binning them first
+ * @width: the width of the image
+ * @height: the height of the image
+ * @scale: the scale-factor of the image
+ *
+ * Creates a job, that renders the points into an image of the given size.
+ * The points are freed together with the job.
+ *
+ * Returns: (transfer full): a new job
+ */
+GdvTileJob *
+_gdv_tile_job_new (const GdvDataStyle *style,
+                   gdouble            *px,
+                   gdouble            *py,
+                   gsize               n_points,
+                   gboolean            ordered,
+                   gint                width,
+                   gint                height,
+                   gint                scale)
+{
+  GdvTileJob *job = g_new0 (GdvTileJob, 1);
+  guint max_tiles;
+
+  job->ref_count = 1;
+
+  job->style = *style;
+  job->px = px;
+  job->py = py;
+  job->n_points = n_points;
+  job->ordered = ordered;
+
+  job->width = MAX (width, 1);
+  job->height = MAX (height, 1);
+  job->scale = MAX (scale, 1);
+
+  max_tiles = MAX (job->width / GDV_TILE_JOB_MIN_WIDTH, 1);
+  job->n_tiles = MIN (GDV_TILE_JOB_TILES_PER_THREAD * g_get_num_processors (),
+                      max_tiles);
+  job->tile_width = (job->width + job->n_tiles - 1) / job->n_tiles;
+  job->tiles = g_new0 (cairo_surface_t *, job->n_tiles);
+
+  if (!ordered)
+    _gdv_tile_job_bin (job);
+
+  return job;
+}
+
+GdvTileJob *
+_gdv_tile_job_ref (GdvTileJob *job)
+{
+  g_atomic_int_inc (&job->ref_count);
+
+  return job;
+}
+
+void
+_gdv_tile_job_unref (GdvTileJob *job)
+{
+  guint i;
+
+  if (!g_atomic_int_dec_and_test (&job->ref_count))
+    return;
+
+  for (i = 0; i < job->n_tiles; i++)
+  {
+    g_clear_pointer (&job->tiles[i], cairo_surface_destroy);
+
+    if (job->runs)
+      g_array_unref (job->runs[i]);
+  }
+
+  g_free (job->tiles);
+  g_free (job->runs);
+  g_free (job->px);
+  g_free (job->py);
+  g_free (job);
+}
+
+/* the index of the first point, that is not left of bound */
+static gsize
+_gdv_tile_job_bisect (const GdvTileJob *job,
+                      gdouble           bound)
+{
+  gsize low = 0, high = job->n_points;
+
+  while (low < high)
+  {
+    gsize mid = low + (high - low) / 2;
+
+    if (job->px[mid] < bound)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+/* runs on a worker-thread */
+static cairo_surface_t *
+_gdv_tile_job_render_tile (GdvTileJob *job,
+                           guint       tile)
+{
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  gint x_beg = tile * job->tile_width;
+  gint x_end = MIN (x_beg + job->tile_width, job->width);
+
+  if (x_end <= x_beg)
+    return NULL;
+
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                        (x_end - x_beg) * job->scale,
+                                        job->height * job->scale);
+  cairo_surface_set_device_scale (surface, job->scale, job->scale);
+
+  cr = cairo_create (surface);
+  cairo_translate (cr, -x_beg, 0.0);
+  cairo_rectangle (cr, x_beg, 0.0, x_end - x_beg, job->height);
+  cairo_clip (cr);
+
+  /* the segments entering and leaving the tile are rendered as well */
+  if (job->ordered)
+  {
+    gdouble reach = _gdv_tile_job_reach (job);
+    gsize begin, end;
+
+    begin = _gdv_tile_job_bisect (job, x_beg - reach);
+    begin = begin > 0 ? begin - 1 : 0;
+    end = MIN (_gdv_tile_job_bisect (job, x_end + reach) + 1, job->n_points);
+
+    if (end > begin)
+      _gdv_render_data_polyline_styled (&job->style, cr,
+                                        job->px + begin, job->py + begin,
+                                        end - begin);
+  }
+  else
+  {
+    GArray *runs = job->runs[tile];
+    guint i;
+
+    for (i = 0; i < runs->len; i++)
+    {
+      GdvTileRun *run = &g_array_index (runs, GdvTileRun, i);
+
+      _gdv_render_data_polyline_styled (&job->style, cr,
+                                        job->px + run->begin,
+                                        job->py + run->begin,
+                                        run->end - run->begin);
+    }
+  }
+
+  cairo_destroy (cr);
+
+  return surface;
+}
+
+/* runs on the main-thread, after the last tile is done */
+static gboolean
+_gdv_tile_job_finish (gpointer data)
+{
+  GdvTileJob *job = data;
+
+  if (!g_atomic_int_get (&job->cancelled) && job->func)
+    job->func (job, job->user_data);
+
+  return G_SOURCE_REMOVE;
+}
+
+/* runs on a worker-thread; every call renders the next tile of the job */
+static void
+_gdv_tile_job_run (gpointer data,
+                   gpointer user_data)
+{
+  GdvTileJob *job = data;
+  guint tile = (guint) g_atomic_int_add (&job->next_tile, 1);
+
+  if (!g_atomic_int_get (&job->cancelled))
+    job->tiles[tile] = _gdv_tile_job_render_tile (job, tile);
+
+  /* the reference of this tile is handed over to the main-thread */
+  if (g_atomic_int_dec_and_test (&job->pending))
+    g_idle_add_full (G_PRIORITY_DEFAULT, _gdv_tile_job_finish, job,
+                     (GDestroyNotify) _gdv_tile_job_unref);
+  else
+    _gdv_tile_job_unref (job);
+}
+
+/*
+ * _gdv_tile_job_start:
+ * @job: a new job
+ * @func: called on the main-thread, when all tiles are rendered
+ * @user_data: data for @func
+ *
+ * Hands the tiles of @job over to the worker-threads. @func is not called,
+ * if the job is cancelled before.
+ */
+void
+_gdv_tile_job_start (GdvTileJob     *job,
+                     GdvTileJobFunc  func,
+                     gpointer        user_data)
+{
+  GThreadPool *pool = _gdv_tile_job_get_pool ();
+  guint i;
+
+  job->func = func;
+  job->user_data = user_data;
+
+  g_atomic_int_set (&job->pending, job->n_tiles);
+
+  for (i = 0; i < job->n_tiles; i++)
+    g_thread_pool_push (pool, _gdv_tile_job_ref (job), NULL);
+}
+
+/*
+ * _gdv_tile_job_cancel:
+ * @job: a job
+ *
+ * Stops @job; tiles, that are not yet started, are skipped. This may only
+ * be called on the main-thread.
+ */
+void
+_gdv_tile_job_cancel (GdvTileJob *job)
+{
+  g_atomic_int_set (&job->cancelled, TRUE);
+}
+
+/*
+ * _gdv_tile_job_composite:
+ * @job: a finished job
+ * @cr: the cairo-context to paint onto
+ *
+ * Paints the tiles of @job next to each other, starting at the origin of @cr.
+ */
+void
+_gdv_tile_job_composite (GdvTileJob *job,
+                         cairo_t    *cr)
+{
+  guint i;
+
+  cairo_save (cr);
+
+  for (i = 0; i < job->n_tiles; i++)
+  {
+    if (!job->tiles[i])
+      continue;
+
+    cairo_set_source_surface (cr, job->tiles[i], i * job->tile_width, 0.0);
+    cairo_paint (cr);
+  }
+
+  cairo_restore (cr);
+}
@@ -22,7 +22,6 @@
 
 /*
  * TODO:
- *  - overwrite widget-draw function
  *  - set halign and valign automatically, as well as the widget-name, when replacing an axis
  *  - or at least detect anything, that is set incorrectly
  *  - same problem with the orientations
@@ -36,11 +35,14 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "gdvtwodlayer.h"
 #include "gdvlinearaxis.h"
 #include "gdvaxis.h"
 #include "gdvaxis-private.h"
+#include "gdvlayer-private.h"
+#include "gdvtheme-private.h"
 #include "gdvlayercontent.h"
 #include "gdv-data-boxed.h"
 #include "gdvhair.h"
@@ -82,6 +84,17 @@ enum
   N_PROPERTIES
 };
 
+/* The inputs of the crossing-point alignment: the position of each axis
+ * within the layer and the space it needs around its begin and end. The
+ * order of the axes is x1, x2, y1, y2; the order of the directions is
+ * top, bottom, left, right. */
+typedef struct
+{
+  GtkAllocation axis_positions[4];
+  gint          beg_space[4][4];
+  gint          end_space[4][4];
+} GdvTwodLayerCrossing;
+
 struct _GdvTwodLayerPrivate
 {
   /* axes */
@@ -109,10 +122,32 @@ struct _GdvTwodLayerPrivate
   guint upp_right_x;
   guint upp_right_y;
 
-  GSList *x_marker_list, *y_marker_list;
+  /* the mesh is drawn by the layer itself from the tics of the axes; the
+   * style of the major and minor lines is read from the hair-nodes */
   gboolean marker_mesh;
+  GtkStyleContext *grid_context;
+  GtkStyleContext *mgrid_context;
+
+  /* the last alignment of the crossing-points; it is only solved again,
+   * when its inputs change */
+  GdvTwodLayerCrossing crossing;
+  gboolean             crossing_valid;
+  GtkAllocation        crossing_axis_allocations[4];
+  GtkAllocation        crossing_content_allocation;
+
+  /* debugging: the number of layout-passes within the current frame */
+  gint64 layout_frame;
+  guint  layout_passes;
+
+  /* contents move their rendered images along with scrolled axes */
+  gboolean strip_chart;
 };
 
+/* Allocating an axis may change its tics and therefore its spaces; the
+ * crossing-points are aligned again until the spaces settle, but at most
+ * this many times within a single allocation */
+#define GDV_TWOD_LAYER_MAX_ALIGN_ROUNDS 4
+
 enum
 {
   x = 0,
@@ -129,6 +164,16 @@ evaluate_data_point (GdvLayer *layer,
                      gdouble *pixel_x_value,
                      gdouble *pixel_y_value);
 static void
+evaluate_data_points (GdvLayer      *layer,
+                      const gdouble *x_values,
+                      const gdouble *y_values,
+                      const gdouble *z_values,
+                      gsize          n_points,
+                      gsize          stride,
+                      gdouble       *pos_x,
+                      gdouble       *pos_y,
+                      guint8        *in_range);
+static void
 gdv_twod_layer_size_allocate (GtkWidget           *widget,
                               GtkAllocation       *allocation);
 static void
@@ -162,6 +207,13 @@ gdv_twod_layer_measure (
 static void gdv_twod_layer_remove (
   GtkContainer   *container,
   GtkWidget      *child);
+static gboolean
+gdv_twod_layer_draw (GtkWidget *widget,
+                     cairo_t   *cr);
+static void
+gdv_twod_layer_style_updated (GtkWidget *widget);
+static void
+gdv_twod_layer_dispose (GObject *object);
 
 G_DEFINE_TYPE_WITH_PRIVATE (GdvTwodLayer,
                             gdv_twod_layer,
@@ -170,13 +222,18 @@ G_DEFINE_TYPE_WITH_PRIVATE (GdvTwodLayer,
 static void
 gdv_twod_layer_class_init (GdvTwodLayerClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
   GtkWidgetClass *widget_class = GTK_WIDGET_CLASS (klass);
   GdvLayerClass *layer_class = GDV_LAYER_CLASS (klass);
   GtkContainerClass *container_class = GTK_CONTAINER_CLASS (klass);
 
+  object_class->dispose = gdv_twod_layer_dispose;
+
   container_class->remove = gdv_twod_layer_remove;
 
   widget_class->size_allocate = gdv_twod_layer_size_allocate;
+  widget_class->draw = gdv_twod_layer_draw;
+  widget_class->style_updated = gdv_twod_layer_style_updated;
 
   widget_class->get_preferred_width =
     gdv_twod_layer_get_preferred_width;
@@ -188,6 +245,7 @@ gdv_twod_layer_class_init (GdvTwodLayerClass *klass)
     gdv_twod_layer_get_preferred_width_for_height;
 
   layer_class->evaluate_point = evaluate_data_point;
+  layer_class->evaluate_points = evaluate_data_points;
 
   gtk_widget_class_set_css_name (widget_class, "layertwod");
 
@@ -207,8 +265,8 @@ gdv_twod_layer_init (GdvTwodLayer *layer)
                             "visible", TRUE,
                             NULL));
   gtk_widget_set_name (GTK_WIDGET (layer->priv->x1_axis), "x1-axis");
-  gtk_overlay_add_overlay (GTK_OVERLAY (layer),
-                           GTK_WIDGET (layer->priv->x1_axis));
+  _gdv_layer_add_overlay (GDV_LAYER (layer),
+                          GTK_WIDGET (layer->priv->x1_axis));
 
   layer->priv->y1_axis =
     GDV_AXIS (g_object_new (gdv_linear_axis_get_type (),
@@ -219,8 +277,8 @@ gdv_twod_layer_init (GdvTwodLayer *layer)
                             "visible", TRUE,
                             NULL));
   gtk_widget_set_name (GTK_WIDGET (layer->priv->y1_axis), "y1-axis");
-  gtk_overlay_add_overlay (GTK_OVERLAY (layer),
-                           GTK_WIDGET (layer->priv->y1_axis));
+  _gdv_layer_add_overlay (GDV_LAYER (layer),
+                          GTK_WIDGET (layer->priv->y1_axis));
 
   layer->priv->x2_axis =
     GDV_AXIS (g_object_new (gdv_linear_axis_get_type (),
@@ -231,8 +289,8 @@ gdv_twod_layer_init (GdvTwodLayer *layer)
                             "visible", TRUE,
                             NULL));
   gtk_widget_set_name (GTK_WIDGET (layer->priv->x2_axis), "x2-axis");
-  gtk_overlay_add_overlay (GTK_OVERLAY (layer),
-                           GTK_WIDGET (layer->priv->x2_axis));
+  _gdv_layer_add_overlay (GDV_LAYER (layer),
+                          GTK_WIDGET (layer->priv->x2_axis));
 
   layer->priv->y2_axis =
     GDV_AXIS (g_object_new (gdv_linear_axis_get_type (),
@@ -243,14 +301,28 @@ gdv_twod_layer_init (GdvTwodLayer *layer)
                             "visible", TRUE,
                             NULL));
   gtk_widget_set_name (GTK_WIDGET (layer->priv->y2_axis), "y2-axis");
-  gtk_overlay_add_overlay (GTK_OVERLAY (layer),
-                           GTK_WIDGET (layer->priv->y2_axis));
+  _gdv_layer_add_overlay (GDV_LAYER (layer),
+                          GTK_WIDGET (layer->priv->y2_axis));
 
   layer->priv->min_max_refresh_x = TRUE;
   layer->priv->min_max_refresh_y = TRUE;
-  layer->priv->x_marker_list = NULL;
-  layer->priv->y_marker_list = NULL;
   layer->priv->marker_mesh = TRUE;
+
+  layer->priv->layout_frame = -1;
+  layer->priv->layout_passes = 0;
+
+  layer->priv->strip_chart = FALSE;
+}
+
+static void
+gdv_twod_layer_dispose (GObject *object)
+{
+  GdvTwodLayerPrivate *priv = GDV_TWOD_LAYER (object)->priv;
+
+  g_clear_object (&priv->grid_context);
+  g_clear_object (&priv->mgrid_context);
+
+  G_OBJECT_CLASS (gdv_twod_layer_parent_class)->dispose (object);
 }
 
 static void gdv_twod_layer_remove (
@@ -280,6 +352,30 @@ static void gdv_twod_layer_remove (
   }
 }
 
+static inline gboolean
+_axis_is_shown (GdvAxis *axis)
+{
+  return axis && gtk_widget_get_visible (GTK_WIDGET (axis));
+}
+
+/* maps values onto axis and translates the positions into layer
+ * coordinates */
+static inline void
+_map_on_axis (GdvAxis       *axis,
+              const gdouble *values,
+              gsize          n_values,
+              gsize          stride,
+              gdouble       *pos_x,
+              gdouble       *pos_y,
+              guint8        *in_range)
+{
+  const GdvAxisTransform *transform = _gdv_axis_get_transform (axis);
+
+  _gdv_axis_map_values (axis, values, n_values, stride,
+                        transform->origin_x, transform->origin_y,
+                        pos_x, pos_y, in_range);
+}
+
 static gboolean
 evaluate_data_point (GdvLayer *layer,
                      gdouble data_point_x_value,
@@ -288,99 +384,78 @@ evaluate_data_point (GdvLayer *layer,
                      gdouble *pixel_x_value,
                      gdouble *pixel_y_value)
 {
-  GdvTwodLayer *layer_2d;
-  gdouble x_pos_x1 = 0.0,
-          y_pos_x1 = 0.0,
-          x_pos_y1 = 0.0,
-          y_pos_y1 = 0.0;
-  gdouble x_pos_x2 = 0.0,
-          y_pos_x2 = 0.0,
-          x_pos_y2 = 0.0,
-          y_pos_y2 = 0.0;
-  gboolean on_x1_axis, on_x2_axis, on_y1_axis, on_y2_axis;
-  GtkAllocation local_allocation;
+  guint8 in_range;
 
   g_return_val_if_fail (GDV_IS_LAYER (layer), FALSE);
 
-  layer_2d = GDV_TWOD_LAYER (layer);
-
-  /* FIXME: make this a better interpolation of all axes */
-
-  if (layer_2d->priv->x1_axis &&
-      gtk_widget_get_visible (GTK_WIDGET (layer_2d->priv->x1_axis)))
-  {
-    g_signal_emit_by_name (layer_2d->priv->x1_axis,
-                           "get-point", data_point_x_value,
-                           &x_pos_x1, &y_pos_x1, &on_x1_axis);
-    gtk_widget_get_allocation (
-      GTK_WIDGET (layer_2d->priv->x1_axis),
-      &local_allocation);
-    x_pos_x1 += (gdouble) local_allocation.x;
-    y_pos_x1 += (gdouble) local_allocation.y;
-  }
-  else on_x1_axis = FALSE;
+  evaluate_data_points (layer,
+                        &data_point_x_value,
+                        &data_point_y_value,
+                        &data_point_z_value,
+                        1, 1,
+                        pixel_x_value, pixel_y_value,
+                        &in_range);
 
-  if (layer_2d->priv->x2_axis &&
-      gtk_widget_get_visible (GTK_WIDGET (layer_2d->priv->x2_axis)))
-  {
-    g_signal_emit_by_name (layer_2d->priv->x2_axis,
-                           "get-point", data_point_x_value,
-                           &x_pos_x2, &y_pos_x2, &on_x2_axis);
-    gtk_widget_get_allocation (
-      GTK_WIDGET (layer_2d->priv->x2_axis),
-      &local_allocation);
-    x_pos_x2 += (gdouble) local_allocation.x;
-    y_pos_x2 += (gdouble) local_allocation.y;
-  }
-  else on_x2_axis = FALSE;
+  return in_range & 1;
+}
 
-  if (layer_2d->priv->y1_axis &&
-      gtk_widget_get_visible (GTK_WIDGET (layer_2d->priv->y1_axis)))
-  {
-    g_signal_emit_by_name (layer_2d->priv->y1_axis,
-                           "get-point", data_point_y_value,
-                           &x_pos_y1, &y_pos_y1, &on_y1_axis);
-    gtk_widget_get_allocation (
-      GTK_WIDGET (layer_2d->priv->y1_axis),
-      &local_allocation);
-    x_pos_y1 += (gdouble) local_allocation.x;
-    y_pos_y1 += (gdouble) local_allocation.y;
-  }
-  else on_y1_axis = FALSE;
+static void
+evaluate_data_points (GdvLayer      *layer,
+                      const gdouble *x_values,
+                      const gdouble *y_values,
+                      const gdouble *z_values,
+                      gsize          n_points,
+                      gsize          stride,
+                      gdouble       *pos_x,
+                      gdouble       *pos_y,
+                      guint8        *in_range)
+{
+  GdvTwodLayerPrivate *priv = GDV_TWOD_LAYER (layer)->priv;
+  gboolean all_shown;
+  guint8 *range_mask;
+  gsize i;
 
-  if (layer_2d->priv->y2_axis &&
-      gtk_widget_get_visible (GTK_WIDGET (layer_2d->priv->y2_axis)))
+  if (!x_values || !y_values)
   {
-    g_signal_emit_by_name (layer_2d->priv->y2_axis,
-                           "get-point", data_point_y_value,
-                           &x_pos_y2, &y_pos_y2, &on_y2_axis);
-    gtk_widget_get_allocation (
-      GTK_WIDGET (layer_2d->priv->y2_axis),
-      &local_allocation);
-    x_pos_y2 += (gdouble) local_allocation.x;
-    y_pos_y2 += (gdouble) local_allocation.y;
+    GDV_LAYER_CLASS (gdv_twod_layer_parent_class)->evaluate_points (
+      layer, x_values, y_values, z_values, n_points, stride,
+      pos_x, pos_y, in_range);
+    return;
   }
-  else on_y2_axis = FALSE;
-
-  if (!layer_2d->priv->y1_axis && layer_2d->priv->y2_axis)
-    on_y1_axis = FALSE;
-
-  *pixel_x_value = x_pos_x1;
-  *pixel_y_value = y_pos_y1;
 
-  return on_x1_axis && on_y1_axis && on_x2_axis && on_y2_axis;
-}
+  /* FIXME: make this a better interpolation of all axes */
+  all_shown = _axis_is_shown (priv->x1_axis) &&
+              _axis_is_shown (priv->x2_axis) &&
+              _axis_is_shown (priv->y1_axis) &&
+              _axis_is_shown (priv->y2_axis);
+
+  /* a point is only in range, if it is on all four axes; the range-checks are
+   * skipped altogether, if one axis is missing. Without a shown axis in one
+   * direction, the points have no position at all in it. */
+  if (in_range)
+    memset (in_range, all_shown ? 0xff : 0x00, (n_points + 7) / 8);
+  range_mask = all_shown ? in_range : NULL;
+
+  if (_axis_is_shown (priv->x1_axis))
+    _map_on_axis (priv->x1_axis, x_values, n_points, stride,
+                  pos_x, NULL, range_mask);
+  else
+    for (i = 0; i < n_points; i++)
+      pos_x[i] = NAN;
 
-static void _hide_show_all_contents (GList *child_list, gboolean show)
-{
-  GList *child_list_cpy;
+  if (_axis_is_shown (priv->y1_axis))
+    _map_on_axis (priv->y1_axis, y_values, n_points, stride,
+                  NULL, pos_y, range_mask);
+  else
+    for (i = 0; i < n_points; i++)
+      pos_y[i] = NAN;
 
-  for (child_list_cpy = child_list;
-       child_list_cpy;
-       child_list_cpy = child_list_cpy->next)
+  if (range_mask)
   {
-    if (GDV_LAYER_IS_CONTENT (child_list_cpy->data))
-      gtk_widget_set_visible (child_list_cpy->data, show);
+    _map_on_axis (priv->x2_axis, x_values, n_points, stride,
+                  NULL, NULL, range_mask);
+    _map_on_axis (priv->y2_axis, y_values, n_points, stride,
+                  NULL, NULL, range_mask);
   }
 }
 
@@ -397,351 +472,292 @@ GdvTwodLayer *gdv_twod_layer_new (void)
                        NULL);
 }
 
-static gint _value_compare_func (GObject *tica, GObject *ticb)
+/* Creates the style-context of a grid-node; the grid has no widgets, so the
+ * nodes are appended to the path of the layer */
+static GtkStyleContext *
+_twod_layer_create_grid_context (GdvTwodLayer *layer,
+                                 gboolean      minor)
 {
-  gdouble value_a, value_b;
+  GtkStyleContext *parent, *context;
+  GtkWidgetPath *path;
+
+  parent = gtk_widget_get_style_context (GTK_WIDGET (layer));
 
-  g_object_get(tica, "value", &value_a, NULL);
-  g_object_get(ticb, "value", &value_b, NULL);
+  path = gtk_widget_path_copy (gtk_style_context_get_path (parent));
+  gtk_widget_path_append_type (path, GDV_TYPE_HAIR);
+  gtk_widget_path_iter_set_object_name (path, -1, "hair");
+  if (minor)
+    gtk_widget_path_iter_add_class (path, -1, "minor");
 
-  if (value_a < value_b)
-    return -1;
-  else if (value_a > value_b)
-    return 1;
+  context = gtk_style_context_new ();
+  gtk_style_context_set_path (context, path);
+  gtk_style_context_set_parent (context, parent);
+  gtk_style_context_set_scale (context, gtk_style_context_get_scale (parent));
+  _gdv_theme_add_to_context (context);
 
-  return 0;
+  gtk_widget_path_unref (path);
+
+  return context;
 }
 
-static GSList * _update_marker_list (
-  GdvTwodLayer *layer,
-  GSList *marker_list,
-  GdvAxis *axis1,
-  GdvAxis *axis2)
+/* a tic of either kind, that a grid-line may start or end at */
+typedef struct
 {
-  GList *tic_list1, *tic_list2;
-  GList *tic_list1_sorted, *tic_list2_sorted;
-  GList *tic_list1_cpy, *tic_list2_cpy;
-
-  tic_list1 = gdv_axis_get_tic_list (axis1);
-  tic_list2 = gdv_axis_get_tic_list (axis2);
+  gdouble value;
+  gdouble pos_x;
+  gdouble pos_y;
+} GdvTwodGridTic;
+
+static gint
+_twod_layer_compare_grid_tics (gconstpointer a,
+                               gconstpointer b)
+{
+  const GdvTwodGridTic *tic_a = a, *tic_b = b;
 
-  tic_list1_sorted = g_list_sort(tic_list1, (GCompareFunc) _value_compare_func);
-  tic_list2_sorted = g_list_sort(tic_list2, (GCompareFunc) _value_compare_func);
-  //g_list_free(tic_list1);
-  //g_list_free(tic_list2);
+  return (tic_a->value > tic_b->value) - (tic_a->value < tic_b->value);
+}
 
-  tic_list1_cpy = tic_list1_sorted;
-  tic_list2_cpy = tic_list2_sorted;
+static gboolean
+_twod_layer_grid_values_match (gdouble value_a,
+                               gdouble value_b,
+                               gdouble tolerance)
+{
+  return fabs (value_a - value_b) <=
+    MAX (tolerance, 1e-9 * MAX (fabs (value_a), fabs (value_b)));
+}
 
-  while(tic_list1_cpy && tic_list2_cpy)
-    {
-      gdouble tic_value1, tic_value2;
-      GSList *marker_list_cpy;
+/* Collects the tics of the given class, sorted by value. Besides the
+ * automatic tics, these are the tic-widgets, that are added by the user or by
+ * axes like the #GdvLogAxis. The positions are relative to the parent of the
+ * axis. */
+static GArray *
+_twod_layer_collect_grid_tics (GdvAxis  *axis,
+                               gboolean  minor)
+{
+  const GdvAxisTic *tics;
+  GtkAllocation allocation;
+  GArray *grid_tics;
+  GList *tic_list, *tic_iter;
+  gdouble tolerance = _gdv_axis_get_tic_tolerance (axis);
+  guint n_tics, i, n_unique = 0;
 
-      if (!G_IS_OBJECT(tic_list1_cpy->data) ||
-          !G_IS_OBJECT(tic_list2_cpy->data))
-        break;
+  grid_tics = g_array_new (FALSE, FALSE, sizeof (GdvTwodGridTic));
+  gtk_widget_get_allocation (GTK_WIDGET (axis), &allocation);
 
-      g_object_get(tic_list1_cpy->data, "value", &tic_value1, NULL);
-      g_object_get(tic_list2_cpy->data, "value", &tic_value2, NULL);
-
-      if (tic_value1 < tic_value2)
-        {
-          g_warning("Tics out of sync - value %e has no counterpart", tic_value1);
-          tic_list1_cpy = tic_list1_cpy->next;
-          continue;
-        }
-      else if (tic_value2 < tic_value1)
-        {
-          g_warning("Tics out of sync - value %e has no counterpart", tic_value2);
-          tic_list2_cpy = tic_list2_cpy->next;
-          continue;
-        }
-
-      marker_list_cpy = g_slist_find_custom (marker_list,
-                                             tic_list1_cpy->data,
-                                             (GCompareFunc) _value_compare_func);
-
-      if (!marker_list_cpy)
-/*        {
-          GdvHair *marker = marker_list_cpy->data;
-          g_object_set(marker,
-                       "from-axis", axis1,
-                       "to-axis", axis2,
-                       NULL);
-        }
-      else*/
-        {
-          GdvHair *marker =  g_object_new(GDV_TYPE_HAIR,
-                                          "halign", GTK_ALIGN_FILL,
-                                          "valign", GTK_ALIGN_FILL,
-                                          "from-axis", axis1,
-                                          "to-axis", axis2,
-                                          "visible", TRUE,
-                                          "value", tic_value1,
-                                          NULL);
-
-          marker_list = g_slist_insert_sorted (marker_list,
-                                               marker,
-                                               (GCompareFunc) _value_compare_func);
-
-//          if (gtk_widget_is_visible(GTK_WIDGET(layer)))
-          gtk_overlay_add_overlay (GTK_OVERLAY (layer),
-                                   GTK_WIDGET (marker));
-
-//          gtk_container_add(GTK_CONTAINER(layer), GTK_WIDGET(marker));
-        }
-
-
-//      for (marker_list_cpy = marker_list;
-//           marker_list_cpy; marker_list_cpy = marker_list_cpy->next)
-//        {
-//        }
-      // TODO: search for marker
-
-      tic_list1_cpy = tic_list1_cpy->next;
-      tic_list2_cpy = tic_list2_cpy->next;
-    }
+  tics = _gdv_axis_get_tics (axis, &n_tics);
 
-  g_list_free(tic_list1_sorted);
-  g_list_free(tic_list2_sorted);
+  for (i = 0; i < n_tics; i++)
+  {
+    GdvTwodGridTic grid_tic;
 
-  return marker_list;
-}
+    if (tics[i].minor != minor)
+      continue;
 
-static void
-gdv_twod_layer_size_allocate (
-  GtkWidget           *widget,
-  GtkAllocation       *allocation)
-{
-  /* TODO: Fix this by memcpy zero to all structs */
-  gint x1_beg_space[4] = {0};
-  gint x1_beg_space_nat[4] = {0};
-  gint x1_end_space[4] = {0};
-  gint x1_end_space_nat[4] = {0};
-
-  gint x2_beg_space[4] = {0};
-  gint x2_beg_space_nat[4] = {0};
-  gint x2_end_space[4] = {0};
-  gint x2_end_space_nat[4] = {0};
-
-  gint y1_beg_space[4] = {0};
-  gint y1_beg_space_nat[4] = {0};
-  gint y1_end_space[4] = {0};
-  gint y1_end_space_nat[4] = {0};
-
-  gint y2_beg_space[4] = {0};
-  gint y2_beg_space_nat[4] = {0};
-  gint y2_end_space[4] = {0};
-  gint y2_end_space_nat[4] = {0};
-
-  GList *list, *children, *children_copy;
-  GtkAllocation content_allocation = {0};
+    grid_tic.value = tics[i].value;
+    grid_tic.pos_x = tics[i].pos_x + allocation.x;
+    grid_tic.pos_y = tics[i].pos_y + allocation.y;
+    g_array_append_val (grid_tics, grid_tic);
+  }
 
-  GtkAllocation x1_allocation = {0},
-                x2_allocation = {0},
-                y1_allocation = {0},
-                y2_allocation = {0};
-  GdvTwodLayer *layer = GDV_TWOD_LAYER (widget);
-  GdvTwodLayerPrivate *priv = layer->priv;
+  tic_list = minor ? gdv_axis_get_mtic_list (axis) :
+                     gdv_axis_get_tic_list (axis);
 
-  g_return_if_fail (GDV_TWOD_IS_LAYER (widget));
-  g_return_if_fail (allocation != NULL);
+  for (tic_iter = tic_list; tic_iter; tic_iter = tic_iter->next)
+  {
+    GdvTwodGridTic grid_tic;
 
-  gtk_widget_set_allocation (GTK_WIDGET (layer), allocation);
+    g_object_get (tic_iter->data, "value", &grid_tic.value, NULL);
 
-  /*
-  g_print ("RUN ALLOC FROM START: X(%d, %d) - Y(%d, %d)\n",
-           allocation->x, allocation->width,
-           allocation->y, allocation->height);
-   */
+    if (!_gdv_axis_map_value (axis, grid_tic.value,
+                              &grid_tic.pos_x, &grid_tic.pos_y))
+      continue;
 
-  /* Measuring the x1-axis */
-  if (priv->x1_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->x1_axis)))
-  {
-    GTK_OVERLAY_CLASS (gdv_twod_layer_parent_class)->get_child_position (
-      GTK_OVERLAY (layer), GTK_WIDGET (layer->priv->x1_axis),
-      &x1_allocation);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_TOP, -1,
-                        &x1_beg_space[0], &x1_beg_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_BOTTOM, -1,
-                        &x1_beg_space[1], &x1_beg_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_LEFT, -1,
-                        &x1_beg_space[2], &x1_beg_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_RIGHT, -1,
-                        &x1_beg_space[3], &x1_beg_space_nat[3], NULL);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_TOP, -1,
-                        &x1_end_space[0], &x1_end_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_BOTTOM, -1,
-                        &x1_end_space[1], &x1_end_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_LEFT, -1,
-                        &x1_end_space[2], &x1_end_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x1_axis), GTK_POS_RIGHT, -1,
-                        &x1_end_space[3], &x1_end_space_nat[3], NULL);
+    grid_tic.pos_x += allocation.x;
+    grid_tic.pos_y += allocation.y;
+    g_array_append_val (grid_tics, grid_tic);
   }
 
-  /* Measuring the x2-axis */
-  if (priv->x2_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->x2_axis)))
+  g_list_free (tic_list);
+
+  g_array_sort (grid_tics, _twod_layer_compare_grid_tics);
+
+  /* a tic-widget on an automatic tic would draw its line twice */
+  for (i = 0; i < grid_tics->len; i++)
   {
-    GTK_OVERLAY_CLASS (gdv_twod_layer_parent_class)->get_child_position (
-      GTK_OVERLAY (layer), GTK_WIDGET (layer->priv->x2_axis),
-      &x2_allocation);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_TOP, -1,
-                        &x2_beg_space[0], &x2_beg_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_BOTTOM, -1,
-                        &x2_beg_space[1], &x2_beg_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_LEFT, -1,
-                        &x2_beg_space[2], &x2_beg_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_RIGHT, -1,
-                        &x2_beg_space[3], &x2_beg_space_nat[3], NULL);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_TOP, -1,
-                        &x2_end_space[0], &x2_end_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_BOTTOM, -1,
-                        &x2_end_space[1], &x2_end_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_LEFT, -1,
-                        &x2_end_space[2], &x2_end_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->x2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->x2_axis), GTK_POS_RIGHT, -1,
-                        &x2_end_space[3], &x2_end_space_nat[3], NULL);
+    GdvTwodGridTic *grid_tic = &g_array_index (grid_tics, GdvTwodGridTic, i);
+
+    if (n_unique &&
+        _twod_layer_grid_values_match (
+          g_array_index (grid_tics, GdvTwodGridTic, n_unique - 1).value,
+          grid_tic->value, tolerance))
+      continue;
+
+    g_array_index (grid_tics, GdvTwodGridTic, n_unique++) = *grid_tic;
   }
 
-  /* Measuring the y1-axis */
-  if (priv->y1_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->y1_axis)))
+  g_array_set_size (grid_tics, n_unique);
+
+  return grid_tics;
+}
+
+/* Adds a line to the path for every tic of the given class, that is present
+ * on both axes */
+static guint
+_twod_layer_append_grid_lines (cairo_t  *cr,
+                               GdvAxis  *axis1,
+                               GdvAxis  *axis2,
+                               gboolean  minor,
+                               gdouble   offset_x,
+                               gdouble   offset_y)
+{
+  GArray *tics1, *tics2;
+  gdouble tolerance;
+  guint index1 = 0, index2 = 0, n_lines = 0;
+
+  if (!axis1 || !axis2)
+    return 0;
+
+  tics1 = _twod_layer_collect_grid_tics (axis1, minor);
+  tics2 = _twod_layer_collect_grid_tics (axis2, minor);
+  tolerance = MAX (_gdv_axis_get_tic_tolerance (axis1),
+                   _gdv_axis_get_tic_tolerance (axis2));
+
+  /* both arrays are sorted, so the common values are merged in one pass */
+  while (index1 < tics1->len && index2 < tics2->len)
   {
-    GTK_OVERLAY_CLASS (gdv_twod_layer_parent_class)->get_child_position (
-      GTK_OVERLAY (layer), GTK_WIDGET (layer->priv->y1_axis),
-      &y1_allocation);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_TOP, -1,
-                        &y1_beg_space[0], &y1_beg_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_BOTTOM, -1,
-                        &y1_beg_space[1], &y1_beg_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_LEFT, -1,
-                        &y1_beg_space[2], &y1_beg_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_RIGHT, -1,
-                        &y1_beg_space[3], &y1_beg_space_nat[3], NULL);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_TOP, -1,
-                        &y1_end_space[0], &y1_end_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_BOTTOM, -1,
-                        &y1_end_space[1], &y1_end_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_LEFT, -1,
-                        &y1_end_space[2], &y1_end_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y1_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y1_axis), GTK_POS_RIGHT, -1,
-                        &y1_end_space[3], &y1_end_space_nat[3], NULL);
+    const GdvTwodGridTic *tic1 =
+      &g_array_index (tics1, GdvTwodGridTic, index1);
+    const GdvTwodGridTic *tic2 =
+      &g_array_index (tics2, GdvTwodGridTic, index2);
+
+    if (_twod_layer_grid_values_match (tic1->value, tic2->value, tolerance))
+    {
+      cairo_move_to (cr,
+                     tic1->pos_x - offset_x + 0.5,
+                     tic1->pos_y - offset_y + 0.5);
+      cairo_line_to (cr,
+                     tic2->pos_x - offset_x + 0.5,
+                     tic2->pos_y - offset_y + 0.5);
+      n_lines++;
+      index1++;
+      index2++;
+    }
+    else if (tic1->value < tic2->value)
+      index1++;
+    else
+      index2++;
   }
 
-  /* Measuring the y2-axis */
-  if (priv->y2_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->y2_axis)))
+  g_array_unref (tics1);
+  g_array_unref (tics2);
+
+  return n_lines;
+}
+
+/* Draws the mesh; all lines of one class are stroked at once */
+static void
+_twod_layer_draw_grid (GdvTwodLayer *layer,
+                       cairo_t      *cr)
+{
+  GdvTwodLayerPrivate *priv = layer->priv;
+  GtkAllocation allocation;
+  guint i;
+
+  gtk_widget_get_allocation (GTK_WIDGET (layer), &allocation);
+
+  for (i = 0; i < 2; i++)
   {
-    GTK_OVERLAY_CLASS (gdv_twod_layer_parent_class)->get_child_position (
-      GTK_OVERLAY (layer), GTK_WIDGET (layer->priv->y2_axis),
-      &y2_allocation);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_TOP, -1,
-                        &y2_beg_space[0], &y2_beg_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_BOTTOM, -1,
-                        &y2_beg_space[1], &y2_beg_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_LEFT, -1,
-                        &y2_beg_space[2], &y2_beg_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_beg_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_RIGHT, -1,
-                        &y2_beg_space[3], &y2_beg_space_nat[3], NULL);
-
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_TOP, -1,
-                        &y2_end_space[0], &y2_end_space_nat[0], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_BOTTOM, -1,
-                        &y2_end_space[1], &y2_end_space_nat[1], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_LEFT, -1,
-                        &y2_end_space[2], &y2_end_space_nat[2], NULL);
-    GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                      layer->priv->y2_axis))->get_space_to_end_position (
-                        GDV_AXIS (layer->priv->y2_axis), GTK_POS_RIGHT, -1,
-                        &y2_end_space[3], &y2_end_space_nat[3], NULL);
+    gboolean minor = i == 1;
+    GtkStyleContext **context = minor ? &priv->mgrid_context :
+                                        &priv->grid_context;
+    GdkRGBA *color = NULL;
+    gdouble line_width = 0.0;
+    guint n_lines;
+
+    if (!*context)
+      *context = _twod_layer_create_grid_context (layer, minor);
+
+    gtk_style_context_get_style (*context,
+                                 "line-width", &line_width,
+                                 "color", &color,
+                                 NULL);
+
+    if (line_width <= 0.0 || !color)
+    {
+      if (color)
+        gdk_rgba_free (color);
+      continue;
+    }
+
+    cairo_save (cr);
+    cairo_new_path (cr);
+
+    n_lines =
+      _twod_layer_append_grid_lines (cr, priv->x1_axis, priv->x2_axis, minor,
+                                     allocation.x, allocation.y) +
+      _twod_layer_append_grid_lines (cr, priv->y1_axis, priv->y2_axis, minor,
+                                     allocation.x, allocation.y);
+
+    if (n_lines)
+    {
+      cairo_set_line_cap (cr, CAIRO_LINE_CAP_SQUARE);
+      cairo_set_line_width (cr, line_width);
+      gdk_cairo_set_source_rgba (cr, color);
+      cairo_stroke (cr);
+    }
+
+    cairo_restore (cr);
+    gdk_rgba_free (color);
   }
+}
 
-  /*
-  g_print ("\tX1 SPACE: (%d, %d, %d, %d) - (%d, %d, %d, %d)\n",
-           x1_beg_space[0], x1_beg_space[1], x1_beg_space[2], x1_beg_space[3],
-           x1_end_space[0], x1_end_space[1], x1_end_space[2], x1_end_space[3]);
-  g_print ("\tX2 SPACE: (%d, %d, %d, %d) - (%d, %d, %d, %d)\n",
-           x2_beg_space[0], x2_beg_space[1], x2_beg_space[2], x2_beg_space[3],
-           x2_end_space[0], x2_end_space[1], x2_end_space[2], x2_end_space[3]);
-  g_print ("\tY1 SPACE: (%d, %d, %d, %d) - (%d, %d, %d, %d)\n",
-           y1_beg_space[0], y1_beg_space[1], y1_beg_space[2], y1_beg_space[3],
-           y1_end_space[0], y1_end_space[1], y1_end_space[2], y1_end_space[3]);
-  g_print ("\tY2 SPACE: (%d, %d, %d, %d) - (%d, %d, %d, %d)\n",
-           y2_beg_space[0], y2_beg_space[1], y2_beg_space[2], y2_beg_space[3],
-           y2_end_space[0], y2_end_space[1], y2_end_space[2], y2_end_space[3]);
-  */
+static gboolean
+gdv_twod_layer_draw (GtkWidget *widget,
+                     cairo_t   *cr)
+{
+  GdvTwodLayer *layer = GDV_TWOD_LAYER (widget);
+
+  GTK_WIDGET_CLASS (gdv_twod_layer_parent_class)->draw (widget, cr);
+
+  /* like the hairs before, the mesh lies on top of all children */
+  if (layer->priv->marker_mesh)
+    _twod_layer_draw_grid (layer, cr);
+
+  return FALSE;
+}
+
+static void
+gdv_twod_layer_style_updated (GtkWidget *widget)
+{
+  GdvTwodLayerPrivate *priv = GDV_TWOD_LAYER (widget)->priv;
+
+  GTK_WIDGET_CLASS (gdv_twod_layer_parent_class)->style_updated (widget);
+
+  g_clear_object (&priv->grid_context);
+  g_clear_object (&priv->mgrid_context);
+}
+
+/* Aligns the crossing-points between x- and y-axes and determines the
+ * content-allocation from the positions and spaces of all axes */
+static void
+_twod_layer_align_crossings (const GdvTwodLayerCrossing *crossing,
+                             GtkAllocation              *axis_allocations,
+                             GtkAllocation              *content_allocation_out)
+{
+  const gint *x1_beg_space = crossing->beg_space[0];
+  const gint *x1_end_space = crossing->end_space[0];
+  const gint *x2_beg_space = crossing->beg_space[1];
+  const gint *x2_end_space = crossing->end_space[1];
+  const gint *y1_beg_space = crossing->beg_space[2];
+  const gint *y1_end_space = crossing->end_space[2];
+  const gint *y2_beg_space = crossing->beg_space[3];
+  const gint *y2_end_space = crossing->end_space[3];
+
+  GtkAllocation x1_allocation = crossing->axis_positions[0],
+                x2_allocation = crossing->axis_positions[1],
+                y1_allocation = crossing->axis_positions[2],
+                y2_allocation = crossing->axis_positions[3];
+  GtkAllocation content_allocation = {0};
 
   /* aligning crossing-points between x- and y-axes */
   /* FIXME: Use different functions than self-defined min-max-functions! */
@@ -807,104 +823,6 @@ gdv_twod_layer_size_allocate (
       max(y1_beg_space[2] - x1_beg_space[2], 0),
       max(x2_beg_space[2] - y1_end_space[2], 0) + max(y1_beg_space[2] - x1_beg_space[2], 0));
 
-  /*
-  g_print ("\tX1 ALLOC: X(%d, %d) - Y(%d, %d)\n",
-           x1_allocation.x, x1_allocation.width,
-           x1_allocation.y, x1_allocation.height);
-  g_print ("\tX2 ALLOC: X(%d, %d) - Y(%d, %d)\n",
-           x2_allocation.x, x2_allocation.width,
-           x2_allocation.y, x2_allocation.height);
-  g_print ("\tY1 ALLOC: X(%d, %d) - Y(%d, %d)\n",
-           y1_allocation.x, y1_allocation.width,
-           y1_allocation.y, y1_allocation.height);
-  g_print ("\tY2 ALLOC: X(%d, %d) - Y(%d, %d)\n",
-           y2_allocation.x, y2_allocation.width,
-           y2_allocation.y, y2_allocation.height);
-  */
-
-  if (priv->x1_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->x1_axis)))
-  {
-    if (gtk_widget_get_window (GTK_WIDGET (layer->priv->x1_axis)))
-      gdk_window_move_resize (
-        gtk_widget_get_window (GTK_WIDGET (layer->priv->x1_axis)),
-        allocation->x, allocation->y,
-        allocation->width, allocation->height);
-
-    gtk_widget_size_allocate (
-      GTK_WIDGET (layer->priv->x1_axis), &x1_allocation);
-  }
-
-  if (priv->x2_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->x2_axis)))
-  {
-    if (gtk_widget_get_window (GTK_WIDGET (layer->priv->x2_axis)))
-      gdk_window_move_resize (
-        gtk_widget_get_window (GTK_WIDGET (layer->priv->x2_axis)),
-        allocation->x, allocation->y,
-        allocation->width, allocation->height);
-
-    gtk_widget_size_allocate (
-      GTK_WIDGET (layer->priv->x2_axis), &x2_allocation);
-  }
-
-  if (priv->y1_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->y1_axis)))
-  {
-    if (gtk_widget_get_window (GTK_WIDGET (layer->priv->y1_axis)))
-      gdk_window_move_resize (
-        gtk_widget_get_window (GTK_WIDGET (layer->priv->y1_axis)),
-        allocation->x, allocation->y,
-        allocation->width, allocation->height);
-
-    gtk_widget_size_allocate (
-      GTK_WIDGET (layer->priv->y1_axis), &y1_allocation);
-  }
-
-  if (priv->y2_axis &&
-      gtk_widget_get_visible (GTK_WIDGET(priv->y2_axis)))
-  {
-    if (gtk_widget_get_window (GTK_WIDGET (layer->priv->y2_axis)))
-      gdk_window_move_resize (
-        gtk_widget_get_window (GTK_WIDGET (layer->priv->y2_axis)),
-        allocation->x, allocation->y,
-        allocation->width, allocation->height);
-
-    gtk_widget_size_allocate (
-      GTK_WIDGET (layer->priv->y2_axis), &y2_allocation);
-  }
-
-
-  /* This is not the very best solution but it avoids ugly relicts */
-  {
-    gboolean resize_axis;
-
-    children = gtk_container_get_children (GTK_CONTAINER (layer));
-
-    for (children_copy = children;
-         children_copy;
-         children_copy = children_copy->next)
-    {
-
-      if (GDV_IS_AXIS (children_copy->data))
-      {
-        resize_axis = _gdv_axis_get_resize_during_redraw(children_copy->data);
-
-        if (resize_axis)// && !gtk_widget_get_visible (GTK_WIDGET (children_copy->next)))
-        {
-          _hide_show_all_contents (children, FALSE);
-          g_list_free (children);
-          return;
-        }
-        else
-          _hide_show_all_contents (children, TRUE);
-      }
-
-    }
-
-    g_list_free (children);
-  }
-
   /* Determine the content-allocation */
   content_allocation.x =
     min (
@@ -959,44 +877,209 @@ gdv_twod_layer_size_allocate (
             x2_allocation.y + x2_allocation.height - x2_end_space[1])));
   content_allocation.height  -= content_allocation.y;
 
+  axis_allocations[0] = x1_allocation;
+  axis_allocations[1] = x2_allocation;
+  axis_allocations[2] = y1_allocation;
+  axis_allocations[3] = y2_allocation;
+  *content_allocation_out = content_allocation;
+}
+
+/* Determines the position of an axis within the layer, like the overlay
+ * does. The preferred size is taken from the axis directly, since the size,
+ * that is cached by gtk, still belongs to the tics before the last
+ * allocation of the axis. */
+static void
+_twod_layer_get_axis_position (GdvTwodLayer  *layer,
+                               GdvAxis       *axis,
+                               GtkAllocation *position)
+{
+  GtkWidget *widget = GTK_WIDGET (axis);
+  GtkWidgetClass *widget_class = GTK_WIDGET_GET_CLASS (widget);
+  GtkAllocation main_alloc;
+  GtkWidget *main_widget;
+  GtkAlign halign;
+  gint min_width, nat_width, min_height, nat_height;
+
+  main_widget = gtk_bin_get_child (GTK_BIN (layer));
+
+  if (main_widget && gtk_widget_get_visible (main_widget))
+    gtk_widget_get_allocation (main_widget, &main_alloc);
+  else
+  {
+    main_alloc.x = 0;
+    main_alloc.y = 0;
+    main_alloc.width = gtk_widget_get_allocated_width (GTK_WIDGET (layer));
+    main_alloc.height = gtk_widget_get_allocated_height (GTK_WIDGET (layer));
+  }
+
+  widget_class->get_preferred_width (widget, &min_width, &nat_width);
+  widget_class->get_preferred_height (widget, &min_height, &nat_height);
+
+  min_width += gtk_widget_get_margin_start (widget) +
+               gtk_widget_get_margin_end (widget);
+  nat_width += gtk_widget_get_margin_start (widget) +
+               gtk_widget_get_margin_end (widget);
+  min_height += gtk_widget_get_margin_top (widget) +
+                gtk_widget_get_margin_bottom (widget);
+  nat_height += gtk_widget_get_margin_top (widget) +
+                gtk_widget_get_margin_bottom (widget);
+
+  position->x = main_alloc.x;
+  position->width = MAX (min_width, MIN (main_alloc.width, nat_width));
+  position->y = main_alloc.y;
+  position->height = MAX (min_height, MIN (main_alloc.height, nat_height));
+
+  halign = gtk_widget_get_halign (widget);
+
+  if (gtk_widget_get_direction (widget) == GTK_TEXT_DIR_RTL)
+  {
+    if (halign == GTK_ALIGN_START)
+      halign = GTK_ALIGN_END;
+    else if (halign == GTK_ALIGN_END)
+      halign = GTK_ALIGN_START;
+  }
+
+  switch (halign)
+  {
+  case GTK_ALIGN_FILL:
+    position->width = MAX (position->width, main_alloc.width);
+    break;
+  case GTK_ALIGN_CENTER:
+    position->x += main_alloc.width / 2 - position->width / 2;
+    break;
+  case GTK_ALIGN_END:
+    position->x += main_alloc.width - position->width;
+    break;
+  default:
+    break;
+  }
+
+  switch (gtk_widget_get_valign (widget))
+  {
+  case GTK_ALIGN_FILL:
+    position->height = MAX (position->height, main_alloc.height);
+    break;
+  case GTK_ALIGN_CENTER:
+    position->y += main_alloc.height / 2 - position->height / 2;
+    break;
+  case GTK_ALIGN_END:
+    position->y += main_alloc.height - position->height;
+    break;
+  default:
+    break;
+  }
+}
+
+/* Counts a layout-pass for gdv_twod_layer_get_layout_passes() */
+static void
+_twod_layer_count_layout_pass (GdvTwodLayer *layer)
+{
+  GdvTwodLayerPrivate *priv = layer->priv;
+  GdkFrameClock *frame_clock;
+  gint64 frame = -1;
+
+  frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (layer));
+
+  if (frame_clock)
+    frame = gdk_frame_clock_get_frame_counter (frame_clock);
+
+  if (frame != priv->layout_frame)
+  {
+    priv->layout_frame = frame;
+    priv->layout_passes = 0;
+  }
 
-  if (priv->marker_mesh)
+  priv->layout_passes++;
+}
+
+static void
+gdv_twod_layer_size_allocate (
+  GtkWidget           *widget,
+  GtkAllocation       *allocation)
+{
+  GdvAxis *axes[4];
+  GdvTwodLayerCrossing crossing;
+  GtkAllocation content_allocation = {0};
+  GdvTwodLayer *layer = GDV_TWOD_LAYER (widget);
+  GdvTwodLayerPrivate *priv = layer->priv;
+  guint i, round;
+
+  g_return_if_fail (GDV_TWOD_IS_LAYER (widget));
+  g_return_if_fail (allocation != NULL);
+
+  gtk_widget_set_allocation (GTK_WIDGET (layer), allocation);
+  _twod_layer_count_layout_pass (layer);
+
+  /*
+  g_print ("RUN ALLOC FROM START: X(%d, %d) - Y(%d, %d)\n",
+           allocation->x, allocation->width,
+           allocation->y, allocation->height);
+   */
+
+  axes[0] = priv->x1_axis;
+  axes[1] = priv->x2_axis;
+  axes[2] = priv->y1_axis;
+  axes[3] = priv->y2_axis;
+
+  for (round = 0; round < GDV_TWOD_LAYER_MAX_ALIGN_ROUNDS; round++)
+  {
+    /* Measuring all axes; the spaces are kept by the axes themselves, so
+     * this is cheap as long as their tics do not change */
+    memset (&crossing, 0, sizeof (crossing));
+
+    for (i = 0; i < 4; i++)
     {
-      priv->x_marker_list = _update_marker_list(layer,
-                                                priv->x_marker_list,
-                                                priv->x1_axis,
-                                                priv->x2_axis);
-      priv->y_marker_list = _update_marker_list(layer,
-                                                priv->y_marker_list,
-                                                priv->y1_axis,
-                                                priv->y2_axis);
+      if (!axes[i] || !gtk_widget_get_visible (GTK_WIDGET (axes[i])))
+        continue;
+
+      _twod_layer_get_axis_position (layer, axes[i],
+                                     &crossing.axis_positions[i]);
+
+      _gdv_axis_get_spaces (axes[i],
+                            crossing.beg_space[i], NULL,
+                            crossing.end_space[i], NULL);
     }
 
-  children = gtk_container_get_children (GTK_CONTAINER (layer));
-  for (list = children; list; list = list->next)
-  {
-    if ((GDV_LAYER_IS_CONTENT (list->data) ||
-         GDV_IS_HAIR (list->data))&&
-        gtk_widget_get_realized (list->data))
+    /* Only if an axis moved or needs a different amount of space, the
+     * crossing-points have to be aligned again */
+    if (priv->crossing_valid &&
+        memcmp (&crossing, &priv->crossing, sizeof (crossing)) == 0)
+    {
+      /* the last round did not change any tics, that take space */
+      if (round > 0)
+        break;
+    }
+    else
     {
-      GdkRectangle local_allocation;
+      priv->crossing = crossing;
+      _twod_layer_align_crossings (&crossing,
+                                   priv->crossing_axis_allocations,
+                                   &priv->crossing_content_allocation);
+      priv->crossing_valid = TRUE;
+    }
 
-      GTK_OVERLAY_CLASS (gdv_twod_layer_parent_class)->get_child_position (
-        GTK_OVERLAY (layer), GTK_WIDGET (list->data),
-        &local_allocation);
+    /* allocating the axes sets their tics, which may change their spaces */
+    for (i = 0; i < 4; i++)
+    {
+      if (!axes[i] || !gtk_widget_get_visible (GTK_WIDGET (axes[i])))
+        continue;
 
-      if (gtk_widget_get_window (GTK_WIDGET (list->data)))
+      if (gtk_widget_get_window (GTK_WIDGET (axes[i])))
         gdk_window_move_resize (
-          gtk_widget_get_window (GTK_WIDGET (list->data)),
+          gtk_widget_get_window (GTK_WIDGET (axes[i])),
           allocation->x, allocation->y,
           allocation->width, allocation->height);
 
       gtk_widget_size_allocate (
-        GTK_WIDGET (list->data), &content_allocation);
+        GTK_WIDGET (axes[i]), &priv->crossing_axis_allocations[i]);
     }
   }
 
-  g_list_free (children);
+  content_allocation = priv->crossing_content_allocation;
+
+  /* all contents and hairs share the inner plot-area */
+  _gdv_layer_allocate_contents (GDV_LAYER (layer), allocation,
+                                &content_allocation);
 }
 
 static void
@@ -1069,6 +1152,7 @@ void gdv_twod_layer_set_xrange (GdvTwodLayer *layer,
 //  if (layer->priv->x2_axis)
 //    g_print ("X2 CHECK\n");
 
+  gdv_layer_begin_update (GDV_LAYER (layer));
   if (layer->priv->x1_axis)
     g_object_set (layer->priv->x1_axis,
                   "scale-beg-val", x_beg,
@@ -1080,6 +1164,7 @@ void gdv_twod_layer_set_xrange (GdvTwodLayer *layer,
                   "scale-beg-val", x_beg,
                   "scale-end-val", x_end,
                   NULL);
+  gdv_layer_end_update (GDV_LAYER (layer));
 }
 
 /**
@@ -1096,6 +1181,7 @@ void gdv_twod_layer_set_yrange (GdvTwodLayer *layer,
 {
   g_return_if_fail (GDV_TWOD_IS_LAYER (layer));
 
+  gdv_layer_begin_update (GDV_LAYER (layer));
   if (layer->priv->y1_axis)
     g_object_set (layer->priv->y1_axis,
                   "scale-beg-val", y_beg,
@@ -1107,6 +1193,7 @@ void gdv_twod_layer_set_yrange (GdvTwodLayer *layer,
                   "scale-beg-val", y_beg,
                   "scale-end-val", y_end,
                   NULL);
+  gdv_layer_end_update (GDV_LAYER (layer));
 }
 
 /**
@@ -1415,6 +1502,70 @@ void gdv_twod_layer_unset_axis (GdvTwodLayer *layer, GdvTwodAxisType axis_type)
   }
 }
 
+/**
+ * gdv_twod_layer_get_layout_passes:
+ * @layer: a #GdvTwodLayer
+ *
+ * Gives the number of times, the @layer was allocated within the current or,
+ * if nothing was allocated since, within the last frame. This is meant for
+ * debugging; changing the range of an axis should not cost more than a single
+ * pass.
+ *
+ * Returns: the number of layout-passes of the frame
+ **/
+guint gdv_twod_layer_get_layout_passes (GdvTwodLayer *layer)
+{
+  g_return_val_if_fail (GDV_TWOD_IS_LAYER (layer), 0);
+
+  return layer->priv->layout_passes;
+}
+
+/**
+ * gdv_twod_layer_set_strip_chart:
+ * @layer: a #GdvTwodLayer
+ * @strip_chart: %TRUE to enable the strip-chart mode
+ *
+ * In strip-chart mode, a scale that is only shifted, e.g. by
+ * gdv_twod_layer_set_xrange() with a constant span, does not render the
+ * contents again. Instead, every content moves the image it rendered before
+ * by whole pixels and only draws the columns, that became visible, together
+ * with the data-points appended meanwhile. The tics of the axes follow the
+ * scale; only labels of tics, that enter the axis, are laid out.
+ *
+ * This makes the costs of a continuously scrolling plot depend on the number
+ * of new pixels instead of the number of visible data-points. In return, the
+ * contents may be displaced by up to half a pixel against the axes. The mode
+ * only applies to contents with non-decreasing x-values; everything else is
+ * rendered completely as before.
+ **/
+void gdv_twod_layer_set_strip_chart (GdvTwodLayer *layer,
+                                     gboolean      strip_chart)
+{
+  g_return_if_fail (GDV_TWOD_IS_LAYER (layer));
+
+  strip_chart = !!strip_chart;
+
+  if (layer->priv->strip_chart == strip_chart)
+    return;
+
+  layer->priv->strip_chart = strip_chart;
+  gtk_widget_queue_draw (GTK_WIDGET (layer));
+}
+
+/**
+ * gdv_twod_layer_get_strip_chart:
+ * @layer: a #GdvTwodLayer
+ *
+ * Returns: %TRUE, if @layer is in strip-chart mode; see
+ *     gdv_twod_layer_set_strip_chart()
+ **/
+gboolean gdv_twod_layer_get_strip_chart (GdvTwodLayer *layer)
+{
+  g_return_val_if_fail (GDV_TWOD_IS_LAYER (layer), FALSE);
+
+  return layer->priv->strip_chart;
+}
+
 static void
 gdv_twod_layer_measure (
   GdvTwodLayer             *twod_layer,
@@ -1470,23 +1621,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y1_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->y1_axis), GTK_POS_LEFT, -1,
-                          &y1_beg_space[2], &y1_beg_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y1_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->y1_axis), GTK_POS_RIGHT, -1,
-                          &y1_beg_space[3], &y1_beg_space_nat[3], NULL);
-
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y1_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->y1_axis), GTK_POS_LEFT, -1,
-                          &y1_end_space[2], &y1_end_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y1_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->y1_axis), GTK_POS_RIGHT, -1,
-                          &y1_end_space[3], &y1_end_space_nat[3], NULL);
+      _gdv_axis_get_spaces (priv->y1_axis,
+                            y1_beg_space, y1_beg_space_nat,
+                            y1_end_space, y1_end_space_nat);
 
       return_sum_nat += tmp_nat;
       return_sum_min += tmp_min;
@@ -1508,23 +1645,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y2_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->y2_axis), GTK_POS_LEFT, -1,
-                          &y2_beg_space[2], &y2_beg_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y2_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->y2_axis), GTK_POS_RIGHT, -1,
-                          &y2_beg_space[3], &y2_beg_space_nat[3], NULL);
-
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y2_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->y2_axis), GTK_POS_LEFT, -1,
-                          &y2_end_space[2], &y2_end_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->y2_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->y2_axis), GTK_POS_RIGHT, -1,
-                          &y2_end_space[3], &y2_end_space_nat[3], NULL);
+      _gdv_axis_get_spaces (priv->y2_axis,
+                            y2_beg_space, y2_beg_space_nat,
+                            y2_end_space, y2_end_space_nat);
 
       return_sum_nat += tmp_nat;
       return_sum_min += tmp_min;
@@ -1546,23 +1669,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x1_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->x1_axis), GTK_POS_LEFT, -1,
-                          &x1_beg_space[2], &x1_beg_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x1_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->x1_axis), GTK_POS_RIGHT, -1,
-                          &x1_beg_space[3], &x1_beg_space_nat[3], NULL);
-
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x1_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->x1_axis), GTK_POS_LEFT, -1,
-                          &x1_end_space[2], &x1_end_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x1_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->x1_axis), GTK_POS_RIGHT, -1,
-                          &x1_end_space[3], &x1_end_space_nat[3], NULL);
+      _gdv_axis_get_spaces (priv->x1_axis,
+                            x1_beg_space, x1_beg_space_nat,
+                            x1_end_space, x1_end_space_nat);
 
       return_sum_nat = tmp_nat > return_sum_nat ? tmp_nat : return_sum_nat;
       return_sum_min = tmp_min > return_sum_min ? tmp_min : return_sum_min;
@@ -1584,23 +1693,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x2_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->x2_axis), GTK_POS_LEFT, -1,
-                          &x2_beg_space[2], &x2_beg_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x2_axis))->get_space_to_beg_position (
-                          GDV_AXIS (priv->x2_axis), GTK_POS_RIGHT, -1,
-                          &x2_beg_space[3], &x2_beg_space_nat[3], NULL);
-
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x2_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->x2_axis), GTK_POS_LEFT, -1,
-                          &x2_end_space[2], &x2_end_space_nat[2], NULL);
-      GDV_AXIS_CLASS (GDV_AXIS_GET_CLASS (
-                        priv->x2_axis))->get_space_to_end_position (
-                          GDV_AXIS (priv->x2_axis), GTK_POS_RIGHT, -1,
-                          &x2_end_space[3], &x2_end_space_nat[3], NULL);
+      _gdv_axis_get_spaces (priv->x2_axis,
+                            x2_beg_space, x2_beg_space_nat,
+                            x2_end_space, x2_end_space_nat);
 
       return_sum_nat = tmp_nat > return_sum_nat ? tmp_nat : return_sum_nat;
       return_sum_min = tmp_min > return_sum_min ? tmp_min : return_sum_min;
@@ -1671,22 +1766,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x1_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->x1_axis), GTK_POS_TOP, -1,
-                         &x1_beg_space[0], &x1_beg_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x1_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->x1_axis), GTK_POS_BOTTOM, -1,
-                         &x1_beg_space[1], &x1_beg_space_nat[1], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x1_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->x1_axis), GTK_POS_TOP, -1,
-                         &x1_end_space[0], &x1_end_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x1_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->x1_axis), GTK_POS_BOTTOM, -1,
-                         &x1_end_space[1], &x1_end_space_nat[1], NULL);
+      _gdv_axis_get_spaces (priv->x1_axis,
+                            x1_beg_space, x1_beg_space_nat,
+                            x1_end_space, x1_end_space_nat);
 
       return_sum_nat += tmp_nat;
       return_sum_min += tmp_min;
@@ -1708,22 +1790,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x2_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->x2_axis), GTK_POS_TOP, -1,
-                         &x2_beg_space[0], &x2_beg_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x2_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->x2_axis), GTK_POS_BOTTOM, -1,
-                         &x2_beg_space[1], &x2_beg_space_nat[1], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x2_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->x2_axis), GTK_POS_TOP, -1,
-                         &x2_end_space[0], &x2_end_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->x2_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->x2_axis), GTK_POS_BOTTOM, -1,
-                         &x2_end_space[1], &x2_end_space_nat[1], NULL);
+      _gdv_axis_get_spaces (priv->x2_axis,
+                            x2_beg_space, x2_beg_space_nat,
+                            x2_end_space, x2_end_space_nat);
 
       return_sum_nat += tmp_nat;
       return_sum_min += tmp_min;
@@ -1745,22 +1814,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y1_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->y1_axis), GTK_POS_TOP, -1,
-                         &y1_beg_space[0], &y1_beg_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y1_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->y1_axis), GTK_POS_BOTTOM, -1,
-                         &y1_beg_space[1], &y1_beg_space_nat[1], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y1_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->y1_axis), GTK_POS_TOP, -1,
-                         &y1_end_space[0], &y1_end_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y1_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->y1_axis), GTK_POS_BOTTOM, -1,
-                         &y1_end_space[1], &y1_end_space_nat[1], NULL);
+      _gdv_axis_get_spaces (priv->y1_axis,
+                            y1_beg_space, y1_beg_space_nat,
+                            y1_end_space, y1_end_space_nat);
 
       return_sum_nat = tmp_nat > return_sum_nat ? tmp_nat : return_sum_nat;
       return_sum_min = tmp_min > return_sum_min ? tmp_min : return_sum_min;
@@ -1783,22 +1839,9 @@ gdv_twod_layer_measure (
           &tmp_min,
           &tmp_nat);
 
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y2_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->y2_axis), GTK_POS_TOP, -1,
-                         &y2_beg_space[0], &y2_beg_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y2_axis))->get_space_to_beg_position (
-                         GDV_AXIS (priv->y2_axis), GTK_POS_BOTTOM, -1,
-                         &y2_beg_space[1], &y2_beg_space_nat[1], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y2_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->y2_axis), GTK_POS_TOP, -1,
-                         &y2_end_space[0], &y2_end_space_nat[0], NULL);
-      GDV_AXIS_CLASS(GDV_AXIS_GET_CLASS(
-                       priv->y2_axis))->get_space_to_end_position (
-                         GDV_AXIS (priv->y2_axis), GTK_POS_BOTTOM, -1,
-                         &y2_end_space[1], &y2_end_space_nat[1], NULL);
+      _gdv_axis_get_spaces (priv->y2_axis,
+                            y2_beg_space, y2_beg_space_nat,
+                            y2_end_space, y2_end_space_nat);
 
       return_sum_nat = tmp_nat > return_sum_nat ? tmp_nat : return_sum_nat;
       return_sum_min = tmp_min > return_sum_min ? tmp_min : return_sum_min;
@@ -80,6 +80,11 @@ GdvAxis *gdv_twod_layer_get_axis (GdvTwodLayer *layer, GdvTwodAxisType axis_type
 void gdv_twod_layer_set_axis (GdvTwodLayer *layer, GdvAxis *axis, GdvTwodAxisType axis_type);
 void gdv_twod_layer_unset_axis (GdvTwodLayer *layer, GdvTwodAxisType axis_type);
 
+guint gdv_twod_layer_get_layout_passes (GdvTwodLayer *layer);
+
+void gdv_twod_layer_set_strip_chart (GdvTwodLayer *layer, gboolean strip_chart);
+gboolean gdv_twod_layer_get_strip_chart (GdvTwodLayer *layer);
+
 G_END_DECLS
 
 #endif /* GDV_TWOD_LAYER_H_INCLUDED */
@@ -209,31 +209,8 @@ gdv_special_polar_axis_class_init (GdvSpecialPolarAxisClass *klass)
 static void
 gdv_special_polar_axis_init (GdvSpecialPolarAxis *polar_axis)
 {
-  GtkWidget *widget;
-
-  GtkCssProvider *css_provider;
-  GdkScreen *screen;
-
-  widget = GTK_WIDGET (polar_axis);
-
   polar_axis->priv = gdv_special_polar_axis_get_instance_private (polar_axis);
 
-	/* initialize window group */
-  css_provider = gtk_css_provider_new ();
-//  gtk_css_provider_load_from_resource (
-//    css_provider,
-//    "/net/gevseexe/gevseapp/ui/gui/default_general.css");
-//  gtk_style_context_add_provider (
-//    style_context,
-//    GTK_STYLE_PROVIDER (css_provider),
-//    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
-  screen = gtk_widget_get_screen (widget);
-  if (screen)
-    gtk_style_context_add_provider_for_screen (
-      screen,
-      GTK_STYLE_PROVIDER (css_provider),
-      GTK_STYLE_PROVIDER_PRIORITY_USER);
-
   g_object_set (polar_axis,
     "scale-increment-base", 60.0,
     "scale-beg-val", -100.0,
@@ -120,31 +120,9 @@ gdv_special_time_axis_class_init (GdvSpecialTimeAxisClass *klass)
 static void
 gdv_special_time_axis_init (GdvSpecialTimeAxis *time_axis)
 {
-  GtkWidget *widget;
-
-  GtkCssProvider *css_provider;
-  GdkScreen *screen;
-
-  widget = GTK_WIDGET (time_axis);
-
   time_axis->priv = gdv_special_time_axis_get_instance_private (time_axis);
 
-	/* initialize window group */
-  css_provider = gtk_css_provider_new ();
-//  gtk_css_provider_load_from_resource (
-//    css_provider,
-//    "/net/gevseexe/gevseapp/ui/gui/default_general.css");
-//  gtk_style_context_add_provider (
-//    style_context,
-//    GTK_STYLE_PROVIDER (css_provider),
-//    GTK_STYLE_PROVIDER_PRIORITY_FALLBACK);
-  screen = gtk_widget_get_screen (widget);
-  if (screen)
-    gtk_style_context_add_provider_for_screen (
-      screen,
-      GTK_STYLE_PROVIDER (css_provider),
-      GTK_STYLE_PROVIDER_PRIORITY_USER);
-
+  /* the style is provided by the theme of GdvAxis */
   g_object_set (time_axis,
     "scale-increment-base", 60.0,
     NULL);
@@ -29,11 +29,239 @@ test_layer_content_correct_default (void)
 //  content_under_test
 }
 
+static void
+test_layer_content_append_columns (void)
+{
+  GdvLayerContent *content;
+  GslMatrix *matrix;
+  const gdouble *column;
+  gsize i, n_points;
+  gdouble min, max;
+  gdouble values[4] = {1.0, 2.0, 3.0, 4.0};
+  GdvDataNPoint npoint = {4, values};
+
+  gtk_init (NULL, 0);
+
+  content = g_object_ref_sink (gdv_layer_content_new ());
+
+  g_assert_null (gdv_layer_content_get_content (content));
+  g_assert_cmpuint (gdv_layer_content_get_n_columns (content), ==, 3);
+
+  gdv_layer_content_reserve (content, 10);
+
+  for (i = 0; i < 10000; i++)
+    gdv_layer_content_add_data_point (content, i, 2.0 * i, -1.0 * i);
+
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==, 10000);
+
+  column = gdv_layer_content_get_column (content, 1, &n_points);
+  g_assert_cmpuint (n_points, ==, 10000);
+  for (i = 0; i < n_points; i++)
+    g_assert_cmpfloat (column[i], ==, 2.0 * i);
+
+  matrix = gdv_layer_content_get_content (content);
+  g_assert_nonnull (matrix);
+  g_assert_cmpuint (matrix->size1, ==, 3);
+  g_assert_cmpuint (matrix->size2, ==, 10000);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 0, 0), ==, 0.0);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 0, 9999), ==, 9999.0);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 2, 42), ==, -42.0);
+
+  gdv_layer_content_get_min_max_x (content, &min, &max);
+  g_assert_cmpfloat (min, ==, 0.0);
+  g_assert_cmpfloat (max, ==, 9999.0);
+
+  /* extending the dimension keeps all previous values */
+  gdv_layer_content_add_data_n_point (content, &npoint);
+  g_assert_cmpuint (gdv_layer_content_get_n_columns (content), ==, 4);
+
+  matrix = gdv_layer_content_get_content (content);
+  g_assert_cmpuint (matrix->size1, ==, 4);
+  g_assert_cmpuint (matrix->size2, ==, 10001);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 1, 9999), ==, 19998.0);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 3, 9999), ==, 0.0);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 3, 10000), ==, 4.0);
+
+  gdv_layer_content_reset (content);
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==, 0);
+  g_assert_null (gdv_layer_content_get_content (content));
+
+  g_object_unref (content);
+}
+
+static void
+test_layer_content_append_block (void)
+{
+  GdvLayerContent *content;
+  GslMatrix *matrix;
+  gdouble interleaved[3 * 4096];
+  gdouble min, max;
+  gsize i;
+
+  gtk_init (NULL, 0);
+
+  content = g_object_ref_sink (gdv_layer_content_new ());
+
+  for (i = 0; i < 4096; i++)
+    {
+      interleaved[3 * i] = i;
+      interleaved[3 * i + 1] = sin (i);
+      interleaved[3 * i + 2] = 5.0;
+    }
+
+  gdv_layer_content_add_data_point (content, -1.0, 0.0, 0.0);
+  gdv_layer_content_add_data_points (content,
+                                     &interleaved[0],
+                                     &interleaved[1],
+                                     NULL,
+                                     4096, 3);
+
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==, 4097);
+
+  matrix = gdv_layer_content_get_content (content);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 0, 0), ==, -1.0);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 0, 4096), ==, 4095.0);
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 1, 11), ==, sin (10));
+  g_assert_cmpfloat (gsl_matrix_get (matrix, 2, 11), ==, 0.0);
+
+  gdv_layer_content_get_min_max_x (content, &min, &max);
+  g_assert_cmpfloat (min, ==, -1.0);
+  g_assert_cmpfloat (max, ==, 4095.0);
+
+  g_object_unref (content);
+}
+
+static void
+test_layer_content_sliding_window (void)
+{
+  GdvLayerContent *content;
+  GslMatrix *matrix;
+  gdouble min, max;
+  gsize i;
+
+  gtk_init (NULL, 0);
+
+  content = g_object_ref_sink (gdv_layer_content_new ());
+  g_object_set (content, "max-points", 100, NULL);
+
+  for (i = 0; i < 1000; i++)
+    gdv_layer_content_add_data_point (content, i, (i % 7) - 3.0, 0.0);
+
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==, 100);
+
+  gdv_layer_content_get_min_max_x (content, &min, &max);
+  g_assert_cmpfloat (min, ==, 900.0);
+  g_assert_cmpfloat (max, ==, 999.0);
+
+  gdv_layer_content_get_min_max_y (content, &min, &max);
+  g_assert_cmpfloat (min, ==, -3.0);
+  g_assert_cmpfloat (max, ==, 3.0);
+
+  matrix = gdv_layer_content_get_content (content);
+  g_assert_cmpuint (matrix->size2, ==, 100);
+  for (i = 0; i < 100; i++)
+    g_assert_cmpfloat (gsl_matrix_get (matrix, 0, i), ==, 900.0 + i);
+
+  /* a decreasing series evicts the maximum */
+  for (i = 0; i < 100; i++)
+    gdv_layer_content_add_data_point (content, 1000.0 + i, -10.0 - i, 0.0);
+
+  gdv_layer_content_get_min_max_y (content, &min, &max);
+  g_assert_cmpfloat (min, ==, -109.0);
+  g_assert_cmpfloat (max, ==, -10.0);
+
+  /* switching to a span in x */
+  g_object_set (content, "max-points", 0, "window-span", 9.5, NULL);
+  gdv_layer_content_add_data_point (content, 1100.0, 0.0, 0.0);
+
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==, 10);
+
+  gdv_layer_content_get_min_max_x (content, &min, &max);
+  g_assert_cmpfloat (min, ==, 1091.0);
+  g_assert_cmpfloat (max, ==, 1100.0);
+
+  /* a generous limit does not allocate its whole storage in advance */
+  g_object_set (content, "window-span", 0.0, "max-points", G_MAXUINT, NULL);
+  gdv_layer_content_reserve (content, 1000);
+
+  for (i = 0; i < 1000; i++)
+    gdv_layer_content_add_data_point (content, 1101.0 + i, 0.0, 0.0);
+
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==, 1010);
+
+  gdv_layer_content_get_min_max_x (content, &min, &max);
+  g_assert_cmpfloat (min, ==, 1091.0);
+  g_assert_cmpfloat (max, ==, 2100.0);
+
+  g_object_unref (content);
+}
+
+static void
+test_layer_content_ingest (void)
+{
+  GdvLayerContent *content;
+  GdvIngest *ingest;
+  const gdouble *column;
+  gdouble values[100];
+  gsize i, n_points;
+
+  gtk_init (NULL, 0);
+
+  content = g_object_ref_sink (gdv_layer_content_new ());
+
+  for (i = 0; i < 100; i++)
+    values[i] = i;
+
+  /* the oldest samples give way to the newer ones */
+  ingest = gdv_ingest_new (content, 64, GDV_INGEST_DROP_OLDEST);
+  g_assert_cmpuint (gdv_ingest_get_capacity (ingest), ==, 64);
+
+  for (i = 0; i < 100; i++)
+    g_assert_true (gdv_ingest_push_point (ingest, values[i], -values[i], 0.0));
+
+  g_assert_cmpuint (gdv_ingest_get_n_pushed (ingest), ==, 100);
+  g_assert_cmpuint (gdv_ingest_get_n_dropped (ingest), ==, 36);
+  g_assert_cmpuint (gdv_ingest_flush (ingest), ==, 64);
+  g_assert_cmpuint (gdv_ingest_flush (ingest), ==, 0);
+
+  column = gdv_layer_content_get_column (content, 0, &n_points);
+  g_assert_cmpuint (n_points, ==, 64);
+  for (i = 0; i < 64; i++)
+    g_assert_cmpfloat (column[i], ==, 36.0 + i);
+
+  gdv_ingest_detach (ingest);
+  g_assert_null (gdv_ingest_get_content (ingest));
+  g_object_unref (ingest);
+
+  /* a block, that does not fit, is thinned out */
+  gdv_layer_content_reset (content);
+  ingest = gdv_ingest_new (content, 10, GDV_INGEST_DECIMATE);
+  g_assert_cmpuint (gdv_ingest_get_capacity (ingest), ==, 16);
+
+  g_assert_cmpuint (
+    gdv_ingest_push (ingest, values, values, NULL, 100, 1), ==, 15);
+  g_assert_cmpuint (gdv_ingest_get_n_dropped (ingest), ==, 85);
+  g_assert_cmpuint (gdv_ingest_flush (ingest), ==, 15);
+
+  column = gdv_layer_content_get_column (content, 0, &n_points);
+  g_assert_cmpuint (n_points, ==, 15);
+  for (i = 0; i < 15; i++)
+    g_assert_cmpfloat (column[i], ==, 7.0 * i);
+
+  gdv_ingest_detach (ingest);
+  g_object_unref (ingest);
+  g_object_unref (content);
+}
+
 int main(int argc, char* argv[]) {
 
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/Gdv/LayerContent/correct_default", test_layer_content_correct_default);
+  g_test_add_func ("/Gdv/LayerContent/append_columns", test_layer_content_append_columns);
+  g_test_add_func ("/Gdv/LayerContent/append_block", test_layer_content_append_block);
+  g_test_add_func ("/Gdv/LayerContent/sliding_window", test_layer_content_sliding_window);
+  g_test_add_func ("/Gdv/LayerContent/ingest", test_layer_content_ingest);
 
   return g_test_run ();
 }
@@ -56,6 +56,9 @@ void tgdv_axis_test_tic_distance (GdvAxis *axis)
 {
   GList *tics, *tics_cpy, *mtics, *mtics_cpy;
   GdvTic *last_tic = NULL;
+  gdouble last_pos_in_x = 0.0, last_pos_in_y = 0.0;
+  gboolean has_last_record = FALSE;
+  guint i;
   gint max_diff_pix;
   gdouble scale_incr;
   gboolean scale_auto_increment, force_beg_end, scale_limits_auto;
@@ -113,6 +116,34 @@ void tgdv_axis_test_tic_distance (GdvAxis *axis)
     last_tic = tics->data;
   }
 
+  /* the same for the automatic tics, that are sorted already */
+  for (i = 0; i < gdv_axis_get_n_tics (axis); i++)
+  {
+    gdouble curr_value, curr_pos_in_x, curr_pos_in_y;
+    gboolean minor;
+
+    gdv_axis_get_nth_tic (axis, i,
+                          &curr_value, &minor, &curr_pos_in_x, &curr_pos_in_y);
+
+    if (minor)
+      continue;
+
+    if (has_last_record)
+    {
+      gdouble distance_between_tics;
+
+      distance_between_tics = sqrt((last_pos_in_x - curr_pos_in_x) * (last_pos_in_x - curr_pos_in_x) +
+                                   (last_pos_in_y - curr_pos_in_y) * (last_pos_in_y - curr_pos_in_y));
+
+      if (scale_auto_increment)
+        g_assert_cmpfloat(distance_between_tics, <=, max_diff_pix);
+    }
+
+    last_pos_in_x = curr_pos_in_x;
+    last_pos_in_y = curr_pos_in_y;
+    has_last_record = TRUE;
+  }
+
 
   g_list_free(tics_cpy);
   g_list_free(mtics_cpy);
@@ -164,6 +195,7 @@ void tgdv_axis_test_integrity (GdvAxis *axis)
 {
   GList *tics, *mtics;
   GList *tics_cpy, *mtics_cpy;
+  guint n_tics, n_mtics, i;
 
   gdouble orientation, direction_outside;
   gdouble scale_min_val = 0.0, scale_max_val = 0.0, scale_incr = 0.0;
@@ -238,13 +270,48 @@ void tgdv_axis_test_integrity (GdvAxis *axis)
   tics = gdv_axis_get_tic_list (GDV_AXIS (axis));
   mtics = gdv_axis_get_mtic_list (GDV_AXIS (axis));
 
+  /* the automatic tics may be records of the axis instead of widgets */
+  n_tics = g_list_length(tics);
+  n_mtics = g_list_length(mtics);
+
+  for (i = 0; i < gdv_axis_get_n_tics (axis); i++)
+  {
+    gdouble x_pos, y_pos;
+    gdouble value;
+    gboolean minor;
+
+    g_assert_true (gdv_axis_get_nth_tic (axis, i,
+                                         &value, &minor, &x_pos, &y_pos));
+
+    g_assert_cmpfloat(x_pos - allocation.x, >=, fmin(axis_beg_pix_x, axis_end_pix_x) - 1e-3);
+    g_assert_cmpfloat(x_pos - allocation.x, <=, fmax(axis_beg_pix_x, axis_end_pix_x) + 1e-3);
+    g_assert_cmpfloat(y_pos - allocation.y, >=, fmin(axis_beg_pix_y, axis_end_pix_y) - 1e-3);
+    g_assert_cmpfloat(y_pos - allocation.y, <=, fmax(axis_beg_pix_y, axis_end_pix_y) + 1e-3);
+
+    if (minor)
+    {
+      g_assert_cmpfloat(value, >=, mtic_beg_val);
+      g_assert_cmpfloat(value, <=, mtic_end_val);
+      n_mtics++;
+    }
+    else
+    {
+      if (tics_auto)
+      {
+        g_assert_cmpfloat(value, >=, tic_beg_val);
+        g_assert_cmpfloat(value, <=, tic_end_val);
+      }
+      n_tics++;
+    }
+  }
+
   if (gtk_widget_get_realized (GTK_WIDGET(axis)) &&
       tics_auto &&
       scale_limits_auto)
-    g_assert_cmpuint(g_list_length(tics), >=, 2);
+    g_assert_cmpuint(n_tics, >=, 2);
   else if (gtk_widget_get_realized (GTK_WIDGET(axis)) &&
            tics_auto)
-    g_assert_cmpuint(g_list_length(tics), >=, 1);
+    g_assert_cmpuint(n_tics, >=, 1);
 
 
 //force_beg_end
@@ -278,12 +345,12 @@ void tgdv_axis_test_integrity (GdvAxis *axis)
   g_list_free(tics_cpy);
 
   /* TODO: make this test universal */
-  if (g_list_length(tics) == 2 && mtics_auto)
-    g_assert (g_list_length(mtics) == no_of_mtics);
+  if (gdv_axis_get_n_tics (axis) && n_tics == 2 && mtics_auto)
+    g_assert (n_mtics == no_of_mtics);
 
   if (gtk_widget_get_realized (GTK_WIDGET(axis)) &&
       mtics_auto)
-    g_assert (g_list_length(mtics) >= 1);
+    g_assert (n_mtics >= 1);
 
   for (mtics_cpy = mtics; mtics; mtics = mtics->next)
   {
@@ -24,6 +24,9 @@ void tgdv_layer_test_integrity (GdvLayer *layer)
 {
   GList * axis_list, * laxis_cpy;
   GList * content_list, * lcontent_cpy;
+  GdvAxis **axes;
+  GdvLayerContent **contents;
+  guint n_axes, n_contents, i;
 
   g_assert(GDV_IS_LAYER(layer));
 
@@ -31,6 +34,21 @@ void tgdv_layer_test_integrity (GdvLayer *layer)
   content_list = gdv_layer_get_content_list (GDV_LAYER (layer));
   lcontent_cpy = content_list;
 
+  /* the cached arrays must match the children of the layer */
+  axes = gdv_layer_peek_axes (GDV_LAYER (layer), &n_axes);
+  contents = gdv_layer_peek_contents (GDV_LAYER (layer), &n_contents);
+  g_assert_cmpuint (n_axes, ==, g_list_length (axis_list));
+  g_assert_cmpuint (n_contents, ==, g_list_length (content_list));
+
+  for (i = 0; i < n_axes; i++)
+    g_assert (g_list_nth_data (axis_list, i) == axes[i]);
+  for (i = 0; i < n_contents; i++)
+  {
+    g_assert (g_list_nth_data (content_list, i) == contents[i]);
+    g_assert (gtk_widget_get_parent (GTK_WIDGET (contents[i])) ==
+              GTK_WIDGET (layer));
+  }
+
   if (gtk_widget_get_realized (GTK_WIDGET(layer)))
     g_assert_cmpuint(g_list_length(axis_list), >=, 1);
 
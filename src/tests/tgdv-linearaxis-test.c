@@ -59,8 +59,7 @@ test_lin_axis_correct_default (void)
   GtkWidget *window;
   GdvLinearAxis *lin_axis;
   GdvLayer *layer;
-  GList *tics, *mtics;
-  GList *tics_cpy, *mtics_cpy;
+  guint n_tics, n_mtics, i;
 
   gdouble orientation, direction_outside;
   gdouble scale_min_val = 0.0, scale_max_val = 0.0, scale_incr = 0.0;
@@ -86,9 +85,6 @@ test_lin_axis_correct_default (void)
 
   tgdv_linearaxis_test_integrity(lin_axis);
 
-  tics = gdv_axis_get_tic_list (GDV_AXIS (lin_axis));
-  mtics = gdv_axis_get_mtic_list (GDV_AXIS (lin_axis));
-
   g_object_get (lin_axis,
     "axis-orientation", &orientation,
     "axis-direction-outside", &direction_outside,
@@ -120,8 +116,7 @@ test_lin_axis_correct_default (void)
                         "scale-max-diff-pix", &scale_max_diff_pix,
                         NULL);
 
-  g_assert_null (tics);
-  g_assert_null (mtics);
+  g_assert_cmpuint (gdv_axis_get_n_tics (GDV_AXIS (lin_axis)), ==, 0);
   g_assert_true (orientation == 0.0);
   g_assert_true (direction_outside == 0.5 * M_PI);
   g_assert_true (scale_min_val == 0.0);
@@ -207,25 +202,32 @@ test_lin_axis_correct_default (void)
   g_assert_true ((axis_beg_screen_y >= 0.0) && (axis_beg_screen_y <= 0.3));
   g_assert_true ((axis_end_screen_y >= 0.7) && (axis_end_screen_y <= 1.0));
 
-  tics = gdv_axis_get_tic_list (GDV_AXIS (lin_axis));
-  mtics = gdv_axis_get_mtic_list (GDV_AXIS (lin_axis));
-
-  g_assert (g_list_length(tics) == 2);
+  n_tics = 0;
+  n_mtics = 0;
 
-  for (tics_cpy = tics; tics; tics = tics->next)
+  for (i = 0; i < gdv_axis_get_n_tics (GDV_AXIS (lin_axis)); i++)
   {
-    gdouble value;
+    gdouble value, pos_x_d, pos_y_d;
+    gboolean minor;
     gfloat pos_x, pos_y;
 
-    g_object_get (tics->data,
-                  "value", &value,
-                  "pos-x", &pos_x,
-                  "pos-y", &pos_y,
-                  NULL);
+    g_assert_true (gdv_axis_get_nth_tic (GDV_AXIS (lin_axis), i,
+                                         &value, &minor, &pos_x_d, &pos_y_d));
+    pos_x = (gfloat) pos_x_d;
+    pos_y = (gfloat) pos_y_d;
+
+    if (minor)
+    {
+      g_assert_true (value > scale_min_val);
+      g_assert_true (value < scale_max_val);
+      g_assert_true ((pos_x >= (gfloat) axis_beg_pix_x) && (pos_x <= (gfloat) axis_end_pix_x));
+      g_assert_true ((pos_y >= (gfloat) axis_beg_pix_y) && (pos_y <= (gfloat) axis_end_pix_y));
+
+      n_mtics++;
+      continue;
+    }
 
     tgdv_linearaxis_test_tic_on_regression (value, tic_beg_val, tic_end_val, scale_incr);
-//    tgdv_linearaxis_test_tic_on_regression (pos_x, axis_beg_pix_x, axis_end_pix_x, scale_incr);
-//    tgdv_linearaxis_test_tic_on_regression (pos_y, axis_beg_pix_y, axis_end_pix_y, scale_incr);
 
     g_assert_true (scale_min_val == value || scale_max_val == value);
     if (scale_min_val == value)
@@ -239,33 +241,11 @@ test_lin_axis_correct_default (void)
       g_assert_true (pos_y == (gfloat) axis_end_pix_y);
     }
 
+    n_tics++;
   }
-  g_list_free(tics_cpy);
 
-  g_assert (g_list_length(mtics) == no_of_mtics);
-
-//  guint iter;
-//  iter = 0;
-  for (mtics_cpy = mtics; mtics; mtics = mtics->next)
-  {
-    gdouble value;
-    gfloat pos_x, pos_y;
-
-    g_object_get (mtics->data,
-                  "value", &value,
-                  "pos-x", &pos_x,
-                  "pos-y", &pos_y,
-                  NULL);
-    g_assert_true (value > scale_min_val);
-    g_assert_true (value < scale_max_val);
-    g_assert_true ((pos_x >= (gfloat) axis_beg_pix_x) && (pos_x <= (gfloat) axis_end_pix_x));
-    g_assert_true ((pos_y >= (gfloat) axis_beg_pix_y) && (pos_y <= (gfloat) axis_end_pix_y));
-
-//    iter++;
-  }
-  g_list_free(mtics_cpy);
-
-//  g_assert_cmpuint(no_of_tics, ==, iter);
+  g_assert (n_tics == 2);
+  g_assert (n_mtics == no_of_mtics);
 
   g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), window);
   gtk_main();
@@ -277,8 +257,7 @@ test_lin_axis_horizontal (void)
   GtkWidget *window;
   GdvLinearAxis *lin_axis;
   GdvLayer *layer;
-  GList *tics, *mtics;
-  GList *tics_cpy, *mtics_cpy;
+  guint n_tics, n_mtics, i;
 
   gdouble orientation, direction_outside;
   gdouble scale_min_val = 0.0, scale_max_val = 0.0, scale_incr = 0.0;
@@ -357,21 +336,31 @@ test_lin_axis_horizontal (void)
   g_assert_true ((axis_beg_screen_x >= 0.675) && (axis_beg_screen_x <= 1.0));
   g_assert_true ((axis_end_screen_x >= 0.0) && (axis_end_screen_x <= 0.3));
 
-  tics = gdv_axis_get_tic_list (GDV_AXIS (lin_axis));
-  mtics = gdv_axis_get_mtic_list (GDV_AXIS (lin_axis));
-
-  g_assert (g_list_length(tics) == 2);
+  n_tics = 0;
+  n_mtics = 0;
 
-  for (tics_cpy = tics; tics; tics = tics->next)
+  for (i = 0; i < gdv_axis_get_n_tics (GDV_AXIS (lin_axis)); i++)
   {
-    gdouble value;
+    gdouble value, pos_x_d, pos_y_d;
+    gboolean minor;
     gfloat pos_x, pos_y;
 
-    g_object_get (tics->data,
-                  "value", &value,
-                  "pos-x", &pos_x,
-                  "pos-y", &pos_y,
-                  NULL);
+    g_assert_true (gdv_axis_get_nth_tic (GDV_AXIS (lin_axis), i,
+                                         &value, &minor, &pos_x_d, &pos_y_d));
+    pos_x = (gfloat) pos_x_d;
+    pos_y = (gfloat) pos_y_d;
+
+    if (minor)
+    {
+      g_assert_true (value > scale_min_val);
+      g_assert_true (value < scale_max_val);
+      g_assert_true (gdv_is_within_range_f (pos_x, (gfloat) axis_beg_pix_x, (gfloat) axis_end_pix_x));
+      g_assert_true (gdv_is_within_range_f (pos_y, (gfloat) axis_beg_pix_y, (gfloat) axis_end_pix_y));
+
+      n_mtics++;
+      continue;
+    }
+
     g_assert_true (scale_min_val == value || scale_max_val == value);
     if (scale_min_val == value)
     {
@@ -392,26 +381,11 @@ test_lin_axis_horizontal (void)
                                                 1e-10 * pos_y));
     }
 
+    n_tics++;
   }
-  g_list_free(tics_cpy);
 
-  g_assert (g_list_length(mtics) == no_of_mtics);
-  for (mtics_cpy = mtics; mtics; mtics = mtics->next)
-  {
-    gdouble value;
-    gfloat pos_x, pos_y;
-
-    g_object_get (mtics->data,
-                  "value", &value,
-                  "pos-x", &pos_x,
-                  "pos-y", &pos_y,
-                  NULL);
-    g_assert_true (value > scale_min_val);
-    g_assert_true (value < scale_max_val);
-    g_assert_true (gdv_is_within_range_f (pos_x, (gfloat) axis_beg_pix_x, (gfloat) axis_end_pix_x));
-    g_assert_true (gdv_is_within_range_f (pos_y, (gfloat) axis_beg_pix_y, (gfloat) axis_end_pix_y));
-  }
-  g_list_free(mtics_cpy);
+  g_assert (n_tics == 2);
+  g_assert (n_mtics == no_of_mtics);
 
   g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), window);
   gtk_main();
@@ -425,6 +399,9 @@ test_lin_axis_cross_settings (void)
   GdvLayer *layer;
 
   gdouble scale_min_val = 0.0, scale_max_val = 0.0, scale_incr = 0.0;
+  gdouble tic_value;
+  gboolean tic_minor;
+  guint tic_index;
 
   gtk_init (NULL, 0);
 
@@ -492,6 +469,32 @@ test_lin_axis_cross_settings (void)
   g_assert_true (scale_max_val == 10.0);
   g_assert_true (scale_incr == 0.5);
 
+  /* tics are found up to round-off */
+  g_assert_true (gdv_axis_lookup_tic (GDV_AXIS (lin_axis), 0.0, &tic_index));
+  gdv_axis_get_nth_tic (GDV_AXIS (lin_axis), tic_index,
+                        &tic_value, &tic_minor, NULL, NULL);
+  g_assert_true (tic_value == 0.0);
+  g_assert_false (tic_minor);
+
+  g_assert_true (gdv_axis_lookup_tic (GDV_AXIS (lin_axis), 1e-14, NULL));
+  g_assert_true (gdv_axis_lookup_tic (GDV_AXIS (lin_axis), 0.1 * 3.0 * 5.0,
+                                      &tic_index));
+  gdv_axis_get_nth_tic (GDV_AXIS (lin_axis), tic_index,
+                        &tic_value, NULL, NULL, NULL);
+  g_assert_true (tic_value == 1.5);
+
+  /* otherwise the index is where the value would be inserted */
+  g_assert_false (gdv_axis_lookup_tic (GDV_AXIS (lin_axis), 0.123,
+                                       &tic_index));
+  g_assert_cmpuint (tic_index, >, 0);
+  g_assert_cmpuint (tic_index, <, gdv_axis_get_n_tics (GDV_AXIS (lin_axis)));
+  gdv_axis_get_nth_tic (GDV_AXIS (lin_axis), tic_index - 1,
+                        &tic_value, NULL, NULL, NULL);
+  g_assert_cmpfloat (tic_value, <, 0.123);
+  gdv_axis_get_nth_tic (GDV_AXIS (lin_axis), tic_index,
+                        &tic_value, NULL, NULL, NULL);
+  g_assert_cmpfloat (tic_value, >, 0.123);
+
   g_object_set (lin_axis,
                 "scale-increment-base", 10.0,
                 "scale-beg-val", -10.000001,
@@ -524,6 +527,87 @@ test_lin_axis_cross_settings (void)
 
 }
 
+/* label-size estimator, that takes a fixed amount of pixels per label */
+static gdouble
+tic_solver_length_cb (gdouble first_value, gdouble last_value,
+                      gdouble pix_length, gpointer user_data)
+{
+  return pix_length - 2.0 * *((gdouble *) user_data);
+}
+
+static void
+test_lin_axis_tic_solver (void)
+{
+  GdvTicSolution solution;
+  gdouble label_size = 50.0;
+  guint i;
+
+  /* the same results as the cross_settings test, without any widget */
+  g_assert_true (gdv_tic_solver_solve (0.0, 100.0, 10.0, 1700.0, NULL, NULL,
+                                       40, 300, &solution));
+  g_assert_cmpfloat (solution.increment, ==, 2.5);
+  g_assert_cmpfloat (solution.scale_beg, ==, 0.0);
+  g_assert_cmpfloat (solution.scale_end, ==, 100.0);
+  g_assert_cmpuint (solution.n_tics, ==, 41);
+  g_assert_true (solution.fulfilled);
+
+  g_assert_true (gdv_tic_solver_solve (0.0, 100.0, 30.0, 1700.0, NULL, NULL,
+                                       40, 300, &solution));
+  g_assert_cmpfloat (solution.increment, ==, 3.0);
+  g_assert_cmpfloat (solution.scale_end, ==, 102.0);
+
+  g_assert_true (gdv_tic_solver_solve (-10.0, 10.0, 10.0, 1700.0, NULL, NULL,
+                                       40, 300, &solution));
+  g_assert_cmpfloat (solution.increment, ==, 0.5);
+
+  /* enough space for the base increment */
+  g_assert_true (gdv_tic_solver_solve (0.0, 100.0, 10.0, 200.0, NULL, NULL,
+                                       40, 300, &solution));
+  g_assert_cmpfloat (solution.increment, ==, 100.0);
+  g_assert_cmpuint (solution.n_tics, ==, 2);
+
+  /* reversed scales */
+  g_assert_true (gdv_tic_solver_solve (100.0, 0.0, 10.0, 1700.0, NULL, NULL,
+                                       40, 300, &solution));
+  g_assert_cmpfloat (solution.increment, ==, 2.5);
+  g_assert_cmpfloat (solution.scale_beg, ==, 100.0);
+  g_assert_cmpfloat (solution.scale_end, ==, 0.0);
+
+  /* the estimator is called at most three times */
+  g_assert_true (gdv_tic_solver_solve (0.0, 1.0, 10.0, 1000.0,
+                                       tic_solver_length_cb, &label_size,
+                                       40, 300, &solution));
+  g_assert_cmpuint (solution.n_evaluations, <=, 3);
+  g_assert_cmpfloat (solution.diff_pix, >=, 40.0);
+  g_assert_cmpfloat (solution.diff_pix, <=, 300.0);
+
+  g_assert_false (gdv_tic_solver_solve (1.0, 1.0, 10.0, 1000.0, NULL, NULL,
+                                        40, 300, &solution));
+
+  /* a minimal distance of 0 pixels is taken as 1 pixel */
+  g_assert_true (gdv_tic_solver_solve (0.0, 1.2, 10.0, 1700.0, NULL, NULL,
+                                       0, 100, &solution));
+  g_assert_cmpfloat (solution.increment, >, 0.0);
+  g_assert_cmpfloat (solution.diff_pix, >=, 1.0);
+  g_assert_cmpfloat (solution.diff_pix, <=, 100.0);
+  g_assert_true (solution.fulfilled);
+
+  if (g_test_perf ())
+  {
+    gdouble elapsed;
+
+    g_test_timer_start ();
+
+    for (i = 0; i < 1000000; i++)
+      gdv_tic_solver_solve (-0.5 * i, 1.0 + i, 10.0, 400.0 + (i % 1000),
+                            tic_solver_length_cb, &label_size,
+                            40, 300, &solution);
+
+    elapsed = g_test_timer_elapsed ();
+    g_test_minimized_result (elapsed, "1000000 solutions in %f s", elapsed);
+  }
+}
+
 /*
 
 static struct _tgdv_linearaxis_data *test_lin_axis_setup_data (void)
@@ -626,6 +710,92 @@ test_lin_axis_manual_tics (void)
   data = NULL;
 }
 
+static gboolean
+axis_get_point (GdvAxis *axis,
+                gdouble  value,
+                gdouble *pos_x,
+                gdouble *pos_y)
+{
+  gboolean in_range = FALSE;
+
+  g_signal_emit_by_name (axis, "get-point", value, pos_x, pos_y, &in_range);
+
+  return in_range;
+}
+
+/* Values are mapped through the transform of the axis; it has to follow the
+ * scale right away, even before the axis is allocated again. */
+static void
+test_lin_axis_get_point (void)
+{
+  GtkWidget *window;
+  GdvLinearAxis *lin_axis;
+  GdvLayer *layer;
+  gdouble beg_x, beg_y, end_x, end_y, pos_x, pos_y;
+
+  gtk_init (NULL, 0);
+
+  window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  lin_axis = g_object_new (GDV_LINEAR_TYPE_AXIS, NULL);
+  layer = g_object_new (GDV_TYPE_LAYER, NULL);
+
+  g_object_set (lin_axis,
+    "axis-orientation", 0.5 * M_PI,
+    "axis-direction-outside", 1.0 * M_PI,
+    "scale-limits-automatic", FALSE,
+    NULL);
+  g_object_set (lin_axis,
+    "scale-beg-val", 0.0,
+    "scale-end-val", 100.0,
+    NULL);
+
+  gtk_container_add (GTK_CONTAINER (window), GTK_WIDGET (layer));
+  gtk_container_add (GTK_CONTAINER (layer), GTK_WIDGET (lin_axis));
+  gtk_container_set_border_width (GTK_CONTAINER (window), 80);
+  gtk_widget_show_all (window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  g_object_get (lin_axis,
+    "axis-beg-pix-x", &beg_x,
+    "axis-beg-pix-y", &beg_y,
+    "axis-end-pix-x", &end_x,
+    "axis-end-pix-y", &end_y,
+    NULL);
+
+  g_assert_cmpfloat (fabs (end_x - beg_x) + fabs (end_y - beg_y), >, 0.0);
+
+  g_assert_true (axis_get_point (GDV_AXIS (lin_axis), 0.0,
+                                 &pos_x, &pos_y));
+  g_assert_cmpfloat_with_epsilon (pos_x, beg_x, 1e-9);
+  g_assert_cmpfloat_with_epsilon (pos_y, beg_y, 1e-9);
+
+  g_assert_true (axis_get_point (GDV_AXIS (lin_axis), 25.0,
+                                 &pos_x, &pos_y));
+  g_assert_cmpfloat_with_epsilon (pos_x, beg_x + 0.25 * (end_x - beg_x), 1e-9);
+  g_assert_cmpfloat_with_epsilon (pos_y, beg_y + 0.25 * (end_y - beg_y), 1e-9);
+
+  g_assert_false (axis_get_point (GDV_AXIS (lin_axis), 150.0,
+                                  &pos_x, &pos_y));
+
+  /* the new scale is mapped onto the same pixels */
+  g_object_set (lin_axis, "scale-end-val", 200.0, NULL);
+
+  g_assert_true (axis_get_point (GDV_AXIS (lin_axis), 200.0,
+                                 &pos_x, &pos_y));
+  g_assert_cmpfloat_with_epsilon (pos_x, end_x, 1e-9);
+  g_assert_cmpfloat_with_epsilon (pos_y, end_y, 1e-9);
+
+  g_assert_true (axis_get_point (GDV_AXIS (lin_axis), 100.0,
+                                 &pos_x, &pos_y));
+  g_assert_cmpfloat_with_epsilon (pos_x, beg_x + 0.5 * (end_x - beg_x), 1e-9);
+  g_assert_cmpfloat_with_epsilon (pos_y, beg_y + 0.5 * (end_y - beg_y), 1e-9);
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), window);
+  gtk_main ();
+}
+
 int main(int argc, char* argv[]) {
 
   g_test_init (&argc, &argv, NULL);
@@ -634,6 +804,8 @@ int main(int argc, char* argv[]) {
   g_test_add_func ("/Gdv/LinearAxis/horizontal", test_lin_axis_horizontal);
   g_test_add_func ("/Gdv/LinearAxis/cross_settings", test_lin_axis_cross_settings);
   g_test_add_func ("/Gdv/LinearAxis/manual_tics", test_lin_axis_manual_tics);
+  g_test_add_func ("/Gdv/LinearAxis/tic_solver", test_lin_axis_tic_solver);
+  g_test_add_func ("/Gdv/LinearAxis/get_point", test_lin_axis_get_point);
 /*  g_test_add_data_func_full ("/Gdv/LinearAxis/manual_tics", setting,
                              test_lin_axis_manual_tics, test_lin_axis_reset_window);
 */
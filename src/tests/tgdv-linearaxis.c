@@ -44,6 +44,7 @@ void tgdv_linearaxis_test_integrity (GdvLinearAxis *laxis)
 {
   GList *tics, *mtics;
   GList *tics_cpy, *mtics_cpy;
+  guint i;
 
   gdouble orientation, direction_outside;
   gdouble scale_min_val = 0.0, scale_max_val = 0.0, scale_incr = 0.0;
@@ -140,5 +141,29 @@ void tgdv_linearaxis_test_integrity (GdvLinearAxis *laxis)
     tgdv_tic_test_full(mtics->data);
   }
   g_list_free(mtics_cpy);
+
+  /* the automatic tics, that are no widgets */
+  for (i = 0; i < gdv_axis_get_n_tics (GDV_AXIS (laxis)); i++)
+  {
+    gdouble value, pos_x, pos_y;
+    gboolean minor;
+
+    g_assert_true (gdv_axis_get_nth_tic (GDV_AXIS (laxis), i,
+                                         &value, &minor, &pos_x, &pos_y));
+
+    if (!minor && scale_auto_increment)
+      tgdv_linearaxis_test_tic_on_regression (value, tic_beg_val, tic_end_val, scale_auto_increment);
+    else if (minor && scale_auto_increment)
+    {
+      g_assert_true (value >= scale_min_val);
+      g_assert_true (value <= scale_max_val);
+      g_assert_true (gdv_is_within_range_f ((gfloat) pos_x,
+                                            (gfloat) (allocation.x + axis_beg_pix_x),
+                                            (gfloat) (allocation.x + axis_end_pix_x)));
+      g_assert_true (gdv_is_within_range_f ((gfloat) pos_y,
+                                            (gfloat) (allocation.y + axis_beg_pix_y),
+                                            (gfloat) (allocation.y + axis_end_pix_y)));
+    }
+  }
 }
 
@@ -42,6 +42,14 @@ teardown_cb (GtkWidget *widget)
   return FALSE;
 }
 
+static void
+count_notify_cb (GObject    *object,
+                 GParamSpec *pspec,
+                 guint      *n_notify)
+{
+  (*n_notify)++;
+}
+
 
 static void
 test_twodlayer_pre_normal (void)
@@ -49,6 +57,8 @@ test_twodlayer_pre_normal (void)
   struct _tgdv_twodlayer_data data_str;
   struct _tgdv_twodlayer_data * data = &data_str;
   GList *laxis, *laxis_cpy;
+  GdvAxis **axes;
+  guint n_axes, n_notify = 0;
 
   gtk_init (NULL, 0);
 
@@ -73,6 +83,37 @@ test_twodlayer_pre_normal (void)
   while (gtk_events_pending ())
     gtk_main_iteration ();
 
+  /* the mesh is drawn by the layer itself and adds no hairs */
+  g_assert_null (gdv_layer_get_hair_list (GDV_LAYER (data->layer)));
+
+  /* a new range is laid out within a single pass */
+  gdv_twod_layer_set_xrange (data->layer, -12.5, 1250.0);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  g_assert_cmpuint (gdv_twod_layer_get_layout_passes (data->layer), ==, 1);
+
+  /* changes within a transaction are notified and laid out only once */
+  axes = gdv_layer_peek_axes (GDV_LAYER (data->layer), &n_axes);
+  g_assert_cmpuint (n_axes, >, 0);
+  g_signal_connect (axes[0], "notify::scale-beg-val",
+                    G_CALLBACK (count_notify_cb), &n_notify);
+
+  gdv_layer_begin_update (GDV_LAYER (data->layer));
+  gdv_twod_layer_set_xrange (data->layer, -10.0, 100.0);
+  gdv_twod_layer_set_yrange (data->layer, -10.0, 100.0);
+  gdv_twod_layer_set_xrange (data->layer, -20.0, 200.0);
+  g_assert_cmpuint (n_notify, ==, 0);
+  gdv_layer_end_update (GDV_LAYER (data->layer));
+  g_assert_cmpuint (n_notify, ==, 1);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  g_assert_cmpuint (gdv_twod_layer_get_layout_passes (data->layer), ==, 1);
+  g_signal_handlers_disconnect_by_func (axes[0], count_notify_cb, &n_notify);
+
   g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window); // cb_time
   tgdv_layer_test_integrity(GDV_LAYER(data->layer));
 
@@ -90,6 +131,248 @@ test_twodlayer_pre_normal (void)
   data = NULL;
 }
 
+/* the grid-lines get colors of their own; major lines are green and minor
+ * lines are blue */
+static GtkCssProvider *
+grid_css_provider_new (void)
+{
+  GtkCssProvider *css_provider = gtk_css_provider_new ();
+
+  gtk_css_provider_load_from_data (css_provider,
+  "hair {"
+  "  -GdvHair-color: #00ff00;"
+  "  -GdvHair-line-width: 1px;"
+  "}"
+  "hair.minor {"
+  "  -GdvHair-color: #0000ff;"
+  "  -GdvHair-line-width: 1px;"
+  "                                 }\0", -1, NULL);
+  gtk_style_context_add_provider_for_screen (gdk_screen_get_default (),
+                                             GTK_STYLE_PROVIDER (css_provider),
+                                             GTK_STYLE_PROVIDER_PRIORITY_USER);
+
+  return css_provider;
+}
+
+static void
+grid_css_provider_free (GtkCssProvider *css_provider)
+{
+  gtk_style_context_remove_provider_for_screen (
+    gdk_screen_get_default (), GTK_STYLE_PROVIDER (css_provider));
+  g_object_unref (css_provider);
+}
+
+/* TRUE, if the layer has painted a pixel around (x, y), in which the color
+ * channel at shift dominates the other two; the position is given in the
+ * coordinates of the parent of the layer */
+static gboolean
+layer_has_color_near (GdvTwodLayer *layer,
+                      gdouble       x,
+                      gdouble       y,
+                      guint         shift)
+{
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  GtkAllocation allocation;
+  const guint32 *data;
+  gint stride, pixel_x, pixel_y, dx, dy;
+  gboolean found = FALSE;
+
+  gtk_widget_get_allocation (GTK_WIDGET (layer), &allocation);
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                        allocation.width, allocation.height);
+
+  cr = cairo_create (surface);
+  gtk_widget_draw (GTK_WIDGET (layer), cr);
+  cairo_destroy (cr);
+  cairo_surface_flush (surface);
+
+  data = (const guint32 *) cairo_image_surface_get_data (surface);
+  stride = cairo_image_surface_get_stride (surface) / 4;
+  pixel_x = (gint) floor (x - allocation.x);
+  pixel_y = (gint) floor (y - allocation.y);
+
+  for (dy = -1; dy <= 1 && !found; dy++)
+    for (dx = -1; dx <= 1 && !found; dx++)
+    {
+      guint32 pixel, channel, other;
+      guint i;
+
+      if (pixel_x + dx < 0 || pixel_x + dx >= allocation.width ||
+          pixel_y + dy < 0 || pixel_y + dy >= allocation.height)
+        continue;
+
+      pixel = data[(pixel_y + dy) * stride + pixel_x + dx];
+      channel = (pixel >> shift) & 0xff;
+
+      for (i = 0, other = 0; i < 24; i += 8)
+        if (i != shift)
+          other = MAX (other, (pixel >> i) & 0xff);
+
+      found = channel > other + 0x20;
+    }
+
+  cairo_surface_destroy (surface);
+
+  return found;
+}
+
+/* a y-position between two horizontal grid-lines, near the middle */
+static gdouble
+grid_free_y (GdvTwodLayer *layer)
+{
+  GdvAxis *y_axis = gdv_twod_layer_get_axis (layer, GDV_Y1_AXIS);
+  guint n_tics = gdv_axis_get_n_tics (y_axis);
+  gdouble pos_y1, pos_y2;
+
+  g_assert_cmpuint (n_tics, >=, 2);
+  g_assert_true (gdv_axis_get_nth_tic (y_axis, n_tics / 2 - 1,
+                                       NULL, NULL, NULL, &pos_y1));
+  g_assert_true (gdv_axis_get_nth_tic (y_axis, n_tics / 2,
+                                       NULL, NULL, NULL, &pos_y2));
+
+  return 0.5 * (pos_y1 + pos_y2);
+}
+
+static void
+test_twodlayer_grid (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GtkCssProvider *css_provider;
+  GdvAxis *x_axis;
+  gboolean major_found = FALSE, minor_found = FALSE;
+  gdouble y;
+  guint n_tics, i;
+
+  gtk_init (NULL, 0);
+
+  css_provider = grid_css_provider_new ();
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 400, 400);
+
+  gdv_twod_layer_set_xrange (data->layer, 0.0, 100.0);
+  gdv_twod_layer_set_yrange (data->layer, 0.0, 100.0);
+  gtk_widget_show_all (data->window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  /* the first and the last tic are covered by the y-axes */
+  x_axis = gdv_twod_layer_get_axis (data->layer, GDV_X1_AXIS);
+  n_tics = gdv_axis_get_n_tics (x_axis);
+  y = grid_free_y (data->layer);
+
+  for (i = 1; i + 1 < n_tics; i++)
+  {
+    gboolean minor;
+    gdouble pos_x;
+
+    g_assert_true (gdv_axis_get_nth_tic (x_axis, i, NULL, &minor,
+                                         &pos_x, NULL));
+
+    if (minor && !minor_found)
+    {
+      g_assert_true (layer_has_color_near (data->layer, pos_x, y, 0));
+      minor_found = TRUE;
+    }
+    else if (!minor && !major_found)
+    {
+      g_assert_true (layer_has_color_near (data->layer, pos_x, y, 8));
+      major_found = TRUE;
+    }
+  }
+
+  g_assert_true (major_found);
+  g_assert_true (minor_found);
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  grid_css_provider_free (css_provider);
+
+  data = NULL;
+}
+
+static gint
+compare_tic_values (gconstpointer a,
+                    gconstpointer b)
+{
+  gdouble value_a, value_b;
+
+  g_object_get ((gpointer) a, "value", &value_a, NULL);
+  g_object_get ((gpointer) b, "value", &value_b, NULL);
+
+  return (value_a > value_b) - (value_a < value_b);
+}
+
+static void
+test_twodlayer_log_grid (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GtkCssProvider *css_provider;
+  GdvLogAxis *x1_axis, *x2_axis;
+  GList *tic_list;
+  gfloat pos_x;
+
+  gtk_init (NULL, 0);
+
+  css_provider = grid_css_provider_new ();
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 400, 400);
+
+  /* the log-axes add a tic-widget for every tic */
+  x1_axis = g_object_new (GDV_LOG_TYPE_AXIS,
+                          "halign", GTK_ALIGN_FILL,
+                          "valign", GTK_ALIGN_END,
+                          "axis-orientation", -0.5 * M_PI,
+                          "axis-direction-outside", M_PI,
+                          NULL);
+  x2_axis = g_object_new (GDV_LOG_TYPE_AXIS,
+                          "halign", GTK_ALIGN_FILL,
+                          "valign", GTK_ALIGN_START,
+                          "axis-orientation", -0.5 * M_PI,
+                          "axis-direction-outside", 0.0,
+                          NULL);
+
+  gdv_twod_layer_unset_axis (data->layer, GDV_X1_AXIS);
+  gdv_twod_layer_set_axis (data->layer, GDV_AXIS (x1_axis), GDV_X1_AXIS);
+  gdv_twod_layer_unset_axis (data->layer, GDV_X2_AXIS);
+  gdv_twod_layer_set_axis (data->layer, GDV_AXIS (x2_axis), GDV_X2_AXIS);
+
+  gdv_twod_layer_set_xrange (data->layer, 1.0, 1000.0);
+  gdv_twod_layer_set_yrange (data->layer, 0.0, 100.0);
+  gtk_widget_show_all (data->window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  /* a tic in the middle is not covered by the y-axes */
+  tic_list = g_list_sort (gdv_axis_get_tic_list (GDV_AXIS (x1_axis)),
+                          compare_tic_values);
+  g_assert_cmpuint (g_list_length (tic_list), >=, 3);
+  g_object_get (g_list_nth_data (tic_list, g_list_length (tic_list) / 2),
+                "pos-x", &pos_x, NULL);
+  g_list_free (tic_list);
+
+  g_assert_true (layer_has_color_near (data->layer, pos_x,
+                                       grid_free_y (data->layer), 8));
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  grid_css_provider_free (css_provider);
+
+  data = NULL;
+}
+
 static void
 test_twodlayer_log_legend (void)
 {
@@ -242,13 +525,1422 @@ test_twodlayer_log_legend (void)
   data = NULL;
 }
 
+/* TRUE, if the content has painted anything into the columns from x_beg up
+ * to x_end; an x_end of -1 stands for the width of the content */
+static gboolean
+content_has_pixels_in (GdvLayerContent *content,
+                       gint             x_beg,
+                       gint             x_end)
+{
+  cairo_surface_t *surface;
+  cairo_t *cr;
+  const guint32 *data;
+  gint stride, width, height, x, y;
+  gboolean found = FALSE;
+
+  width = gtk_widget_get_allocated_width (GTK_WIDGET (content));
+  height = gtk_widget_get_allocated_height (GTK_WIDGET (content));
+  surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+
+  if (x_end < 0 || x_end > width)
+    x_end = width;
+
+  cr = cairo_create (surface);
+  gtk_widget_draw (GTK_WIDGET (content), cr);
+  cairo_destroy (cr);
+  cairo_surface_flush (surface);
+
+  data = (const guint32 *) cairo_image_surface_get_data (surface);
+  stride = cairo_image_surface_get_stride (surface) / 4;
+
+  for (y = 0; y < height && !found; y++)
+    for (x = x_beg; x < x_end && !found; x++)
+      found = data[y * stride + x] != 0;
+
+  cairo_surface_destroy (surface);
+
+  return found;
+}
+
+/* TRUE, if the content has painted anything */
+static gboolean
+content_has_pixels (GdvLayerContent *content)
+{
+  return content_has_pixels_in (content, 0, -1);
+}
+
+/* Keeps the ranges of all axes of the layer at what is set, instead of
+ * following the data */
+static void
+layer_fix_limits (GdvLayer *layer)
+{
+  GList *axes, *axis;
+
+  axes = gdv_layer_get_axis_list (layer);
+
+  for (axis = axes; axis; axis = axis->next)
+    g_object_set (axis->data, "scale-limits-automatic", FALSE, NULL);
+
+  g_list_free (axes);
+}
+
+/* Shows a new window with a layer from 0 to 100 in both directions, that
+ * holds a single content with the given style */
+static GdvLayerContent *
+fixed_layer_content_new (GtkWidget   **window,
+                         GdvTwodLayer **layer,
+                         const gchar  *css)
+{
+  GdvLayerContent *content;
+
+  *window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  *layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (*window), GTK_WIDGET (*layer));
+  gtk_widget_set_size_request (GTK_WIDGET (*window), 400, 400);
+
+  content = gdv_layer_content_new ();
+  gtk_container_add (GTK_CONTAINER (*layer), GTK_WIDGET (content));
+
+  if (css)
+  {
+    GtkCssProvider *css_provider = gtk_css_provider_new ();
+
+    gtk_css_provider_load_from_data (css_provider, css, -1, NULL);
+    gtk_style_context_add_provider (
+      gtk_widget_get_style_context (GTK_WIDGET (content)),
+      GTK_STYLE_PROVIDER (css_provider), GTK_STYLE_PROVIDER_PRIORITY_USER);
+    g_object_unref (css_provider);
+  }
+
+  layer_fix_limits (GDV_LAYER (*layer));
+  gdv_twod_layer_set_xrange (*layer, 0.0, 100.0);
+  gdv_twod_layer_set_yrange (*layer, 0.0, 100.0);
+  gtk_widget_show_all (*window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  return content;
+}
+
+/* Draws the content, like it appears on the screen */
+static cairo_surface_t *
+content_snapshot (GdvLayerContent *content)
+{
+  cairo_surface_t *surface;
+  cairo_t *cr;
+
+  surface = cairo_image_surface_create (
+    CAIRO_FORMAT_ARGB32,
+    gtk_widget_get_allocated_width (GTK_WIDGET (content)),
+    gtk_widget_get_allocated_height (GTK_WIDGET (content)));
+
+  cr = cairo_create (surface);
+  gtk_widget_draw (GTK_WIDGET (content), cr);
+  cairo_destroy (cr);
+  cairo_surface_flush (surface);
+
+  return surface;
+}
+
+static gboolean
+pixels_match (guint32 pixel_a,
+              guint32 pixel_b,
+              guint   tolerance)
+{
+  guint shift;
+
+  for (shift = 0; shift < 32; shift += 8)
+    if (ABS ((gint) ((pixel_a >> shift) & 0xff) -
+             (gint) ((pixel_b >> shift) & 0xff)) > (gint) tolerance)
+      return FALSE;
+
+  return TRUE;
+}
+
+/* Counts the pixels of the first image, that have no pixel in the second one
+ * within reach pixels, whose channels all differ by at most tolerance */
+static guint
+count_different_pixels (cairo_surface_t *surface_a,
+                        cairo_surface_t *surface_b,
+                        guint            tolerance,
+                        gint             reach)
+{
+  gint width = cairo_image_surface_get_width (surface_a);
+  gint height = cairo_image_surface_get_height (surface_a);
+  gint stride_a = cairo_image_surface_get_stride (surface_a) / 4;
+  gint stride_b = cairo_image_surface_get_stride (surface_b) / 4;
+  const guint32 *data_a, *data_b;
+  gint x, y, dx, dy;
+  guint n_different = 0;
+
+  g_assert_cmpint (cairo_image_surface_get_width (surface_b), ==, width);
+  g_assert_cmpint (cairo_image_surface_get_height (surface_b), ==, height);
+
+  data_a = (const guint32 *) cairo_image_surface_get_data (surface_a);
+  data_b = (const guint32 *) cairo_image_surface_get_data (surface_b);
+
+  for (y = 0; y < height; y++)
+    for (x = 0; x < width; x++)
+    {
+      gboolean found = FALSE;
+
+      for (dy = -reach; dy <= reach && !found; dy++)
+        for (dx = -reach; dx <= reach && !found; dx++)
+          found = x + dx >= 0 && x + dx < width &&
+                  y + dy >= 0 && y + dy < height &&
+                  pixels_match (data_a[y * stride_a + x],
+                                data_b[(y + dy) * stride_b + x + dx],
+                                tolerance);
+
+      if (!found)
+        n_different++;
+    }
+
+  return n_different;
+}
+
+static void
+test_twodlayer_append (void)
+{
+  const gchar *styles[] = {
+    /* the symbol at the joint must not be drawn twice */
+    "*{"
+    "  -GdvLayerContent-point-color: rgba(255,0,255,0.5);"
+    "  -GdvLayerContent-point-width: 4.0;"
+    "}",
+    /* the dash-pattern must go on at the joint */
+    "*{"
+    "  -GdvLayerContent-line-dash-portion: 10.0;"
+    "  -GdvLayerContent-line-secondary-dash-portion: 10.0;"
+    "}"
+  };
+  guint n_style;
+
+  gtk_init (NULL, 0);
+
+  for (n_style = 0; n_style < G_N_ELEMENTS (styles); n_style++)
+  {
+    GtkWidget *window_appended, *window_full;
+    GdvTwodLayer *layer_appended, *layer_full;
+    GdvLayerContent *appended, *full;
+    cairo_surface_t *surface_appended, *surface_full;
+    guint i;
+
+    appended = fixed_layer_content_new (&window_appended, &layer_appended,
+                                        styles[n_style]);
+    full = fixed_layer_content_new (&window_full, &layer_full,
+                                    styles[n_style]);
+
+    /* the data-points are far enough apart, that a symbol does not touch
+     * the segments before its predecessor */
+    for (i = 0; i < 10; i++)
+      gdv_layer_content_add_data_point (appended, 5.0 * i,
+                                        50.0 + 30.0 * sin (0.3 * i), 0.0);
+
+    cairo_surface_destroy (content_snapshot (appended));
+
+    for (i = 0; i < 20; i++)
+    {
+      if (i >= 10)
+        gdv_layer_content_add_data_point (appended, 5.0 * i,
+                                          50.0 + 30.0 * sin (0.3 * i), 0.0);
+
+      gdv_layer_content_add_data_point (full, 5.0 * i,
+                                        50.0 + 30.0 * sin (0.3 * i), 0.0);
+    }
+
+    surface_appended = content_snapshot (appended);
+    surface_full = content_snapshot (full);
+
+    /* only the joint of both lines may be anti-aliased differently */
+    g_assert_true (content_has_pixels (appended));
+    g_assert_cmpuint (count_different_pixels (surface_appended, surface_full,
+                                              0x30, 0), <=, 8);
+
+    cairo_surface_destroy (surface_appended);
+    cairo_surface_destroy (surface_full);
+
+    gtk_widget_destroy (window_appended);
+    gtk_widget_destroy (window_full);
+  }
+}
+
+static guint
+surface_alpha_at (cairo_surface_t *surface,
+                  gint             x,
+                  gint             y)
+{
+  const guint32 *row = (const guint32 *)
+    (cairo_image_surface_get_data (surface) +
+     y * cairo_image_surface_get_stride (surface));
+
+  return row[x] >> 24;
+}
+
+/* A polyline is collapsed before it is stroked; this must not change its
+ * look, while a point without a position interrupts the line */
+static void
+test_twodlayer_render_polyline (void)
+{
+  GtkWidget *window;
+  GdvTwodLayer *layer;
+  GdvLayerContent *content;
+  GtkStyleContext *context;
+  cairo_surface_t *surface_many, *surface_two, *surface_gap;
+  cairo_t *cr;
+  gdouble px[1001], py[1001];
+  const gdouble gap_x[] = {10.0, 100.0, NAN, 110.0, 190.0};
+  const gdouble gap_y[] = {80.0, 80.0, NAN, 80.0, 80.0};
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  content = fixed_layer_content_new (&window, &layer,
+    "*{"
+    "  -GdvLayerContent-point-width: 0.0;"
+    "  -GdvLayerContent-line-width: 2.0;"
+    "  -GdvLayerContent-line-color: rgb(0,0,0);"
+    "}");
+  context = gtk_widget_get_style_context (GTK_WIDGET (content));
+
+  /* many collinear points, most of them closer than a pixel */
+  for (i = 0; i < 1001; i++)
+  {
+    px[i] = 10.0 + 0.18 * i;
+    py[i] = 20.0 + 0.3 * 0.18 * i;
+  }
+
+  surface_many = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 200, 100);
+  cr = cairo_create (surface_many);
+  gdv_render_data_polyline (context, cr, px, py, 1001);
+  cairo_destroy (cr);
+  cairo_surface_flush (surface_many);
+
+  px[1] = px[1000];
+  py[1] = py[1000];
+
+  surface_two = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 200, 100);
+  cr = cairo_create (surface_two);
+  gdv_render_data_polyline (context, cr, px, py, 2);
+  cairo_destroy (cr);
+  cairo_surface_flush (surface_two);
+
+  g_assert_cmpuint (surface_alpha_at (surface_two, 100, 47), >, 0x80);
+  g_assert_cmpuint (count_different_pixels (surface_many, surface_two,
+                                            0x20, 0), ==, 0);
+
+  surface_gap = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 200, 100);
+  cr = cairo_create (surface_gap);
+  gdv_render_data_polyline (context, cr, gap_x, gap_y, G_N_ELEMENTS (gap_x));
+  cairo_destroy (cr);
+  cairo_surface_flush (surface_gap);
+
+  g_assert_cmpuint (surface_alpha_at (surface_gap, 50, 80), >, 0x80);
+  g_assert_cmpuint (surface_alpha_at (surface_gap, 105, 80), ==, 0);
+  g_assert_cmpuint (surface_alpha_at (surface_gap, 150, 80), >, 0x80);
+
+  cairo_surface_destroy (surface_many);
+  cairo_surface_destroy (surface_two);
+  cairo_surface_destroy (surface_gap);
+
+  gtk_widget_destroy (window);
+}
+
+/* Vertices of a curve may only be dropped, as long as the line, that
+ * replaces them, passes them closely; the collapsed curve has to look like
+ * the one, that is stroked through all of its points */
+static void
+test_twodlayer_render_curve (void)
+{
+  GtkWidget *window;
+  GdvTwodLayer *layer;
+  GdvLayerContent *content;
+  GtkStyleContext *context;
+  cairo_surface_t *surface_collapsed, *surface_stroked;
+  cairo_t *cr;
+  gdouble px[1429], py[1429];
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  content = fixed_layer_content_new (&window, &layer,
+    "*{"
+    "  -GdvLayerContent-point-width: 0.0;"
+    "  -GdvLayerContent-line-width: 2.0;"
+    "  -GdvLayerContent-line-color: rgb(0,0,0);"
+    "}");
+  context = gtk_widget_get_style_context (GTK_WIDGET (content));
+
+  /* a half-sine, whose points are much closer than a pixel */
+  for (i = 0; i < G_N_ELEMENTS (px); i++)
+  {
+    gdouble t = (gdouble) i / (G_N_ELEMENTS (px) - 1);
+
+    px[i] = 10.0 + 180.0 * t;
+    py[i] = 90.0 - 80.0 * sin (G_PI * t);
+  }
+
+  surface_collapsed = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                                  200, 100);
+  cr = cairo_create (surface_collapsed);
+  gdv_render_data_polyline (context, cr, px, py, G_N_ELEMENTS (px));
+  cairo_destroy (cr);
+  cairo_surface_flush (surface_collapsed);
+
+  surface_stroked = cairo_image_surface_create (CAIRO_FORMAT_ARGB32,
+                                                200, 100);
+  cr = cairo_create (surface_stroked);
+  cairo_move_to (cr, px[0] + 0.5, py[0] + 0.5);
+  for (i = 1; i < G_N_ELEMENTS (px); i++)
+    cairo_line_to (cr, px[i] + 0.5, py[i] + 0.5);
+  cairo_set_line_width (cr, 2.0);
+  cairo_set_source_rgb (cr, 0.0, 0.0, 0.0);
+  cairo_stroke (cr);
+  cairo_destroy (cr);
+  cairo_surface_flush (surface_stroked);
+
+  /* the top of the curve is drawn */
+  g_assert_cmpuint (surface_alpha_at (surface_collapsed, 100, 10), >, 0x80);
+  g_assert_cmpuint (count_different_pixels (surface_collapsed,
+                                            surface_stroked, 0x40, 1), ==, 0);
+  g_assert_cmpuint (count_different_pixels (surface_stroked,
+                                            surface_collapsed, 0x40, 1), ==, 0);
+
+  cairo_surface_destroy (surface_collapsed);
+  cairo_surface_destroy (surface_stroked);
+
+  gtk_widget_destroy (window);
+}
+
+/* Mapping an array of interleaved data-points has to give the same positions
+ * and range-flags as mapping them one by one, for linear and log-axes */
+static void
+test_twodlayer_evaluate_points (void)
+{
+  guint log_x;
+
+  gtk_init (NULL, 0);
+
+  for (log_x = 0; log_x < 2; log_x++)
+  {
+    GtkWidget *window;
+    GdvTwodLayer *layer;
+    gdouble values[2 * 37];
+    gdouble pos_x[37], pos_y[37];
+    guint8 in_range[(37 + 7) / 8];
+    guint i;
+
+    window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+    layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+    gtk_container_add (GTK_CONTAINER (window), GTK_WIDGET (layer));
+    gtk_widget_set_size_request (GTK_WIDGET (window), 400, 400);
+
+    if (log_x)
+    {
+      gdv_twod_layer_unset_axis (layer, GDV_X1_AXIS);
+      gdv_twod_layer_set_axis (layer,
+                               g_object_new (GDV_LOG_TYPE_AXIS,
+                                             "halign", GTK_ALIGN_FILL,
+                                             "valign", GTK_ALIGN_END,
+                                             "axis-orientation", -0.5 * M_PI,
+                                             "axis-direction-outside", M_PI,
+                                             NULL),
+                               GDV_X1_AXIS);
+    }
+
+    layer_fix_limits (GDV_LAYER (layer));
+    gdv_twod_layer_set_xrange (layer, 1.0, 1000.0);
+    gdv_twod_layer_set_yrange (layer, 0.0, 100.0);
+    gtk_widget_show_all (window);
+
+    while (gtk_events_pending ())
+      gtk_main_iteration ();
+
+    /* some of the data-points are out of range; one of them is not even on
+     * a log-axis */
+    for (i = 0; i < 37; i++)
+    {
+      values[2 * i] = i == 0 ? 0.0 : 0.5 * pow (1.25, i);
+      values[2 * i + 1] = -10.0 + 3.5 * i;
+    }
+
+    gdv_layer_evaluate_data_points (GDV_LAYER (layer), values, values + 1,
+                                    NULL, 37, 2, pos_x, pos_y, in_range);
+
+    for (i = 0; i < 37; i++)
+    {
+      gdouble single_x = NAN, single_y = NAN;
+      gboolean single_in_range;
+
+      single_in_range =
+        gdv_layer_evaluate_data_point (GDV_LAYER (layer),
+                                       values[2 * i], values[2 * i + 1], 0.0,
+                                       &single_x, &single_y);
+
+      g_assert_cmpint ((in_range[i >> 3] >> (i & 7)) & 1, ==,
+                       single_in_range ? 1 : 0);
+
+      if (isfinite (single_x))
+        g_assert_cmpfloat_with_epsilon (pos_x[i], single_x, 1e-9);
+      if (isfinite (single_y))
+        g_assert_cmpfloat_with_epsilon (pos_y[i], single_y, 1e-9);
+    }
+
+    /* below the range in both directions and within it */
+    g_assert_cmpint (in_range[0] & 1, ==, 0);
+    g_assert_cmpint ((in_range[2] >> 2) & 1, ==, 1);
+
+    gtk_widget_destroy (window);
+  }
+}
+
+/* The pyramid has to keep the envelope of a line, whose samples are not
+ * evenly spaced along the x-axis */
+static void
+test_twodlayer_level_of_detail (void)
+{
+  GtkWidget *window_lod, *window_full;
+  GdvTwodLayer *layer_lod, *layer_full;
+  GdvLayerContent *lod, *full;
+  cairo_surface_t *surface_lod, *surface_full;
+  guint width, i;
+
+  gtk_init (NULL, 0);
+
+  lod = fixed_layer_content_new (&window_lod, &layer_lod, NULL);
+  full = fixed_layer_content_new (&window_full, &layer_full, NULL);
+
+  g_object_set (lod, "level-of-detail", TRUE, NULL);
+
+  for (i = 0; i < 200000; i++)
+  {
+    gdouble t = i / 200000.0;
+    gdouble y = 50.0 + 30.0 * sin (20.0 * t) + 10.0 * sin (0.37 * i);
+
+    gdv_layer_content_add_data_point (lod, 100.0 * t * t, y, 0.0);
+    gdv_layer_content_add_data_point (full, 100.0 * t * t, y, 0.0);
+  }
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  surface_lod = content_snapshot (lod);
+  surface_full = content_snapshot (full);
+  width = cairo_image_surface_get_width (surface_lod);
+
+  /* only the anti-aliasing at the borders of the columns may differ */
+  g_assert_true (content_has_pixels (lod));
+  g_assert_cmpuint (count_different_pixels (surface_lod, surface_full,
+                                            0x30, 1), <=, width);
+  g_assert_cmpuint (count_different_pixels (surface_full, surface_lod,
+                                            0x30, 1), <=, width);
+
+  cairo_surface_destroy (surface_lod);
+  cairo_surface_destroy (surface_full);
+
+  gtk_widget_destroy (window_lod);
+  gtk_widget_destroy (window_full);
+}
+
+/* Zooming into an ordered series draws only the visible samples; this has
+ * to look like drawing all of them, also on an inverted x-axis */
+static void
+test_twodlayer_visible_range (void)
+{
+  const gdouble ranges[][2] = {
+    {300.0, 400.0},
+    {400.0, 300.0}
+  };
+  guint n_range;
+
+  gtk_init (NULL, 0);
+
+  for (n_range = 0; n_range < G_N_ELEMENTS (ranges); n_range++)
+  {
+    GtkWidget *window_ordered, *window_all;
+    GdvTwodLayer *layer_ordered, *layer_all;
+    GdvLayerContent *ordered, *all;
+    cairo_surface_t *surface_ordered, *surface_all;
+    guint i;
+
+    ordered = fixed_layer_content_new (&window_ordered, &layer_ordered, NULL);
+    all = fixed_layer_content_new (&window_all, &layer_all, NULL);
+
+    /* a leading sample without a position is skipped, but it breaks the
+     * order, so all samples are drawn */
+    gdv_layer_content_add_data_point (all, NAN, NAN, 0.0);
+
+    for (i = 0; i < 100000; i++)
+    {
+      gdouble y = 50.0 + 40.0 * sin (0.05 * i);
+
+      gdv_layer_content_add_data_point (ordered, 0.01 * i, y, 0.0);
+      gdv_layer_content_add_data_point (all, 0.01 * i, y, 0.0);
+    }
+
+    gdv_twod_layer_set_xrange (layer_ordered,
+                               ranges[n_range][0], ranges[n_range][1]);
+    gdv_twod_layer_set_xrange (layer_all,
+                               ranges[n_range][0], ranges[n_range][1]);
+
+    while (gtk_events_pending ())
+      gtk_main_iteration ();
+
+    surface_ordered = content_snapshot (ordered);
+    surface_all = content_snapshot (all);
+
+    g_assert_true (content_has_pixels (ordered));
+    g_assert_cmpuint (count_different_pixels (surface_ordered, surface_all,
+                                              0x30, 0), <=, 8);
+    g_assert_cmpuint (count_different_pixels (surface_all, surface_ordered,
+                                              0x30, 0), <=, 8);
+
+    cairo_surface_destroy (surface_ordered);
+    cairo_surface_destroy (surface_all);
+
+    gtk_widget_destroy (window_ordered);
+    gtk_widget_destroy (window_all);
+  }
+}
+
+static void
+test_twodlayer_threaded_unordered (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *content;
+  gint64 deadline;
+  gint width;
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 800, 800);
+
+  content = g_object_new (GDV_LAYER_TYPE_CONTENT,
+                          "threaded-rendering", TRUE,
+                          NULL);
+  gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+
+  /* the x-positions jump back and forth, so the segments are binned */
+  for (i = 0; i < 200000; i++)
+    gdv_layer_content_add_data_point (content, 50.0 + 45.0 * sin (0.37 * i),
+                                      50.0 + 40.0 * sin (0.0001 * i), 0.0);
+
+  gdv_twod_layer_set_xrange (data->layer, 0.0, 100.0);
+  gdv_twod_layer_set_yrange (data->layer, 0.0, 100.0);
+  gtk_widget_show_all (data->window);
+
+  deadline = g_get_monotonic_time () + 10 * G_TIME_SPAN_SECOND;
+  while (!content_has_pixels (content) && g_get_monotonic_time () < deadline)
+    gtk_main_iteration_do (FALSE);
+
+  /* the outer tiles got their segments as well */
+  width = gtk_widget_get_allocated_width (GTK_WIDGET (content));
+  g_assert_true (content_has_pixels_in (content, 0, width / 4));
+  g_assert_true (content_has_pixels_in (content, 3 * width / 4, width));
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+#define INGEST_TEST_N_POINTS 10000
+
+static gpointer
+ingest_producer (gpointer user_data)
+{
+  GdvIngest *ingest = user_data;
+  gdouble values[100];
+  gsize queued = 0;
+  guint i, j;
+
+  for (i = 0; i < INGEST_TEST_N_POINTS; i += G_N_ELEMENTS (values))
+  {
+    for (j = 0; j < G_N_ELEMENTS (values); j++)
+      values[j] = i + j;
+
+    queued += gdv_ingest_push (ingest, values, values, NULL,
+                               G_N_ELEMENTS (values), 1);
+  }
+
+  return GSIZE_TO_POINTER (queued);
+}
+
+static void
+test_twodlayer_ingest_block (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *content;
+  GdvIngest *ingest;
+  GThread *producer;
+  gdouble value = 0.0;
+  gint64 deadline;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 400, 400);
+
+  content = gdv_layer_content_new ();
+  gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+  gtk_widget_show_all (data->window);
+
+  /* the producer has to wait for the frames of the content many times */
+  ingest = gdv_ingest_new (content, 256, GDV_INGEST_BLOCK);
+  producer = g_thread_new ("ingest-producer", ingest_producer, ingest);
+
+  deadline = g_get_monotonic_time () + 20 * G_TIME_SPAN_SECOND;
+  while (gdv_ingest_get_n_pushed (ingest) < INGEST_TEST_N_POINTS &&
+         g_get_monotonic_time () < deadline)
+    gtk_main_iteration_do (FALSE);
+
+  g_assert_cmpuint (GPOINTER_TO_SIZE (g_thread_join (producer)), ==,
+                    INGEST_TEST_N_POINTS);
+  g_assert_cmpuint (gdv_ingest_get_n_dropped (ingest), ==, 0);
+
+  gdv_ingest_flush (ingest);
+  g_assert_cmpuint (gdv_layer_content_get_n_points (content), ==,
+                    INGEST_TEST_N_POINTS);
+
+  /* the main thread must not wait for itself */
+  if (g_test_undefined ())
+  {
+    g_test_expect_message (G_LOG_DOMAIN, G_LOG_LEVEL_CRITICAL,
+                           "*main_thread*");
+    g_assert_cmpuint (gdv_ingest_push (ingest, &value, &value, NULL, 1, 1),
+                      ==, 0);
+    g_test_assert_expected_messages ();
+  }
+
+  /* a producer, that waits on a full queue, is released by detaching */
+  producer = g_thread_new ("ingest-producer", ingest_producer, ingest);
+
+  while (gdv_ingest_get_n_pushed (ingest) < INGEST_TEST_N_POINTS + 256)
+    g_thread_yield ();
+
+  gdv_ingest_detach (ingest);
+  g_assert_cmpuint (GPOINTER_TO_SIZE (g_thread_join (producer)), <,
+                    INGEST_TEST_N_POINTS);
+
+  /* the content outlives the ingest */
+  g_object_unref (ingest);
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+static void
+test_twodlayer_many_contents (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GtkAllocation first_allocation, last_allocation, layer_allocation;
+  GdvLayerContent *content = NULL, **contents;
+  guint n_contents;
+  gint min_width_single, nat_width_single, min_width, nat_width;
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 800, 800);
+
+  content = g_object_new (GDV_LAYER_TYPE_CONTENT, NULL);
+  gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+  gtk_widget_show_all (data->window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  gtk_widget_get_preferred_width (GTK_WIDGET (data->layer),
+                                  &min_width_single, &nat_width_single);
+
+  for (i = 1; i < 1000; i++)
+  {
+    content = g_object_new (GDV_LAYER_TYPE_CONTENT, NULL);
+    gtk_widget_show (GTK_WIDGET (content));
+    gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+  }
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  /* the contents do not take part in the measurement */
+  gtk_widget_get_preferred_width (GTK_WIDGET (data->layer),
+                                  &min_width, &nat_width);
+  g_assert_cmpint (min_width, ==, min_width_single);
+  g_assert_cmpint (nat_width, ==, nat_width_single);
+
+  /* and all of them share the same plot-area */
+  contents = gdv_layer_peek_contents (GDV_LAYER (data->layer), &n_contents);
+  g_assert_cmpuint (n_contents, ==, 1000);
+  gtk_widget_get_allocation (GTK_WIDGET (contents[0]), &first_allocation);
+  gtk_widget_get_allocation (GTK_WIDGET (content), &last_allocation);
+  g_assert_cmpint (first_allocation.x, ==, last_allocation.x);
+  g_assert_cmpint (first_allocation.y, ==, last_allocation.y);
+  g_assert_cmpint (first_allocation.width, ==, last_allocation.width);
+  g_assert_cmpint (first_allocation.height, ==, last_allocation.height);
+
+  if (g_test_perf ())
+  {
+    gdouble elapsed;
+
+    gtk_widget_get_allocation (GTK_WIDGET (data->layer), &layer_allocation);
+    g_test_timer_start ();
+
+    for (i = 0; i < 1000; i++)
+      GTK_WIDGET_GET_CLASS (data->layer)->size_allocate (
+        GTK_WIDGET (data->layer), &layer_allocation);
+
+    elapsed = g_test_timer_elapsed ();
+    g_test_minimized_result (elapsed,
+                             "1000 allocations with 1000 contents in %f s",
+                             elapsed);
+  }
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+static void
+test_twodlayer_startup (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *contents[1000];
+  GdvSpecialTimeAxis *time_axes[100];
+  GtkWidget *box;
+  gdouble construction_time, lookup_time;
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  gtk_container_add (GTK_CONTAINER (data->window), box);
+
+  /* all instances share the parsed theme */
+  g_test_timer_start ();
+
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_box_pack_start (GTK_BOX (box), GTK_WIDGET (data->layer), TRUE, TRUE, 0);
+
+  for (i = 0; i < G_N_ELEMENTS (contents); i++)
+  {
+    contents[i] = g_object_new (GDV_LAYER_TYPE_CONTENT, NULL);
+    gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (contents[i]));
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (time_axes); i++)
+  {
+    time_axes[i] = gdv_special_time_axis_new ();
+    gtk_box_pack_start (GTK_BOX (box), GTK_WIDGET (time_axes[i]),
+                        FALSE, FALSE, 0);
+  }
+
+  construction_time = g_test_timer_elapsed ();
+
+  gtk_widget_show_all (data->window);
+
+  g_test_timer_start ();
+
+  for (i = 0; i < G_N_ELEMENTS (contents); i++)
+  {
+    gdouble point_width;
+
+    gtk_widget_style_get (GTK_WIDGET (contents[i]),
+                          "point-width", &point_width, NULL);
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (time_axes); i++)
+  {
+    gdouble line_width;
+
+    gtk_widget_style_get (GTK_WIDGET (time_axes[i]),
+                          "line-width", &line_width, NULL);
+  }
+
+  lookup_time = g_test_timer_elapsed ();
+
+  g_test_minimized_result (construction_time,
+                           "constructing 1000 contents and 100 time-axes "
+                           "in %f s", construction_time);
+  g_test_minimized_result (lookup_time,
+                           "looking up their style in %f s", lookup_time);
+
+  tgdv_layer_test_integrity (GDV_LAYER (data->layer));
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+static void
+test_twodlayer_strip_chart (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GtkWidget *full_window;
+  GdvTwodLayer *full_layer;
+  GdvLayerContent *content, *full_content;
+  cairo_surface_t *surface_scrolled, *surface_full;
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  content = fixed_layer_content_new (&data->window, &data->layer, NULL);
+
+  g_assert_false (gdv_twod_layer_get_strip_chart (data->layer));
+  gdv_twod_layer_set_strip_chart (data->layer, TRUE);
+  g_assert_true (gdv_twod_layer_get_strip_chart (data->layer));
+
+  for (i = 0; i < 100000; i++)
+    gdv_layer_content_add_data_point (content, 0.001 * i, sin (0.001 * i), 0.0);
+
+  gdv_twod_layer_set_yrange (data->layer, -1.5, 1.5);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  /* the scale scrolls along, while new data-points are appended */
+  g_test_timer_start ();
+
+  for (i = 0; i < 100; i++)
+  {
+    gdv_layer_content_add_data_point (content, 100.0 + 0.5 * i,
+                                      sin (100.0 + 0.5 * i), 0.0);
+    gdv_twod_layer_set_xrange (data->layer, 0.5 * i, 100.0 + 0.5 * i);
+
+    while (gtk_events_pending ())
+      gtk_main_iteration ();
+  }
+
+  if (g_test_perf ())
+  {
+    gdouble elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed, "100 scrolled frames in %f s", elapsed);
+  }
+
+  /* the scrolled cache has to look like a fresh render of the same range;
+   * the scrolled columns may be shifted by a fraction of a pixel */
+  full_content = fixed_layer_content_new (&full_window, &full_layer, NULL);
+
+  for (i = 0; i < 100000; i++)
+    gdv_layer_content_add_data_point (full_content, 0.001 * i,
+                                      sin (0.001 * i), 0.0);
+  for (i = 0; i < 100; i++)
+    gdv_layer_content_add_data_point (full_content, 100.0 + 0.5 * i,
+                                      sin (100.0 + 0.5 * i), 0.0);
+
+  gdv_twod_layer_set_xrange (full_layer, 49.5, 149.5);
+  gdv_twod_layer_set_yrange (full_layer, -1.5, 1.5);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  surface_scrolled = content_snapshot (content);
+  surface_full = content_snapshot (full_content);
+
+  g_assert_cmpuint (count_different_pixels (surface_scrolled, surface_full,
+                                            0x30, 1), <=, 16);
+  g_assert_cmpuint (count_different_pixels (surface_full, surface_scrolled,
+                                            0x30, 1), <=, 16);
+
+  cairo_surface_destroy (surface_scrolled);
+  cairo_surface_destroy (surface_full);
+  gtk_widget_destroy (full_window);
+
+  gdv_twod_layer_set_strip_chart (data->layer, FALSE);
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+static void
+test_twodlayer_threaded (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *content;
+  gboolean threaded;
+  gint64 deadline;
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 800, 800);
+
+  content = g_object_new (GDV_LAYER_TYPE_CONTENT,
+                          "threaded-rendering", TRUE,
+                          NULL);
+  g_object_get (content, "threaded-rendering", &threaded, NULL);
+  g_assert_true (threaded);
+  gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+
+  for (i = 0; i < 500000; i++)
+    gdv_layer_content_add_data_point (content, 0.0002 * i,
+                                      50.0 + 40.0 * sin (0.0001 * i), 0.0);
+
+  gdv_twod_layer_set_xrange (data->layer, 0.0, 100.0);
+  gdv_twod_layer_set_yrange (data->layer, 0.0, 100.0);
+  gtk_widget_show_all (data->window);
+
+  g_test_timer_start ();
+
+  /* the image appears, once the worker-threads are done */
+  deadline = g_get_monotonic_time () + 10 * G_TIME_SPAN_SECOND;
+  while (!content_has_pixels (content) && g_get_monotonic_time () < deadline)
+    gtk_main_iteration_do (FALSE);
+
+  g_assert_true (content_has_pixels (content));
+
+  if (g_test_perf ())
+  {
+    gdouble elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed, "500000 points rendered in %f s",
+                             elapsed);
+  }
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+static void
+test_twodlayer_density (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *content;
+  guint render_mode;
+  GRand *rand;
+  guint i;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 800, 800);
+
+  content = g_object_new (GDV_LAYER_TYPE_CONTENT,
+                          "render-mode", GDV_RENDER_MODE_DENSITY,
+                          "density-block-size", 2,
+                          NULL);
+  g_object_get (content, "render-mode", &render_mode, NULL);
+  g_assert_cmpuint (render_mode, ==, GDV_RENDER_MODE_DENSITY);
+  gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+
+  rand = g_rand_new_with_seed (23);
+
+  for (i = 0; i < 200000; i++)
+    gdv_layer_content_add_data_point (content,
+                                      50.0 + 10.0 * g_rand_double (rand) *
+                                        cos (0.01 * i),
+                                      50.0 + 10.0 * g_rand_double (rand) *
+                                        sin (0.01 * i),
+                                      0.0);
+
+  gdv_twod_layer_set_xrange (data->layer, 0.0, 100.0);
+  gdv_twod_layer_set_yrange (data->layer, 0.0, 100.0);
+  gtk_widget_show_all (data->window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  g_test_timer_start ();
+  g_assert_true (content_has_pixels (content));
+
+  if (g_test_perf ())
+  {
+    gdouble elapsed = g_test_timer_elapsed ();
+
+    g_test_minimized_result (elapsed, "200000 points counted in %f s",
+                             elapsed);
+  }
+
+  /* appended points are added to the counts */
+  for (i = 0; i < 1000; i++)
+    gdv_layer_content_add_data_point (content, 90.0, 90.0, 0.0);
+  g_assert_true (content_has_pixels (content));
+
+  g_rand_free (rand);
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+/* the premultiplied pixel of an image surface */
+static guint32
+surface_pixel (cairo_surface_t *surface,
+               gint             x,
+               gint             y)
+{
+  cairo_surface_flush (surface);
+
+  return *(const guint32 *) (cairo_image_surface_get_data (surface) +
+                             y * cairo_image_surface_get_stride (surface) +
+                             4 * x);
+}
+
+static void
+test_twodlayer_markers (void)
+{
+  GdvLayerContent *content;
+  GtkCssProvider *css_provider;
+  GtkStyleContext *style_context;
+  GdvPointType point_type;
+
+  gtk_init (NULL, 0);
+
+  content = g_object_ref_sink (gdv_layer_content_new ());
+
+  css_provider = gtk_css_provider_new ();
+  gtk_css_provider_load_from_data (css_provider,
+  "*{"
+  "  -GdvLayerContent-point-color: #ff00ff;"
+  "  -GdvLayerContent-point-width: 4.0;"
+  "                                 }\0", -1, NULL);
+
+  style_context = gtk_widget_get_style_context (GTK_WIDGET (content));
+  gtk_style_context_add_provider (style_context,
+                                  GTK_STYLE_PROVIDER (css_provider),
+                                  GTK_STYLE_PROVIDER_PRIORITY_USER);
+
+  for (point_type = GDV_POINT_TYPE_CIRCLE;
+       point_type <= GDV_POINT_TYPE_STAR;
+       point_type++)
+  {
+    cairo_surface_t *surface;
+    cairo_t *cr;
+
+    /* blended into the pixels directly */
+    surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 32, 32);
+    cr = cairo_create (surface);
+    gdv_render_data_marker (style_context, cr, 15.5, 15.5, point_type);
+    cairo_destroy (cr);
+
+    g_assert_cmphex (surface_pixel (surface, 16, 16), ==, 0xffff00ff);
+    g_assert_cmphex (surface_pixel (surface, 0, 0), ==, 0);
+    g_assert_cmphex (surface_pixel (surface, 31, 31), ==, 0);
+
+    /* painted by cairo, since the target is scaled */
+    cr = cairo_create (surface);
+    cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint (cr);
+    cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+    cairo_scale (cr, 2.0, 2.0);
+    gdv_render_data_marker (style_context, cr, 7.5, 7.5, point_type);
+    cairo_destroy (cr);
+
+    g_assert_cmphex (surface_pixel (surface, 16, 16) >> 24, !=, 0);
+    g_assert_cmphex (surface_pixel (surface, 0, 0), ==, 0);
+
+    /* blended into a group, that starts within the target */
+    cr = cairo_create (surface);
+    cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint (cr);
+    cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+    cairo_rectangle (cr, 8.0, 8.0, 16.0, 16.0);
+    cairo_clip (cr);
+    cairo_push_group (cr);
+    gdv_render_data_marker (style_context, cr, 15.5, 15.5, point_type);
+    cairo_pop_group_to_source (cr);
+    cairo_paint_with_alpha (cr, 0.5);
+    cairo_destroy (cr);
+
+    g_assert_cmphex (surface_pixel (surface, 16, 16) >> 24, >=, 0x7f);
+    g_assert_cmphex (surface_pixel (surface, 16, 16) >> 24, <=, 0x80);
+    g_assert_cmphex (surface_pixel (surface, 0, 0), ==, 0);
+
+    cairo_surface_destroy (surface);
+  }
+
+  g_object_unref (css_provider);
+  g_object_unref (content);
+}
+
+static void
+test_twodlayer_clipping (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *content;
+  gint width;
+
+  gtk_init (NULL, 0);
+
+  data->window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+  data->layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+  gtk_container_add (GTK_CONTAINER (data->window), GTK_WIDGET (data->layer));
+  gtk_widget_set_size_request (GTK_WIDGET (data->window), 400, 400);
+
+  content = gdv_layer_content_new ();
+  gtk_container_add (GTK_CONTAINER (data->layer), GTK_WIDGET (content));
+
+  /* only the first data-point is within the range of the axes */
+  gdv_layer_content_add_data_point (content, 50.0, 50.0, 0.0);
+  gdv_layer_content_add_data_point (content, 1e12, 50.0, 0.0);
+
+  gdv_twod_layer_set_xrange (data->layer, 0.0, 100.0);
+  gdv_twod_layer_set_yrange (data->layer, 0.0, 100.0);
+  gtk_widget_show_all (data->window);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  /* the line leaves the plot at the right edge */
+  width = gtk_widget_get_allocated_width (GTK_WIDGET (content));
+  g_assert_cmpint (width, >, 4);
+  g_assert_true (content_has_pixels_in (content, width - 4, width));
+  g_assert_false (content_has_pixels_in (content, 0, width / 2 - 4));
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+static void
+test_twodlayer_hidden_axis (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GdvLayerContent *content;
+  gint i;
+
+  gtk_init (NULL, 0);
+
+  content = fixed_layer_content_new (&data->window, &data->layer, NULL);
+
+  /* a vertical series; some of its points are out of range in y */
+  for (i = 0; i <= 20; i++)
+    gdv_layer_content_add_data_point (content, 50.0, -50.0 + 10.0 * i, 0.0);
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  g_assert_true (content_has_pixels (content));
+
+  /* without the x1-axis, the points have no horizontal position; they must
+   * not pile up at the left edge */
+  gtk_widget_hide (
+    GTK_WIDGET (gdv_twod_layer_get_axis (data->layer, GDV_X1_AXIS)));
+
+  while (gtk_events_pending ())
+    gtk_main_iteration ();
+
+  g_assert_false (content_has_pixels (content));
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
+/* the changes, that test_twodlayer_space_memo applies one after another; the
+ * title is kept in title_label */
+static void
+space_memo_change (GdvTwodLayer  *layer,
+                   guint          change,
+                   GtkWidget    **title_label)
+{
+  GdvAxis *x1_axis = gdv_twod_layer_get_axis (layer, GDV_X1_AXIS);
+  GdvAxis *y1_axis = gdv_twod_layer_get_axis (layer, GDV_Y1_AXIS);
+  GtkCssProvider *css_provider;
+
+  switch (change)
+  {
+  case 0:
+    /* larger tic-labels; they inherit the font of the axis */
+    css_provider = gtk_css_provider_new ();
+    gtk_css_provider_load_from_data (css_provider,
+                                     "* { font-size: 30px; }", -1, NULL);
+    gtk_style_context_add_provider (
+      gtk_widget_get_style_context (GTK_WIDGET (x1_axis)),
+      GTK_STYLE_PROVIDER (css_provider), GTK_STYLE_PROVIDER_PRIORITY_USER);
+    g_object_unref (css_provider);
+    break;
+
+  case 1:
+    /* a new title */
+    *title_label = gtk_label_new (NULL);
+    gtk_label_set_markup (GTK_LABEL (*title_label), "Y<sub>1</sub>");
+    gtk_label_set_angle (GTK_LABEL (*title_label), 90.0);
+    gtk_widget_show (*title_label);
+    gdv_axis_set_title_widget (y1_axis, *title_label);
+    break;
+
+  case 2:
+    /* the same title, that needs more space */
+    gtk_label_set_markup (GTK_LABEL (*title_label),
+                          "<big><big>Y<sub>1</sub>-Axis</big></big>");
+    break;
+
+  case 3:
+    /* the tics point into the plot */
+    g_object_set (x1_axis, "axis-direction-outside", 0.0, NULL);
+    break;
+  }
+}
+
+/* gives the allocations of the four axes and of the content */
+static void
+space_memo_allocations (GdvTwodLayer    *layer,
+                        GdvLayerContent *content,
+                        GtkAllocation    allocations[5])
+{
+  static const GdvTwodAxisType types[4] =
+    {GDV_X1_AXIS, GDV_X2_AXIS, GDV_Y1_AXIS, GDV_Y2_AXIS};
+  guint i;
+
+  for (i = 0; i < 4; i++)
+    gtk_widget_get_allocation (
+      GTK_WIDGET (gdv_twod_layer_get_axis (layer, types[i])),
+      &allocations[i]);
+
+  gtk_widget_get_allocation (GTK_WIDGET (content), &allocations[4]);
+}
+
+static void
+test_twodlayer_space_memo (void)
+{
+  struct _tgdv_twodlayer_data data_str;
+  struct _tgdv_twodlayer_data * data = &data_str;
+  GtkWidget *title_label = NULL;
+  GdvLayerContent *content;
+  GtkAllocation previous[5];
+  guint change, i;
+
+  gtk_init (NULL, 0);
+
+  content = fixed_layer_content_new (&data->window, &data->layer, NULL);
+  space_memo_allocations (data->layer, content, previous);
+
+  /* after every change, the kept spaces and crossing-points have to lead to
+   * the same layout as a layer, that never saw the state before */
+  for (change = 0; change < 4; change++)
+  {
+    GtkAllocation allocations[5], fresh_allocations[5];
+    GtkWidget *fresh_window, *fresh_title_label = NULL;
+    GdvTwodLayer *fresh_layer;
+    GdvLayerContent *fresh_content;
+
+    space_memo_change (data->layer, change, &title_label);
+
+    while (gtk_events_pending ())
+      gtk_main_iteration ();
+
+    space_memo_allocations (data->layer, content, allocations);
+
+    fresh_window = gtk_window_new (GTK_WINDOW_TOPLEVEL);
+    fresh_layer = g_object_new (GDV_TWOD_LAYER_TYPE, NULL);
+    gtk_container_add (GTK_CONTAINER (fresh_window),
+                       GTK_WIDGET (fresh_layer));
+    gtk_widget_set_size_request (GTK_WIDGET (fresh_window), 400, 400);
+    fresh_content = gdv_layer_content_new ();
+    gtk_container_add (GTK_CONTAINER (fresh_layer),
+                       GTK_WIDGET (fresh_content));
+
+    for (i = 0; i <= change; i++)
+      space_memo_change (fresh_layer, i, &fresh_title_label);
+
+    layer_fix_limits (GDV_LAYER (fresh_layer));
+    gdv_twod_layer_set_xrange (fresh_layer, 0.0, 100.0);
+    gdv_twod_layer_set_yrange (fresh_layer, 0.0, 100.0);
+    gtk_widget_show_all (fresh_window);
+
+    while (gtk_events_pending ())
+      gtk_main_iteration ();
+
+    space_memo_allocations (fresh_layer, fresh_content, fresh_allocations);
+
+    for (i = 0; i < 5; i++)
+    {
+      g_assert_cmpint (allocations[i].x, ==, fresh_allocations[i].x);
+      g_assert_cmpint (allocations[i].y, ==, fresh_allocations[i].y);
+      g_assert_cmpint (allocations[i].width, ==, fresh_allocations[i].width);
+      g_assert_cmpint (allocations[i].height, ==,
+                       fresh_allocations[i].height);
+    }
+
+    /* the larger labels below the plot and the titles to the left of it
+     * take space from the content */
+    if (change == 0)
+      g_assert_cmpint (allocations[4].height, <, previous[4].height);
+    else if (change == 1 || change == 2)
+      g_assert_cmpint (allocations[4].x, >, previous[4].x);
+
+    memcpy (previous, allocations, sizeof (previous));
+    gtk_widget_destroy (fresh_window);
+  }
+
+  g_timeout_add (cb_time, ((GSourceFunc) teardown_cb), data->window);
+  gtk_main ();
+
+  data = NULL;
+}
+
 int main(int argc, char* argv[]) {
 
   g_test_init (&argc, &argv, NULL);
 
   g_test_add_func ("/Gdv/TwodLayer/prenormal", test_twodlayer_pre_normal);
   g_test_add_func ("/Gdv/TwodLayer/loglegend", test_twodlayer_log_legend);
+  g_test_add_func ("/Gdv/TwodLayer/grid", test_twodlayer_grid);
+  g_test_add_func ("/Gdv/TwodLayer/log_grid", test_twodlayer_log_grid);
+  g_test_add_func ("/Gdv/TwodLayer/many_contents", test_twodlayer_many_contents);
+  g_test_add_func ("/Gdv/TwodLayer/startup", test_twodlayer_startup);
+  g_test_add_func ("/Gdv/TwodLayer/append", test_twodlayer_append);
+  g_test_add_func ("/Gdv/TwodLayer/render_polyline",
+                   test_twodlayer_render_polyline);
+  g_test_add_func ("/Gdv/TwodLayer/render_curve",
+                   test_twodlayer_render_curve);
+  g_test_add_func ("/Gdv/TwodLayer/evaluate_points",
+                   test_twodlayer_evaluate_points);
+  g_test_add_func ("/Gdv/TwodLayer/visible_range",
+                   test_twodlayer_visible_range);
+  g_test_add_func ("/Gdv/TwodLayer/level_of_detail",
+                   test_twodlayer_level_of_detail);
+  g_test_add_func ("/Gdv/TwodLayer/strip_chart", test_twodlayer_strip_chart);
+  g_test_add_func ("/Gdv/TwodLayer/threaded", test_twodlayer_threaded);
+  g_test_add_func ("/Gdv/TwodLayer/threaded_unordered",
+                   test_twodlayer_threaded_unordered);
+  g_test_add_func ("/Gdv/TwodLayer/ingest_block",
+                   test_twodlayer_ingest_block);
 
+  g_test_add_func ("/Gdv/TwodLayer/density", test_twodlayer_density);
+  g_test_add_func ("/Gdv/TwodLayer/markers", test_twodlayer_markers);
+  g_test_add_func ("/Gdv/TwodLayer/clipping", test_twodlayer_clipping);
+  g_test_add_func ("/Gdv/TwodLayer/hidden_axis",
+                   test_twodlayer_hidden_axis);
+  g_test_add_func ("/Gdv/TwodLayer/space_memo", test_twodlayer_space_memo);
   return g_test_run ();
 }
 